@@ -12,6 +12,9 @@
  * For small matrices, the naive implementation is slightly faster than Eigen.
  * For matrices larger than 100×100, Eigen is significantly faster because it 
  * uses a blocked algorithm that makes more efficient use of the CPU's cache.
+ * (These results predate the blocked version of @ref HouseholderQR, which
+ * applies the reflectors of each panel of columns as matrix-matrix products,
+ * and performs on par with Eigen for large matrices.)
  * 
  * The Frobenius norm of the error ‖A - QR‖ is around twice as big for the naive
  * implementation than for Eigen's implementation.  
@@ -0,0 +1,146 @@
+#pragma once
+
+#include "Matrix.hpp"
+
+/**
+ * @brief   Cholesky factorization of symmetric positive definite matrices.
+ *
+ * Factorizes a symmetric positive definite n×n matrix A as A = LLᵀ, where L
+ * is a lower-triangular matrix with positive diagonal elements.
+ *
+ * This requires half the number of operations of an LU factorization, and
+ * doesn't need pivoting. Only the lower-triangular part of A (including the
+ * diagonal) is read, the upper-triangular part is ignored.
+ *
+ * Large matrices are factored in panels of columns (see
+ * @ref set_cholesky_block_size): after factoring a panel, the rest of the
+ * matrix is updated using matrix-matrix products.
+ *
+ * The factorization can be updated efficiently after adding or subtracting a
+ * symmetric rank-one matrix xxᵀ, see @ref rank_one_update and
+ * @ref rank_one_downdate.
+ *
+ * If the matrix is not positive definite (to working precision), the
+ * factorization fails, and @ref is_factored returns false.
+ *
+ * @ingroup Factorizations
+ */
+class Cholesky {
+  public:
+    /// @name Constructors
+    /// @{
+
+    /// Default constructor.
+    Cholesky() = default;
+    /// Factorize the given matrix.
+    Cholesky(const SquareMatrix &matrix) { compute(matrix); }
+    /// Factorize the given matrix.
+    Cholesky(SquareMatrix &&matrix) { compute(std::move(matrix)); }
+
+    /// @}
+
+  public:
+    /// @name Factorization
+    /// @{
+
+    /// Perform the Cholesky factorization of the given matrix.
+    void compute(SquareMatrix &&matrix);
+    /// Perform the Cholesky factorization of the given matrix.
+    void compute(const SquareMatrix &matrix);
+
+    /// @}
+
+  public:
+    /// @name   Updating the factorization
+    /// @{
+
+    /// Update the factorization of A to a factorization of A + xxᵀ.
+    void rank_one_update(const Vector &x);
+    /// Update the factorization of A to a factorization of A - xxᵀ.
+    /// @return False if A - xxᵀ is not positive definite, in which case the
+    ///         factorization is no longer valid.
+    bool rank_one_downdate(const Vector &x);
+
+    /// @}
+
+  public:
+    /// @name   Retrieving the L factor
+    /// @{
+
+    /// Get the lower-triangular matrix L, reusing the internal storage.
+    /// @warning    After calling this function, the Cholesky object is no
+    ///             longer valid, because this function steals its storage.
+    SquareMatrix &&steal_L();
+
+    /// Copy the lower-triangular matrix L to the given matrix.
+    void get_L_inplace(Matrix &L) const;
+    /// Get a copy of the lower-triangular matrix L.
+    SquareMatrix get_L() const &;
+    /// Get the lower-triangular matrix L.
+    SquareMatrix &&get_L() && { return steal_L(); }
+
+    /// @}
+
+  public:
+    /// @name   Solving systems of equations problems
+    /// @{
+
+    /// Solve the system AX = B or LLᵀX = B.
+    /// Matrix B is overwritten with the result X.
+    void solve_inplace(Matrix &B) const;
+    /// Solve the system AX = B or LLᵀX = B.
+    Matrix solve(const Matrix &B) const;
+    /// Solve the system AX = B or LLᵀX = B.
+    Matrix &&solve(Matrix &&B) const;
+    /// Solve the system Ax = b or LLᵀx = b.
+    Vector solve(const Vector &B) const;
+    /// Solve the system Ax = b or LLᵀx = b.
+    Vector &&solve(Vector &&B) const;
+
+    /// @}
+
+  public:
+    /// @name   Access to internal representation
+    /// @{
+
+    /// Check if this object contains a valid factorization.
+    bool is_factored() const { return state == Factored; }
+
+    /// Get the internal storage of the lower-triangular matrix L. The
+    /// elements above the diagonal are unspecified.
+    const SquareMatrix &get_LLT() const & { return LLT; }
+    /// @copydoc    get_LLT
+    SquareMatrix &&get_LLT() && { return std::move(LLT); }
+
+    /// @}
+
+  private:
+    /// The actual Cholesky factorization algorithm.
+    void compute_factorization();
+    /// Unblocked factorization of the b columns starting at column k.
+    /// @return False if the matrix is not positive definite.
+    bool compute_panel_factorization(size_t k, size_t b);
+    /// Subtract the contributions of a factored panel from the lower-triangular
+    /// part of the columns to its right.
+    void update_trailing_matrix(size_t k, size_t b, size_t nb);
+    /// Forward substitution algorithm for solving lower-triangular systems
+    /// LX = B.
+    void forward_subs(Matrix &B) const;
+    /// Back substitution algorithm for solving upper-triangular systems
+    /// LᵀX = B.
+    void back_subs(Matrix &B) const;
+
+  private:
+    /// Result of a Cholesky factorization: stores the lower-triangular matrix
+    /// L. The elements above the diagonal are not used.
+    SquareMatrix LLT;
+
+    enum State {
+        NotFactored = 0,
+        Factored    = 1,
+    } state = NotFactored;
+};
+
+/// Print the L matrix of a Cholesky object.
+/// @related    Cholesky
+std::ostream &operator<<(std::ostream &os, const Cholesky &chol);
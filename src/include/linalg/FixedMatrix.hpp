@@ -0,0 +1,354 @@
+#pragma once
+
+#include "Matrix.hpp"
+#include "util/Unroll.hpp"
+
+#include <algorithm>        // std::copy, std::equal, std::fill
+#include <cassert>          // assert
+#include <cmath>            // std::sqrt
+#include <initializer_list> // std::initializer_list
+#include <iosfwd>           // std::ostream
+
+/// @addtogroup MatVec
+/// @{
+
+/**
+ * @brief   Matrix with dimensions that are known at compile time.
+ *
+ * The elements are stored inside of the object itself, so creating a
+ * FixedMatrix never allocates memory, and all arithmetic operations are fully
+ * unrolled by the compiler. This makes them much faster than @ref Matrix for
+ * small sizes, such as the 3×3 and 4×4 matrices used in control loops and
+ * geometry.
+ * Because the code size grows with the number of elements, they should only
+ * be used for small matrices.
+ *
+ * The elements are stored in column major order. Conversions from and to
+ * @ref Matrix are explicit, and work for dynamically sized matrices with any
+ * storage order.
+ */
+template <size_t R, size_t C>
+class FixedMatrix {
+    static_assert(R > 0 && C > 0, "FixedMatrix cannot be empty");
+
+  public:
+    /// @name   Constructors and assignment
+    /// @{
+
+    /// Create a matrix of zeros.
+    FixedMatrix() = default;
+
+    /// Create a matrix with the given values.
+    FixedMatrix(std::initializer_list<std::initializer_list<double>> init) {
+        *this = init;
+    }
+    /// Assign the given values to the matrix.
+    FixedMatrix &
+    operator=(std::initializer_list<std::initializer_list<double>> init) {
+        assert(init.size() == R);
+        size_t r = 0;
+        for (const auto &row : init) {
+            assert(row.size() == C);
+            size_t c = 0;
+            for (double el : row)
+                (*this)(r, c++) = el;
+            ++r;
+        }
+        return *this;
+    }
+
+    /// Convert a dynamically sized matrix with the same dimensions.
+    explicit FixedMatrix(const Matrix &matrix) {
+        assert(matrix.rows() == R);
+        assert(matrix.cols() == C);
+        for (size_t c = 0; c < C; ++c)
+            for (size_t r = 0; r < R; ++r)
+                (*this)(r, c) = matrix(r, c);
+    }
+
+    /// Convert to a dynamically sized matrix.
+    explicit operator Matrix() const {
+        Matrix result(R, C, StorageOrder::ColMajor);
+        std::copy(begin(), end(), result.begin());
+        return result;
+    }
+
+    /// @}
+
+  public:
+    /// @name   Matrix size
+    /// @{
+
+    /// Get the number of rows of the matrix.
+    static constexpr size_t rows() { return R; }
+    /// Get the number of columns of the matrix.
+    static constexpr size_t cols() { return C; }
+    /// Get the number of elements in the matrix.
+    static constexpr size_t num_elems() { return R * C; }
+
+    /// @}
+
+  public:
+    /// @name   Element access
+    /// @{
+
+    /// Get the element at the given position in the matrix.
+    double &operator()(size_t row, size_t col) {
+        return storage[index(row, col)];
+    }
+    /// Get the element at the given position in the matrix.
+    const double &operator()(size_t row, size_t col) const {
+        return storage[index(row, col)];
+    }
+
+    /// Get the element at the given position in the linearized matrix.
+    double &operator()(size_t index) { return storage[index]; }
+    /// Get the element at the given position in the linearized matrix.
+    const double &operator()(size_t index) const { return storage[index]; }
+
+    /// Get a pointer to the storage of the matrix.
+    double *data() { return storage; }
+    /// Get a pointer to the storage of the matrix.
+    const double *data() const { return storage; }
+
+    /// @}
+
+  public:
+    /// @name   Filling matrices
+    /// @{
+
+    /// Fill the matrix with a constant value.
+    void fill(double value) {
+        util::unroll<R * C>([&](size_t i) { storage[i] = value; });
+    }
+
+    /// Fill the matrix as an identity matrix (all zeros except the diagonal
+    /// which is one).
+    void fill_identity() {
+        fill(0);
+        util::unroll<(R < C ? R : C)>([&](size_t i) { (*this)(i, i) = 1; });
+    }
+
+    /// @}
+
+  public:
+    /// @name   Create special matrices
+    /// @{
+
+    /// Create a matrix filled with zeros.
+    static FixedMatrix zeros() { return FixedMatrix(); }
+    /// Create a matrix filled with ones.
+    static FixedMatrix ones() { return constant(1); }
+    /// Create a matrix filled with a constant value.
+    static FixedMatrix constant(double value) {
+        FixedMatrix m;
+        m.fill(value);
+        return m;
+    }
+    /// Create an identity matrix.
+    static FixedMatrix identity() {
+        FixedMatrix m;
+        m.fill_identity();
+        return m;
+    }
+
+    /// @}
+
+  public:
+    /// @name   Comparison
+    /// @{
+
+    /// Check for equality of two matrices.
+    /// @warning    Uses exact comparison, which is often not appropriate for
+    ///             floating point numbers.
+    bool operator==(const FixedMatrix &other) const {
+        return std::equal(begin(), end(), other.begin());
+    }
+    /// Check for inequality of two matrices.
+    /// @warning    Uses exact comparison, which is often not appropriate for
+    ///             floating point numbers.
+    bool operator!=(const FixedMatrix &other) const {
+        return !(*this == other);
+    }
+
+    /// @}
+
+  public:
+    /// @name   Vector operations
+    /// @{
+
+    /// Compute the dot product of two vectors (or the Frobenius inner product
+    /// of two matrices).
+    double dot(const FixedMatrix &b) const {
+        double result = 0;
+        util::unroll<R * C>([&](size_t i) { result += storage[i] * b(i); });
+        return result;
+    }
+
+    /// Compute the cross product of two 3-vectors.
+    FixedMatrix cross(const FixedMatrix &b) const {
+        static_assert(R * C == 3, "Cross product requires 3-vectors");
+        const FixedMatrix &a = *this;
+        FixedMatrix result;
+        result(0) = a(1) * b(2) - a(2) * b(1);
+        result(1) = a(2) * b(0) - a(0) * b(2);
+        result(2) = a(0) * b(1) - a(1) * b(0);
+        return result;
+    }
+
+    /// Compute the 2-norm of a vector.
+    double norm2() const {
+        static_assert(R == 1 || C == 1, "norm2 requires a vector");
+        return normFro();
+    }
+
+    /// Compute the Frobenius norm of the matrix.
+    double normFro() const { return std::sqrt(dot(*this)); }
+
+    /// @}
+
+  public:
+    /// @name   Iterators
+    /// @{
+
+    /// Get a pointer to the first element of the matrix.
+    double *begin() { return storage; }
+    /// Get a pointer to the first element of the matrix.
+    const double *begin() const { return storage; }
+    /// Get a pointer to the element past the end of the matrix.
+    double *end() { return storage + R * C; }
+    /// Get a pointer to the element past the end of the matrix.
+    const double *end() const { return storage + R * C; }
+
+    /// @}
+
+  private:
+    /// Index in the storage of the element at the given position.
+    static constexpr size_t index(size_t row, size_t col) {
+        return row + R * col;
+    }
+
+    double storage[R * C] = {};
+};
+
+/// Column vector with a size that is known at compile time.
+template <size_t N>
+using FixedVector = FixedMatrix<N, 1>;
+
+/// Row vector with a size that is known at compile time.
+template <size_t N>
+using FixedRowVector = FixedMatrix<1, N>;
+
+/// Square matrix with a size that is known at compile time.
+template <size_t N>
+using FixedSquareMatrix = FixedMatrix<N, N>;
+
+/// @}
+
+/// Print a fixed-size matrix.
+/// @related    FixedMatrix
+template <size_t R, size_t C>
+std::ostream &operator<<(std::ostream &os, const FixedMatrix<R, C> &M) {
+    return os << static_cast<Matrix>(M);
+}
+
+// :::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::: //
+
+/// @addtogroup MatVecOp
+/// @{
+
+/// Fixed-size matrix multiplication.
+template <size_t R, size_t K, size_t C>
+FixedMatrix<R, C> operator*(const FixedMatrix<R, K> &A,
+                            const FixedMatrix<K, C> &B) {
+    FixedMatrix<R, C> result;
+    util::unroll<C>([&](size_t j) {
+        util::unroll<K>([&](size_t k) {
+            util::unroll<R>(
+                [&](size_t i) { result(i, j) += A(i, k) * B(k, j); });
+        });
+    });
+    return result;
+}
+
+/// Fixed-size row vector times column vector (dot product).
+template <size_t N>
+double operator*(const FixedRowVector<N> &a, const FixedVector<N> &b) {
+    double result = 0;
+    util::unroll<N>([&](size_t i) { result += a(i) * b(i); });
+    return result;
+}
+
+/// Fixed-size matrix addition.
+template <size_t R, size_t C>
+FixedMatrix<R, C> &operator+=(FixedMatrix<R, C> &A,
+                              const FixedMatrix<R, C> &B) {
+    util::unroll<R * C>([&](size_t i) { A(i) += B(i); });
+    return A;
+}
+/// Fixed-size matrix addition.
+template <size_t R, size_t C>
+FixedMatrix<R, C> operator+(FixedMatrix<R, C> A, const FixedMatrix<R, C> &B) {
+    return A += B;
+}
+
+/// Fixed-size matrix subtraction.
+template <size_t R, size_t C>
+FixedMatrix<R, C> &operator-=(FixedMatrix<R, C> &A,
+                              const FixedMatrix<R, C> &B) {
+    util::unroll<R * C>([&](size_t i) { A(i) -= B(i); });
+    return A;
+}
+/// Fixed-size matrix subtraction.
+template <size_t R, size_t C>
+FixedMatrix<R, C> operator-(FixedMatrix<R, C> A, const FixedMatrix<R, C> &B) {
+    return A -= B;
+}
+
+/// Fixed-size matrix negation.
+template <size_t R, size_t C>
+FixedMatrix<R, C> operator-(FixedMatrix<R, C> A) {
+    util::unroll<R * C>([&](size_t i) { A(i) = -A(i); });
+    return A;
+}
+
+/// Fixed-size scalar multiplication.
+template <size_t R, size_t C>
+FixedMatrix<R, C> &operator*=(FixedMatrix<R, C> &A, double s) {
+    util::unroll<R * C>([&](size_t i) { A(i) *= s; });
+    return A;
+}
+/// Fixed-size scalar multiplication.
+template <size_t R, size_t C>
+FixedMatrix<R, C> operator*(FixedMatrix<R, C> A, double s) {
+    return A *= s;
+}
+/// Fixed-size scalar multiplication.
+template <size_t R, size_t C>
+FixedMatrix<R, C> operator*(double s, FixedMatrix<R, C> A) {
+    return A *= s;
+}
+
+/// Fixed-size scalar division.
+template <size_t R, size_t C>
+FixedMatrix<R, C> &operator/=(FixedMatrix<R, C> &A, double s) {
+    util::unroll<R * C>([&](size_t i) { A(i) /= s; });
+    return A;
+}
+/// Fixed-size scalar division.
+template <size_t R, size_t C>
+FixedMatrix<R, C> operator/(FixedMatrix<R, C> A, double s) {
+    return A /= s;
+}
+
+/// Fixed-size matrix transpose.
+template <size_t R, size_t C>
+FixedMatrix<C, R> transpose(const FixedMatrix<R, C> &A) {
+    FixedMatrix<C, R> result;
+    util::unroll<R>([&](size_t i) {
+        util::unroll<C>([&](size_t j) { result(j, i) = A(i, j); });
+    });
+    return result;
+}
+
+/// @}
@@ -11,7 +11,15 @@
  * It can be used for solving square systems of equations or for finding a least
  * squares solution to an overdetermined system of equations.
  * 
- * This version does not use column pivoting, and is not rank-revealing.
+ * This version does not use column pivoting, and is not rank-revealing, see
+ * @ref PivotedHouseholderQR for a rank-revealing version.
+ * 
+ * Large matrices are factored in panels of columns (see
+ * @ref set_qr_block_size): the reflectors of each panel are combined into
+ * their compact WY representation, and are applied to the rest of the matrix
+ * using matrix-matrix products. This doesn't change the output format of
+ * @ref get_RW and @ref get_R_diag. The same blocking is used to apply Q or Qᵀ
+ * to many right-hand sides at once.
  * 
  * @ingroup Factorizations
  */
@@ -63,6 +71,14 @@ class HouseholderQR {
     /// Compute the unitary matrix Q.
     SquareMatrix get_Q() const;
 
+    /// Compute the first n columns of Q (an orthonormal basis for the range
+    /// of A) and copy them to the given m×n matrix.
+    void get_thin_Q_inplace(Matrix &Q) const;
+    /// Compute the first n columns of Q, an m×n matrix with orthonormal
+    /// columns such that A = QR, with R the first n rows of @ref get_R.
+    /// Unlike @ref get_Q, this doesn't require m² storage.
+    Matrix get_thin_Q() const;
+
     /// @}
 
   public:
@@ -125,6 +141,8 @@ class HouseholderQR {
   private:
     /// The actual QR factorization algorithm.
     void compute_factorization();
+    /// Unblocked factorization of the b columns starting at column k.
+    void compute_panel_factorization(size_t k, size_t b);
     /// Back substitution algorithm for solving upper-triangular systems RX = B.
     void back_subs(const Matrix &B, Matrix &X) const;
 
@@ -0,0 +1,187 @@
+#pragma once
+
+#include "Matrix.hpp"
+#include "PermutationMatrix.hpp"
+
+/**
+ * @brief   LDLᵀ factorization of symmetric indefinite matrices, with
+ *          Bunch-Kaufman pivoting.
+ *
+ * Factorizes a symmetric n×n matrix A as PAPᵀ = LDLᵀ, where P is a
+ * permutation matrix, L is a lower-triangular matrix with ones on the
+ * diagonal, and D is a block-diagonal matrix with 1×1 and 2×2 blocks.
+ *
+ * Symmetric indefinite matrices (e.g. the KKT matrices of saddle point
+ * problems) don't have a Cholesky factorization, and the diagonal may even be
+ * zero, so 1×1 pivots alone are not enough for stability. The Bunch-Kaufman
+ * strategy selects a 1×1 or a 2×2 pivot at each step, using only a few
+ * columns of the matrix. Because the symmetry is preserved, this requires half
+ * the number of operations of an LU factorization. Only the lower-triangular
+ * part of A (including the diagonal) is read.
+ *
+ * D is stored compactly as its diagonal and its subdiagonal: the subdiagonal
+ * element is nonzero only in the first column of each 2×2 block.
+ *
+ * Large matrices are factored in panels of columns (see
+ * @ref set_ldlt_block_size): the columns of a panel are updated lazily while
+ * it is factored, and the rest of the matrix is updated afterwards using
+ * matrix-matrix products (like LAPACK's DSYTRF).
+ *
+ * @ingroup Factorizations
+ */
+class LDLT {
+  public:
+    /// @name Constructors
+    /// @{
+
+    /// Default constructor.
+    LDLT() = default;
+    /// Factorize the given matrix.
+    LDLT(const SquareMatrix &matrix) { compute(matrix); }
+    /// Factorize the given matrix.
+    LDLT(SquareMatrix &&matrix) { compute(std::move(matrix)); }
+
+    /// @}
+
+  public:
+    /// @name Factorization
+    /// @{
+
+    /// Perform the LDLᵀ factorization of the given matrix.
+    void compute(SquareMatrix &&matrix);
+    /// Perform the LDLᵀ factorization of the given matrix.
+    void compute(const SquareMatrix &matrix);
+
+    /// @}
+
+  public:
+    /// @name   Retrieving the L factor
+    /// @{
+
+    /// Get the lower-triangular matrix L, reusing the internal storage.
+    /// @warning    After calling this function, the LDLT object is no
+    ///             longer valid, because this function steals its storage.
+    ///             Stealing both L and P is allowed.
+    SquareMatrix &&steal_L();
+
+    /// Copy the lower-triangular matrix L to the given matrix.
+    void get_L_inplace(Matrix &L) const;
+    /// Get a copy of the lower-triangular matrix L.
+    SquareMatrix get_L() const &;
+    /// Get the lower-triangular matrix L.
+    SquareMatrix &&get_L() && { return steal_L(); }
+
+    /// @}
+
+  public:
+    /// @name   Retrieving the D factor
+    /// @{
+
+    /// Copy the block-diagonal matrix D to the given matrix.
+    void get_D_inplace(Matrix &D) const;
+    /// Get a copy of the block-diagonal matrix D.
+    SquareMatrix get_D() const;
+
+    /// @}
+
+  public:
+    /// @name   Retrieving the P factor
+    /// @{
+
+    /// Get the permutation matrix P, reusing the internal storage.
+    /// @warning    After calling this function, the LDLT object is no
+    ///             longer valid, because this function steals its storage.
+    ///             Stealing both L and P is allowed.
+    PermutationMatrix &&steal_P();
+
+    /// Get a copy of the permutation matrix P.
+    PermutationMatrix get_P() const & { return P; }
+    /// Get the permutation matrix P.
+    PermutationMatrix &&get_P() && { return steal_P(); }
+
+    /// @}
+
+  public:
+    /// @name   Solving systems of equations problems
+    /// @{
+
+    /// Solve the system AX = B or PᵀLDLᵀPX = B.
+    /// Matrix B is overwritten with the result X.
+    void solve_inplace(Matrix &B) const;
+    /// Solve the system AX = B or PᵀLDLᵀPX = B.
+    Matrix solve(const Matrix &B) const;
+    /// Solve the system AX = B or PᵀLDLᵀPX = B.
+    Matrix &&solve(Matrix &&B) const;
+    /// Solve the system Ax = b or PᵀLDLᵀPx = b.
+    Vector solve(const Vector &B) const;
+    /// Solve the system Ax = b or PᵀLDLᵀPx = b.
+    Vector &&solve(Vector &&B) const;
+
+    /// @}
+
+  public:
+    /// @name   Access to internal representation
+    /// @{
+
+    /// Check if this object contains a factorization.
+    bool is_factored() const { return state == Factored; }
+
+    /// Check if this object contains valid L and D factors.
+    bool has_LD() const { return valid_LD; }
+
+    /// Check if this object contains a valid permutation matrix P.
+    bool has_P() const { return valid_P; }
+
+    /// Get the internal storage of the strict lower-triangular part of
+    /// matrix L and the diagonal of D. The elements above the diagonal are
+    /// unspecified.
+    const SquareMatrix &get_LD() const & { return LD; }
+    /// Get the subdiagonal of D. Element k is nonzero only if rows and
+    /// columns k and k + 1 form a 2×2 block.
+    const Vector &get_D_subdiag() const & { return D_sub; }
+
+    /// @}
+
+  private:
+    /// The actual LDLᵀ factorization algorithm.
+    void compute_factorization();
+    /// Unblocked factorization of all columns starting at column k.
+    void compute_unblocked_factorization(size_t k);
+    /// Factor the panel of columns starting at column k, computing the
+    /// updated columns in the n×nb workspace W. Returns the number of columns
+    /// that were factored: nb - 1, or nb if the last pivot is a 2×2 block
+    /// (the last column of W is needed as scratch space for the pivot search).
+    size_t compute_panel_factorization(size_t k, size_t nb, Matrix &W);
+    /// Apply the updates of a factored panel to the lower-triangular part of
+    /// the columns to its right.
+    void update_trailing_matrix(size_t k, size_t b, size_t nb,
+                                const Matrix &W);
+    /// Solve the system LX = B, overwriting B with X.
+    void forward_subs(Matrix &B) const;
+    /// Solve the system DX = B, overwriting B with X.
+    void diagonal_solve(Matrix &B) const;
+    /// Solve the system LᵀX = B, overwriting B with X.
+    void back_subs(Matrix &B) const;
+
+  private:
+    /// Result of an LDLᵀ factorization: stores the strict lower-triangular
+    /// part of matrix L and the diagonal of D. The diagonal elements of L are
+    /// implicitly 1.
+    SquareMatrix LD;
+    /// The subdiagonal of the block-diagonal matrix D.
+    Vector D_sub;
+    /// The symmetric permutation that selects the pivots.
+    PermutationMatrix P = PermutationMatrix::RowPermutation;
+
+    enum State {
+        NotFactored = 0,
+        Factored    = 1,
+    } state = NotFactored;
+
+    bool valid_LD = false;
+    bool valid_P  = false;
+};
+
+/// Print the L, D and P matrices of an LDLT object.
+/// @related    LDLT
+std::ostream &operator<<(std::ostream &os, const LDLT &ldlt);
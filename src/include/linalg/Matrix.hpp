@@ -12,15 +12,22 @@
 
 using std::size_t;
 
+#include "MatrixView.hpp"
+#include "util/MatrixExpression.hpp"
 #include "util/MatrixStorage.hpp"
 
-#ifndef COL_MAJ_ORDER
-#define COL_MAJ_ORDER 1
-#endif
-
 /// @addtogroup MatVec
 /// @{
 
+/// Order in which the elements of a @ref Matrix are stored in memory.
+/// Every matrix has its own storage order, and matrices with different storage
+/// orders can be combined freely: the kernels access all operands through
+/// their row and column strides.
+enum class StorageOrder {
+    ColMajor, ///< The elements of each column are stored consecutively.
+    RowMajor, ///< The elements of each row are stored consecutively.
+};
+
 /// General matrix class.
 class Matrix {
 
@@ -29,9 +36,11 @@ class Matrix {
 
   protected:
     /// Convert raw storage to a matrix.
-    explicit Matrix(storage_t &&storage, size_t rows, size_t cols);
+    explicit Matrix(storage_t &&storage, size_t rows, size_t cols,
+                    StorageOrder order = StorageOrder::ColMajor);
     /// Convert raw storage to a matrix.
-    explicit Matrix(const storage_t &storage, size_t rows, size_t cols);
+    explicit Matrix(const storage_t &storage, size_t rows, size_t cols,
+                    StorageOrder order = StorageOrder::ColMajor);
 
   public:
     /// @name   Constructors and assignment
@@ -40,8 +49,9 @@ class Matrix {
     /// Default constructor.
     Matrix() = default;
 
-    /// Create a matrix of zeros with the given dimensions.
-    Matrix(size_t rows, size_t cols);
+    /// Create a matrix of zeros with the given dimensions and storage order.
+    Matrix(size_t rows, size_t cols,
+           StorageOrder order = StorageOrder::ColMajor);
 
     /// Create a matrix with the given values.
     Matrix(std::initializer_list<std::initializer_list<double>> init);
@@ -59,6 +69,29 @@ class Matrix {
     /// Move assignment.
     Matrix &operator=(Matrix &&);
 
+    /// Copy the elements of a view into a new matrix.
+    explicit Matrix(const ConstMatrixView &view) { *this = view; }
+
+    /// Evaluate an element-wise expression (or copy a view) and assign the
+    /// result to this matrix. No memory is allocated if the matrix already
+    /// has the right dimensions.
+    template <class E, class = typename std::enable_if<
+                           util::expr::is_lazy_operand<E>::value>::type>
+    Matrix &operator=(const E &expression) {
+        if (rows() == expression.rows() && cols() == expression.cols()) {
+            util::expr::evaluate(util::expr::operand_t<E>(expression), data(),
+                                 row_stride(), col_stride());
+        } else {
+            // Evaluate into new storage, the expression could refer to the
+            // current storage of this matrix (e.g. through a view).
+            Matrix result(expression.rows(), expression.cols(),
+                          storage_order());
+            result = expression;
+            *this = std::move(result);
+        }
+        return *this;
+    }
+
     /// @}
 
   public:
@@ -74,7 +107,7 @@ class Matrix {
 
     /// Reshape the matrix. The new size must have the same number of elements,
     /// and the result depends on the storage order (column major order or
-    /// row major order).
+    /// row major order, see @ref storage_order).
     void reshape(size_t newrows, size_t newcols);
     /// Create a reshaped copy of the matrix.
     /// @see    @ref reshape
@@ -96,6 +129,58 @@ class Matrix {
     /// Get the element at the given position in the linearized matrix.
     const double &operator()(size_t index) const { return storage[index]; }
 
+    /// Get a pointer to the internal storage of the matrix.
+    double *data() { return storage.data(); }
+    /// Get a pointer to the internal storage of the matrix.
+    const double *data() const { return storage.data(); }
+
+    /// Get the order in which the elements are stored in memory.
+    StorageOrder storage_order() const { return order_; }
+    /// Get the distance in memory between two consecutive rows.
+    size_t row_stride() const {
+        return order_ == StorageOrder::ColMajor ? 1 : cols();
+    }
+    /// Get the distance in memory between two consecutive columns.
+    size_t col_stride() const {
+        return order_ == StorageOrder::ColMajor ? rows() : 1;
+    }
+
+    /// @}
+
+  public:
+    /// @name   Views
+    /// @{
+
+    /// View of the `rows`×`cols` block with its top left corner at position
+    /// (`row`, `col`).
+    MatrixView block(size_t row, size_t col, size_t rows, size_t cols) {
+        return MatrixView(*this).block(row, col, rows, cols);
+    }
+    /// View of the `rows`×`cols` block with its top left corner at position
+    /// (`row`, `col`).
+    ConstMatrixView block(size_t row, size_t col, size_t rows,
+                          size_t cols) const {
+        return ConstMatrixView(*this).block(row, col, rows, cols);
+    }
+    /// View of the given row.
+    MatrixView row(size_t row) { return MatrixView(*this).row(row); }
+    /// View of the given row.
+    ConstMatrixView row(size_t row) const {
+        return ConstMatrixView(*this).row(row);
+    }
+    /// View of the given column.
+    MatrixView col(size_t col) { return MatrixView(*this).col(col); }
+    /// View of the given column.
+    ConstMatrixView col(size_t col) const {
+        return ConstMatrixView(*this).col(col);
+    }
+    /// Column view of the main diagonal.
+    MatrixView diagonal() { return MatrixView(*this).diagonal(); }
+    /// Column view of the main diagonal.
+    ConstMatrixView diagonal() const {
+        return ConstMatrixView(*this).diagonal();
+    }
+
     /// @}
 
   public:
@@ -230,6 +315,7 @@ class Matrix {
   protected:
     size_t rows_ = 0, cols_ = 0;
     storage_t storage;
+    StorageOrder order_ = StorageOrder::ColMajor;
 
     friend class Vector;
     friend class RowVector;
@@ -255,6 +341,15 @@ class Vector : public Matrix {
     /// Assign a list of values to the column vector.
     Vector &operator=(std::initializer_list<double> init);
 
+    /// Evaluate an element-wise vector expression and assign the result to
+    /// this vector.
+    template <class E, class = typename std::enable_if<std::is_same<
+                           typename E::result_type, Vector>::value>::type>
+    Vector &operator=(const E &expression) {
+        Matrix::operator=(expression);
+        return *this;
+    }
+
     /// Convert an m×n matrix to a mn column vector.
     explicit Vector(const Matrix &matrix);
     /// Convert an m×n matrix to a mn column vector.
@@ -312,6 +407,12 @@ class Vector : public Matrix {
     /// Compute the dot product of two vectors. Reinterprets matrices as
     /// vectors.
     static double dot_unchecked(Matrix &&a, Matrix &&b);
+    /// Compute the dot product of two views. If both are row or column
+    /// vectors, they are treated as vectors, otherwise, they must have the
+    /// same dimensions, and the result is the sum of the element-wise
+    /// products.
+    static double dot_unchecked(const ConstMatrixView &a,
+                                const ConstMatrixView &b);
 
     /// Compute the dot product of two vectors.
     static double dot(const Vector &a, const Vector &b);
@@ -411,6 +512,15 @@ class RowVector : public Matrix {
     /// Assign a list of values to the column vector.
     RowVector &operator=(std::initializer_list<double> init);
 
+    /// Evaluate an element-wise row vector expression and assign the result to
+    /// this row vector.
+    template <class E, class = typename std::enable_if<std::is_same<
+                           typename E::result_type, RowVector>::value>::type>
+    RowVector &operator=(const E &expression) {
+        Matrix::operator=(expression);
+        return *this;
+    }
+
     /// Convert an m×n matrix to a mn row vector.
     explicit RowVector(const Matrix &matrix);
     /// Convert an m×n matrix to a mn row vector.
@@ -534,8 +644,9 @@ class SquareMatrix : public Matrix {
     /// Default constructor.
     SquareMatrix() = default;
 
-    /// Create a square matrix of zeros.
-    SquareMatrix(size_t size) : Matrix(size, size) {}
+    /// Create a square matrix of zeros with the given storage order.
+    SquareMatrix(size_t size, StorageOrder order = StorageOrder::ColMajor)
+        : Matrix(size, size, order) {}
 
     /// Create a square matrix with the given values.
     SquareMatrix(std::initializer_list<std::initializer_list<double>> init);
@@ -549,6 +660,15 @@ class SquareMatrix : public Matrix {
     SquareMatrix &
     operator=(std::initializer_list<std::initializer_list<double>> init);
 
+    /// Evaluate an element-wise square matrix expression and assign the result
+    /// to this square matrix.
+    template <class E, class = typename std::enable_if<std::is_same<
+                           typename E::result_type, SquareMatrix>::value>::type>
+    SquareMatrix &operator=(const E &expression) {
+        Matrix::operator=(expression);
+        return *this;
+    }
+
     /// @}
 
   public:
@@ -655,16 +775,30 @@ double operator*(const RowVector &a, Vector &&b);
 /// Vector-vector multiplication.
 double operator*(RowVector &&a, Vector &&b);
 
+/// Multiplication of matrix views.
+Matrix operator*(const ConstMatrixView &A, const ConstMatrixView &B);
+/// Matrix-vector multiplication with a view of a matrix.
+Vector operator*(const ConstMatrixView &A, const Vector &b);
+/// Vector-matrix multiplication with a view of a matrix.
+RowVector operator*(const RowVector &a, const ConstMatrixView &B);
+
 /// @}
 
 // -------------------------------------------------------------------------- //
 
 /// @defgroup   MatAdd  Addition
 /// @brief  Matrix and vector addition
+///
+/// Adding two matrices that are not rvalues results in an expression that is
+/// evaluated lazily (see @ref util::expr). Adding an rvalue reuses its
+/// storage for the result.
 /// @{
 
 /// Matrix addition.
-Matrix operator+(const Matrix &A, const Matrix &B);
+inline util::expr::Sum<Matrix, Matrix> operator+(const Matrix &A,
+                                                 const Matrix &B) {
+    return {A, B};
+}
 
 void operator+=(Matrix &A, const Matrix &B);
 Matrix &&operator+(Matrix &&A, const Matrix &B);
@@ -679,20 +813,70 @@ RowVector &&operator+(RowVector &&a, RowVector &&b);
 SquareMatrix &&operator+(SquareMatrix &&a, const SquareMatrix &b);
 SquareMatrix &&operator+(const SquareMatrix &a, SquareMatrix &&b);
 SquareMatrix &&operator+(SquareMatrix &&a, SquareMatrix &&b);
-Vector operator+(const Vector &a, const Vector &b);
-RowVector operator+(const RowVector &a, const RowVector &b);
-SquareMatrix operator+(const SquareMatrix &a, const SquareMatrix &b);
-
+inline util::expr::Sum<Vector, Vector> operator+(const Vector &a,
+                                                 const Vector &b) {
+    return {a, b};
+}
+inline util::expr::Sum<RowVector, RowVector> operator+(const RowVector &a,
+                                                       const RowVector &b) {
+    return {a, b};
+}
+inline util::expr::Sum<SquareMatrix, SquareMatrix>
+operator+(const SquareMatrix &a, const SquareMatrix &b) {
+    return {a, b};
+}
+
+/// Addition of matrix expressions.
+template <class L, class R>
+typename std::enable_if<util::expr::is_lazy<L, R>::value,
+                        util::expr::Sum<L, R>>::type
+operator+(L &&A, R &&B) {
+    return {A, B};
+}
+/// Addition of matrix expressions.
+/// The result is evaluated into the storage of the rvalue matrix @p A.
+template <class L, class R>
+typename std::enable_if<util::expr::is_into_lhs<L, R>::value,
+                        util::expr::rvalue_result_t<L, R>>::type
+operator+(L &&A, R &&B) {
+    util::expr::evaluate(util::expr::Sum<L, R>(A, B),
+                         A.data(), A.row_stride(), A.col_stride());
+    return std::move(A);
+}
+/// Addition of matrix expressions.
+/// The result is evaluated into the storage of the rvalue matrix @p B.
+template <class L, class R>
+typename std::enable_if<util::expr::is_into_rhs<L, R>::value,
+                        util::expr::rvalue_result_t<L, R>>::type
+operator+(L &&A, R &&B) {
+    util::expr::evaluate(util::expr::Sum<L, R>(A, B),
+                         B.data(), B.row_stride(), B.col_stride());
+    return std::move(B);
+}
+/// Add a matrix expression to a matrix, in a single pass.
+template <class E>
+typename std::enable_if<util::expr::is_lazy_operand<E>::value>::type
+operator+=(Matrix &A, const E &B) {
+    util::expr::evaluate(util::expr::Sum<Matrix &, E>(A, B),
+                         A.data(), A.row_stride(), A.col_stride());
+}
 /// @}
 
 // -------------------------------------------------------------------------- //
 
 /// @defgroup   MatSub  Subtraction
 /// @brief  Matrix and vector subtraction
+///
+/// Subtracting two matrices that are not rvalues results in an expression that
+/// is evaluated lazily (see @ref util::expr). Subtracting an rvalue reuses its
+/// storage for the result.
 /// @{
 
 /// Matrix subtraction.
-Matrix operator-(const Matrix &A, const Matrix &B);
+inline util::expr::Difference<Matrix, Matrix> operator-(const Matrix &A,
+                                                        const Matrix &B) {
+    return {A, B};
+}
 void operator-=(Matrix &A, const Matrix &B);
 Matrix &&operator-(Matrix &&A, const Matrix &B);
 Matrix &&operator-(const Matrix &A, Matrix &&B);
@@ -706,10 +890,53 @@ RowVector &&operator-(RowVector &&a, RowVector &&b);
 SquareMatrix &&operator-(SquareMatrix &&a, const SquareMatrix &b);
 SquareMatrix &&operator-(const SquareMatrix &a, SquareMatrix &&b);
 SquareMatrix &&operator-(SquareMatrix &&a, SquareMatrix &&b);
-Vector operator-(const Vector &a, const Vector &b);
-RowVector operator-(const RowVector &a, const RowVector &b);
-SquareMatrix operator-(const SquareMatrix &a, const SquareMatrix &b);
-
+inline util::expr::Difference<Vector, Vector> operator-(const Vector &a,
+                                                        const Vector &b) {
+    return {a, b};
+}
+inline util::expr::Difference<RowVector, RowVector>
+operator-(const RowVector &a, const RowVector &b) {
+    return {a, b};
+}
+inline util::expr::Difference<SquareMatrix, SquareMatrix>
+operator-(const SquareMatrix &a, const SquareMatrix &b) {
+    return {a, b};
+}
+
+/// Subtraction of matrix expressions.
+template <class L, class R>
+typename std::enable_if<util::expr::is_lazy<L, R>::value,
+                        util::expr::Difference<L, R>>::type
+operator-(L &&A, R &&B) {
+    return {A, B};
+}
+/// Subtraction of matrix expressions.
+/// The result is evaluated into the storage of the rvalue matrix @p A.
+template <class L, class R>
+typename std::enable_if<util::expr::is_into_lhs<L, R>::value,
+                        util::expr::rvalue_result_t<L, R>>::type
+operator-(L &&A, R &&B) {
+    util::expr::evaluate(util::expr::Difference<L, R>(A, B),
+                         A.data(), A.row_stride(), A.col_stride());
+    return std::move(A);
+}
+/// Subtraction of matrix expressions.
+/// The result is evaluated into the storage of the rvalue matrix @p B.
+template <class L, class R>
+typename std::enable_if<util::expr::is_into_rhs<L, R>::value,
+                        util::expr::rvalue_result_t<L, R>>::type
+operator-(L &&A, R &&B) {
+    util::expr::evaluate(util::expr::Difference<L, R>(A, B),
+                         B.data(), B.row_stride(), B.col_stride());
+    return std::move(B);
+}
+/// Subtract a matrix expression from a matrix, in a single pass.
+template <class E>
+typename std::enable_if<util::expr::is_lazy_operand<E>::value>::type
+operator-=(Matrix &A, const E &B) {
+    util::expr::evaluate(util::expr::Difference<Matrix &, E>(A, B),
+                         A.data(), A.row_stride(), A.col_stride());
+}
 /// @}
 
 // -------------------------------------------------------------------------- //
@@ -719,14 +946,26 @@ SquareMatrix operator-(const SquareMatrix &a, const SquareMatrix &b);
 /// @{
 
 /// Matrix negation.
-Matrix operator-(const Matrix &A);
+inline util::expr::Negated<Matrix> operator-(const Matrix &A) { return {A}; }
 Matrix &&operator-(Matrix &&A);
 Vector &&operator-(Vector &&a);
 RowVector &&operator-(RowVector &&a);
 SquareMatrix &&operator-(SquareMatrix &&a);
-Vector operator-(const Vector &a);
-RowVector operator-(const RowVector &a);
-SquareMatrix operator-(const SquareMatrix &a);
+inline util::expr::Negated<Vector> operator-(const Vector &a) { return {a}; }
+inline util::expr::Negated<RowVector> operator-(const RowVector &a) {
+    return {a};
+}
+inline util::expr::Negated<SquareMatrix> operator-(const SquareMatrix &a) {
+    return {a};
+}
+
+/// Negation of a matrix expression.
+template <class E>
+typename std::enable_if<util::expr::is_lazy_operand<E>::value,
+                        util::expr::Negated<E>>::type
+operator-(const E &A) {
+    return {A};
+}
 
 /// @}
 
@@ -737,25 +976,58 @@ SquareMatrix operator-(const SquareMatrix &a);
 /// @{
 
 /// Scalar multiplication.
-Matrix operator*(const Matrix &A, double s);
+inline util::expr::Product<Matrix> operator*(const Matrix &A, double s) {
+    return {A, s};
+}
 void operator*=(Matrix &A, double s);
 Matrix &&operator*(Matrix &&A, double s);
-Vector operator*(const Vector &a, double s);
-RowVector operator*(const RowVector &a, double s);
-SquareMatrix operator*(const SquareMatrix &a, double s);
+inline util::expr::Product<Vector> operator*(const Vector &a, double s) {
+    return {a, s};
+}
+inline util::expr::Product<RowVector> operator*(const RowVector &a, double s) {
+    return {a, s};
+}
+inline util::expr::Product<SquareMatrix> operator*(const SquareMatrix &a,
+                                                   double s) {
+    return {a, s};
+}
 Vector &&operator*(Vector &&a, double s);
 RowVector &&operator*(RowVector &&a, double s);
 SquareMatrix &&operator*(SquareMatrix &&a, double s);
 
-Matrix operator*(double s, const Matrix &A);
+inline util::expr::Product<Matrix> operator*(double s, const Matrix &A) {
+    return {A, s};
+}
 Matrix &&operator*(double s, Matrix &&A);
-Vector operator*(double s, const Vector &a);
-RowVector operator*(double s, const RowVector &a);
-SquareMatrix operator*(double s, const SquareMatrix &a);
+inline util::expr::Product<Vector> operator*(double s, const Vector &a) {
+    return {a, s};
+}
+inline util::expr::Product<RowVector> operator*(double s, const RowVector &a) {
+    return {a, s};
+}
+inline util::expr::Product<SquareMatrix> operator*(double s,
+                                                   const SquareMatrix &a) {
+    return {a, s};
+}
 Vector &&operator*(double s, Vector &&a);
 RowVector &&operator*(double s, RowVector &&a);
 SquareMatrix &&operator*(double s, SquareMatrix &&a);
 
+/// Multiplication of a matrix expression by a scalar.
+template <class E>
+typename std::enable_if<util::expr::is_lazy_operand<E>::value,
+                        util::expr::Product<E>>::type
+operator*(const E &A, double s) {
+    return {A, s};
+}
+/// Multiplication of a matrix expression by a scalar.
+template <class E>
+typename std::enable_if<util::expr::is_lazy_operand<E>::value,
+                        util::expr::Product<E>>::type
+operator*(double s, const E &A) {
+    return {A, s};
+}
+
 /// @}
 
 // -------------------------------------------------------------------------- //
@@ -765,16 +1037,35 @@ SquareMatrix &&operator*(double s, SquareMatrix &&a);
 /// @{
 
 /// Scalar division.
-Matrix operator/(const Matrix &A, double s);
+inline util::expr::Quotient<Matrix> operator/(const Matrix &A, double s) {
+    return {A, s};
+}
 void operator/=(Matrix &A, double s);
 Matrix &&operator/(Matrix &&A, double s);
-Vector operator/(const Vector &a, double s);
-RowVector operator/(const RowVector &a, double s);
-SquareMatrix operator/(const SquareMatrix &a, double s);
+inline util::expr::Quotient<Vector> operator/(const Vector &a, double s) {
+    return {a, s};
+}
+inline util::expr::Quotient<RowVector> operator/(const RowVector &a,
+                                                 double s) {
+    return {a, s};
+}
+inline util::expr::Quotient<SquareMatrix> operator/(const SquareMatrix &a,
+                                                    double s) {
+    return {a, s};
+}
 Vector &&operator/(Vector &&a, double s);
 RowVector &&operator/(RowVector &&a, double s);
 SquareMatrix &&operator/(SquareMatrix &&a, double s);
 
+/// Division of a matrix expression by a scalar.
+template <class E>
+typename std::enable_if<util::expr::is_lazy_operand<E>::value,
+                        util::expr::Quotient<E>>::type
+operator/(const E &A, double s) {
+    return {A, s};
+}
+
+/// @}
 /// @}
 
 /// @}
@@ -791,16 +1082,78 @@ SquareMatrix &&operator/(SquareMatrix &&a, double s);
 /// Matrix transpose for general matrices.
 Matrix explicit_transpose(const Matrix &in);
 
+/**
+ * @brief   Lazily evaluated transpose of a matrix.
+ *
+ * Returned by @ref transpose(const Matrix &) and
+ * @ref transpose(const SquareMatrix &). It doesn't copy any elements, it only
+ * refers to the original matrix, whose rows and columns are swapped by
+ * swapping its strides.
+ *
+ * Products with a transposed operand, such as `transpose(A) * A`,
+ * `transpose(A) * b` or `A * transpose(B)`, pass these swapped strides to the
+ * matrix multiplication kernel directly, so the transpose is never stored.
+ * Transposed triangular matrices can be passed to @ref triangular_solve in
+ * the same way. In all other cases, the transpose is converted to a matrix of
+ * type `T` (using @ref explicit_transpose).
+ *
+ * @warning Like views, a lazy transpose refers to the matrix it was created
+ *          from, so it must not outlive it. Don't store it using `auto`,
+ *          assign it to a matrix instead.
+ *
+ * @tparam  T
+ *          The type of the original matrix and of its transpose, either
+ *          @ref Matrix or @ref SquareMatrix.
+ */
+template <class T>
+class Transposed {
+  public:
+    explicit Transposed(const T &matrix) : matrix(matrix) {}
+
+    /// Get the number of rows of the transpose.
+    size_t rows() const { return matrix.cols(); }
+    /// Get the number of columns of the transpose.
+    size_t cols() const { return matrix.rows(); }
+
+    /// Get the element at the given position in the transpose.
+    const double &operator()(size_t row, size_t col) const {
+        return matrix(col, row);
+    }
+
+    /// View of the elements of the transpose: the original matrix with its
+    /// dimensions and strides swapped.
+    ConstMatrixView view() const {
+        return {matrix.data(), rows(), cols(), matrix.col_stride(),
+                matrix.row_stride()};
+    }
+
+    /// Evaluate the transpose.
+    operator T() const { return T(explicit_transpose(matrix)); }
+    /// Evaluate the transpose.
+    T eval() const { return *this; }
+
+    /// Compute the Frobenius norm of the transpose, without storing it.
+    double normFro() const { return view().normFro(); }
+
+  private:
+    const T &matrix;
+};
+
+/// Lazy matrix transpose for rectangular or square matrices and row or column
+/// vectors, see @ref Transposed.
+inline Transposed<Matrix> transpose(const Matrix &in) {
+    return Transposed<Matrix>(in);
+}
 /// Matrix transpose for rectangular or square matrices and row or column
-/// vectors.
-Matrix transpose(const Matrix &in);
-/// Matrix transpose for rectangular or square matrices and row or column
-/// vectors.
+/// vectors. The storage of the argument is reused for the result.
 Matrix &&transpose(Matrix &&in);
 
-/// Square matrix transpose.
-SquareMatrix transpose(const SquareMatrix &in);
-/// Square matrix transpose.
+/// Lazy square matrix transpose, see @ref Transposed.
+inline Transposed<SquareMatrix> transpose(const SquareMatrix &in) {
+    return Transposed<SquareMatrix>(in);
+}
+/// Square matrix transpose. The storage of the argument is reused for the
+/// result.
 SquareMatrix &&transpose(SquareMatrix &&in);
 
 /// Vector transpose.
@@ -812,6 +1165,198 @@ Vector transpose(const RowVector &in);
 /// Vector transpose.
 Vector transpose(RowVector &&in);
 
+namespace util {
+namespace expr {
+
+/// Check whether T is a lazy transpose.
+template <class T>
+struct is_transposed : std::false_type {};
+template <class T>
+struct is_transposed<Transposed<T>> : std::true_type {};
+
+/// Check whether T can be an operand of a product with a lazy transpose.
+template <class T>
+struct is_product_operand
+    : std::integral_constant<bool, is_transposed<T>::value ||
+                                       is_matrix<T>::value ||
+                                       is_view<T>::value> {};
+
+/// Check whether the product of L and R consumes a lazy transpose directly:
+/// at least one of them has to be a lazy transpose, the other one can be a
+/// matrix, a view or another lazy transpose.
+template <class L, class R>
+struct is_transposed_product
+    : std::integral_constant<
+          bool, (is_transposed<decay_t<L>>::value ||
+                 is_transposed<decay_t<R>>::value) &&
+                    is_product_operand<decay_t<L>>::value &&
+                    is_product_operand<decay_t<R>>::value> {};
+
+/// The type of matrix that the operand of a product represents.
+template <class T>
+struct product_operand {
+    using type = T;
+};
+template <class T>
+struct product_operand<Transposed<T>> {
+    using type = T;
+};
+template <class T>
+using product_operand_t = typename product_operand<decay_t<T>>::type;
+
+/// Type of the result of a product, following the non-lazy overloads of
+/// `operator*`: the product of two square matrices is a square matrix, a
+/// matrix times a column vector is a column vector, a row vector times a
+/// matrix is a row vector, and all other products are general matrices.
+template <class L, class R>
+using product_result_t = typename std::conditional<
+    std::is_same<R, Vector>::value, Vector,
+    typename std::conditional<
+        std::is_same<L, RowVector>::value, RowVector,
+        typename std::conditional<std::is_same<L, SquareMatrix>::value &&
+                                      std::is_same<R, SquareMatrix>::value,
+                                  SquareMatrix, Matrix>::type>::type>::type;
+
+/// Get the strides of the operand of a product.
+inline ConstMatrixView as_view(const ConstMatrixView &A) { return A; }
+/// Get the swapped strides of a lazy transpose.
+template <class T>
+ConstMatrixView as_view(const Transposed<T> &A) {
+    return A.view();
+}
+
+} // namespace expr
+} // namespace util
+
+/// Multiplication with a lazy transpose (Aᵀ·B, A·Bᵀ or Aᵀ·Bᵀ). The operands
+/// are passed to the matrix multiplication kernel with their strides swapped,
+/// so the transpose is never evaluated.
+template <class L, class R>
+typename std::enable_if<
+    util::expr::is_transposed_product<L, R>::value,
+    util::expr::product_result_t<util::expr::product_operand_t<L>,
+                                 util::expr::product_operand_t<R>>>::type
+operator*(L &&A, R &&B) {
+    using Result =
+        util::expr::product_result_t<util::expr::product_operand_t<L>,
+                                     util::expr::product_operand_t<R>>;
+    return Result(util::expr::as_view(A) * util::expr::as_view(B));
+}
+
+/// @}
+
+// -------------------------------------------------------------------------- //
+
+/// @defgroup   MatMulInplace   In-place multiplication
+/// @brief  BLAS-style products that are accumulated into existing storage
+///
+/// Unlike the multiplication operators, these functions don't allocate a new
+/// matrix for the result, which makes them suitable for the inner loops of
+/// iterative algorithms.
+/// @{
+
+/// Matrix product C = α·A·B + β·C, evaluated in the storage of C.
+/// The operands can be matrices, views, or lazy transposes, e.g.
+/// `gemm(1, transpose(A), B, 0, C)` computes AᵀB without evaluating the
+/// transpose. If β is zero, the original elements of C are ignored.
+/// Products where B is a column or A is a row are computed by @ref gemv.
+/// @note   C must not overlap with A or B. Use @ref add_product if it might.
+void gemm(double alpha, const ConstMatrixView &A, const ConstMatrixView &B,
+          double beta, MatrixView C);
+/// Matrix product C = α·op(A)·op(B) + β·C where op(A) and/or op(B) is a lazy
+/// transpose, evaluated in the storage of C, without evaluating the
+/// transposes.
+template <class L, class R>
+typename std::enable_if<util::expr::is_transposed_product<L, R>::value>::type
+gemm(double alpha, const L &A, const R &B, double beta, MatrixView C) {
+    gemm(alpha, util::expr::as_view(A), util::expr::as_view(B), beta, C);
+}
+
+/// Compute C += A·B without allocating a matrix for the product, unlike
+/// `C += A * B`. C may overlap with A or B, the product is then evaluated
+/// into a temporary matrix first.
+void add_product(MatrixView C, const ConstMatrixView &A,
+                 const ConstMatrixView &B);
+/// Compute C += op(A)·op(B) where op(A) and/or op(B) is a lazy transpose.
+template <class L, class R>
+typename std::enable_if<util::expr::is_transposed_product<L, R>::value>::type
+add_product(MatrixView C, const L &A, const R &B) {
+    add_product(C, util::expr::as_view(A), util::expr::as_view(B));
+}
+/// Compute C -= A·B without allocating a matrix for the product, unlike
+/// `C -= A * B`. C may overlap with A or B, the product is then evaluated
+/// into a temporary matrix first.
+void subtract_product(MatrixView C, const ConstMatrixView &A,
+                      const ConstMatrixView &B);
+/// Compute C -= op(A)·op(B) where op(A) and/or op(B) is a lazy transpose.
+template <class L, class R>
+typename std::enable_if<util::expr::is_transposed_product<L, R>::value>::type
+subtract_product(MatrixView C, const L &A, const R &B) {
+    subtract_product(C, util::expr::as_view(A), util::expr::as_view(B));
+}
+
+/// Matrix-vector product y = α·A·x + β·y, evaluated in the storage of y.
+/// The vectors x and y can be row or column vectors, or views of a row or a
+/// column of a matrix. If β is zero, the original elements of y are ignored.
+/// For the product xᵀA, pass the lazy transpose of A, e.g.
+/// `gemv(1, transpose(A), x, 0, y)`.
+void gemv(double alpha, const ConstMatrixView &A, const ConstMatrixView &x,
+          double beta, MatrixView y);
+/// Matrix-vector product y = α·Aᵀ·x + β·y with a lazy transpose, evaluated in
+/// the storage of y, without evaluating the transpose.
+template <class T>
+void gemv(double alpha, const Transposed<T> &A, const ConstMatrixView &x,
+          double beta, MatrixView y) {
+    gemv(alpha, A.view(), x, beta, y);
+}
+
 /// @}
 
 /// @}
+
+//                              Implementations                               //
+// -------------------------------------------------------------------------- //
+
+// Element access and other small member functions are defined here rather than
+// in Matrix.cpp, so they can be inlined into the loops of the caller.
+
+inline double &Matrix::operator()(size_t row, size_t col) {
+    return order_ == StorageOrder::ColMajor ? storage[row + rows_ * col]
+                                            : storage[row * cols_ + col];
+}
+
+inline const double &Matrix::operator()(size_t row, size_t col) const {
+    return order_ == StorageOrder::ColMajor ? storage[row + rows_ * col]
+                                            : storage[row * cols_ + col];
+}
+
+inline void Matrix::reshape(size_t newrows, size_t newcols) {
+    assert(newrows * newcols == rows() * cols());
+    this->rows_ = newrows;
+    this->cols_ = newcols;
+}
+
+inline void Matrix::clear_and_deallocate() {
+    this->rows_ = 0;
+    this->cols_ = 0;
+    storage_t().swap(this->storage); // replace storage with empty storage
+    // temporary storage goes out of scope and deallocates original storage
+}
+
+inline void Matrix::swap_columns(size_t a, size_t b) {
+    for (size_t r = 0; r < rows(); ++r)
+        std::swap((*this)(r, a), (*this)(r, b));
+}
+
+inline void Matrix::swap_rows(size_t a, size_t b) {
+    for (size_t c = 0; c < cols(); ++c)
+        std::swap((*this)(a, c), (*this)(b, c));
+}
+
+inline ConstMatrixView::ConstMatrixView(const Matrix &matrix)
+    : ConstMatrixView(matrix.data(), matrix.rows(), matrix.cols(),
+                      matrix.row_stride(), matrix.col_stride()) {}
+
+inline MatrixView::MatrixView(Matrix &matrix)
+    : MatrixView(matrix.data(), matrix.rows(), matrix.cols(),
+                 matrix.row_stride(), matrix.col_stride()) {}
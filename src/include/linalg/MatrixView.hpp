@@ -0,0 +1,273 @@
+#pragma once
+
+#include <cassert>     // assert
+#include <cstddef>     // size_t
+#include <iosfwd>      // std::ostream
+#include <type_traits> // std::enable_if
+
+#include "util/MatrixExpression.hpp"
+
+using std::size_t;
+
+class Matrix;
+
+/// @addtogroup MatVec
+/// @{
+
+/**
+ * @brief   Read-only view of (part of) the elements of a matrix.
+ *
+ * A view doesn't own or copy any elements, it only stores a pointer to the
+ * first element, its dimensions, and the distances between consecutive rows
+ * and columns in memory (the strides). This makes it possible to work with a
+ * block, a row, a column or the diagonal of a matrix without copying it.
+ *
+ * Views can be used as operands of the element-wise operators, of matrix
+ * multiplication, and of @ref Vector::dot_unchecked. Use
+ * @ref Matrix::Matrix(const ConstMatrixView &) to copy the elements of a view
+ * into a new matrix.
+ *
+ * @warning Like iterators, a view becomes invalid when the matrix it refers
+ *          to is destroyed, resized or moved from.
+ */
+class ConstMatrixView {
+  public:
+    /// The element (r, c) is stored at `data[r * row_stride + c * col_stride]`.
+    ConstMatrixView(const double *data, size_t rows, size_t cols,
+                    size_t row_stride, size_t col_stride)
+        : data_(data), rows_(rows), cols_(cols), rs(row_stride),
+          cs(col_stride) {}
+
+    /// View of all elements of the given matrix.
+    /// Defined inline in Matrix.hpp.
+    ConstMatrixView(const Matrix &matrix);
+
+  public:
+    /// @name   View size and layout
+    /// @{
+
+    /// Get the number of rows of the view.
+    size_t rows() const { return rows_; }
+    /// Get the number of columns of the view.
+    size_t cols() const { return cols_; }
+    /// Get the number of elements in the view.
+    size_t num_elems() const { return rows_ * cols_; }
+
+    /// Get the distance in memory between two consecutive rows.
+    size_t row_stride() const { return rs; }
+    /// Get the distance in memory between two consecutive columns.
+    size_t col_stride() const { return cs; }
+
+    /// Get a pointer to the first element of the view.
+    const double *data() const { return data_; }
+
+    /// @}
+
+  public:
+    /// @name   Element access
+    /// @{
+
+    /// Get the element at the given position in the view.
+    const double &operator()(size_t row, size_t col) const {
+        return data_[row * rs + col * cs];
+    }
+    /// Get the element at the given position in a row or column view.
+    const double &operator()(size_t index) const {
+        return data_[index * vector_stride()];
+    }
+
+    /// @}
+
+  public:
+    /// @name   Sub-views
+    /// @{
+
+    /// View of the `rows`×`cols` block with its top left corner at position
+    /// (`row`, `col`).
+    ConstMatrixView block(size_t row, size_t col, size_t rows,
+                          size_t cols) const {
+        assert(row + rows <= rows_);
+        assert(col + cols <= cols_);
+        return {&(*this)(row, col), rows, cols, rs, cs};
+    }
+    /// View of the given row.
+    ConstMatrixView row(size_t row) const { return block(row, 0, 1, cols_); }
+    /// View of the given column.
+    ConstMatrixView col(size_t col) const { return block(0, col, rows_, 1); }
+    /// Column view of the main diagonal.
+    ConstMatrixView diagonal() const {
+        return {data_, rows_ < cols_ ? rows_ : cols_, 1, rs + cs, 0};
+    }
+
+    /// @}
+
+  public:
+    /// @name   Matrix norms
+    /// @{
+
+    /// Compute the Frobenius norm of the view.
+    double normFro() const;
+
+    /// @}
+
+  private:
+    /// Stride between consecutive elements of a row or column view.
+    size_t vector_stride() const {
+        assert(rows_ == 1 || cols_ == 1);
+        return rows_ == 1 ? cs : rs;
+    }
+
+  private:
+    const double *data_;
+    size_t rows_, cols_;
+    size_t rs, cs;
+};
+
+/**
+ * @brief   Mutable view of (part of) the elements of a matrix.
+ *
+ * Unlike the assignment of a matrix, assigning to a view overwrites the
+ * elements it refers to, e.g. `A.col(0) = B.col(1)` copies a column of B into
+ * A, and `A.row(1) *= 2` scales a row of A.
+ *
+ * @warning The elements that are assigned to must not partially overlap with
+ *          the elements of the right-hand side, e.g. `A.block(0, 0, 2, 2) =
+ *          A.block(1, 1, 2, 2)` gives wrong results. Copy the right-hand side
+ *          to a Matrix first in that case.
+ */
+class MatrixView : public ConstMatrixView {
+  public:
+    /// The element (r, c) is stored at `data[r * row_stride + c * col_stride]`.
+    MatrixView(double *data, size_t rows, size_t cols, size_t row_stride,
+               size_t col_stride)
+        : ConstMatrixView(data, rows, cols, row_stride, col_stride) {}
+
+    /// View of all elements of the given matrix.
+    /// Defined inline in Matrix.hpp.
+    MatrixView(Matrix &matrix);
+
+    /// Copy the handle, not the elements.
+    MatrixView(const MatrixView &) = default;
+
+  public:
+    /// @name   Assignment
+    /// @{
+
+    /// Copy the elements of the given view to the elements of this view.
+    MatrixView &operator=(const MatrixView &other) {
+        assign(other);
+        return *this;
+    }
+    /// Copy the elements of a matrix or a view, or evaluate an element-wise
+    /// expression, into the elements of this view.
+    template <class E, class = typename std::enable_if<
+                           util::expr::is_operand<E>::value>::type>
+    MatrixView &operator=(const E &other) {
+        assign(other);
+        return *this;
+    }
+
+    /// Set all elements of the view to the given value.
+    void fill(double value);
+
+    /// @}
+
+  public:
+    /// @name   Compound assignment
+    /// @{
+
+    /// Add a matrix, view or expression to the elements of this view.
+    template <class E>
+    typename std::enable_if<util::expr::is_operand<E>::value,
+                            MatrixView &>::type
+    operator+=(const E &other) {
+        assign(util::expr::Sum<ConstMatrixView, E>(*this, other));
+        return *this;
+    }
+    /// Subtract a matrix, view or expression from the elements of this view.
+    template <class E>
+    typename std::enable_if<util::expr::is_operand<E>::value,
+                            MatrixView &>::type
+    operator-=(const E &other) {
+        assign(util::expr::Difference<ConstMatrixView, E>(*this, other));
+        return *this;
+    }
+    /// Multiply the elements of this view by a scalar.
+    MatrixView &operator*=(double s) {
+        assign(util::expr::Product<ConstMatrixView>(*this, s));
+        return *this;
+    }
+    /// Divide the elements of this view by a scalar.
+    MatrixView &operator/=(double s) {
+        assign(util::expr::Quotient<ConstMatrixView>(*this, s));
+        return *this;
+    }
+
+    /// @}
+
+  public:
+    /// @name   Element access
+    /// @{
+
+    /// Get the element at the given position in the view.
+    double &operator()(size_t row, size_t col) const {
+        return const_cast<double &>(ConstMatrixView::operator()(row, col));
+    }
+    /// Get the element at the given position in a row or column view.
+    double &operator()(size_t index) const {
+        return const_cast<double &>(ConstMatrixView::operator()(index));
+    }
+
+    /// Get a pointer to the first element of the view.
+    double *data() const {
+        return const_cast<double *>(ConstMatrixView::data());
+    }
+
+    /// @}
+
+  public:
+    /// @name   Sub-views
+    /// @{
+
+    /// View of the `rows`×`cols` block with its top left corner at position
+    /// (`row`, `col`).
+    MatrixView block(size_t row, size_t col, size_t rows, size_t cols) const {
+        return mutable_view(ConstMatrixView::block(row, col, rows, cols));
+    }
+    /// View of the given row.
+    MatrixView row(size_t row) const {
+        return mutable_view(ConstMatrixView::row(row));
+    }
+    /// View of the given column.
+    MatrixView col(size_t col) const {
+        return mutable_view(ConstMatrixView::col(col));
+    }
+    /// Column view of the main diagonal.
+    MatrixView diagonal() const {
+        return mutable_view(ConstMatrixView::diagonal());
+    }
+
+    /// @}
+
+  private:
+    /// Evaluate the given operand element by element, and write the result to
+    /// the elements of this view.
+    template <class E>
+    void assign(const E &e) {
+        assert(e.rows() == rows());
+        assert(e.cols() == cols());
+        util::expr::evaluate(util::expr::operand_t<E>(e), data(),
+                             row_stride(), col_stride());
+    }
+
+    static MatrixView mutable_view(const ConstMatrixView &v) {
+        return {const_cast<double *>(v.data()), v.rows(), v.cols(),
+                v.row_stride(), v.col_stride()};
+    }
+};
+
+/// @}
+
+/// Print a view.
+/// @related    ConstMatrixView
+std::ostream &operator<<(std::ostream &os, const ConstMatrixView &view);
@@ -124,11 +124,14 @@ class NoPivotLU {
   private:
     /// The actual LU factorization algorithm.
     void compute_factorization();
-    /// Back substitution algorithm for solving upper-triangular systems UX = B.
-    void back_subs(const Matrix &B, Matrix &X) const;
+    /// Unblocked factorization of the b columns starting at column k.
+    void compute_panel_factorization(size_t k, size_t b);
+    /// Back substitution algorithm for solving upper-triangular systems UX = B,
+    /// overwriting B with X.
+    void back_subs(Matrix &B) const;
     /// Forward substitution algorithm for solving lower-triangular systems
-    /// LX = B.
-    void forward_subs(const Matrix &B, Matrix &X) const;
+    /// LX = B, overwriting B with X.
+    void forward_subs(Matrix &B) const;
 
   private:
     /// Result of a LU factorization: stores the upper-triangular
@@ -82,6 +82,11 @@ class PermutationMatrix {
     /// @copydoc    operator()(size_t)
     const size_t &operator()(size_t index) const { return storage[index]; }
 
+    /// Get a pointer to the first element of the swap sequence.
+    size_t *data() { return storage.data(); }
+    /// @copydoc    data()
+    const size_t *data() const { return storage.data(); }
+
     /// @}
 
   public:
@@ -122,15 +127,47 @@ class PermutationMatrix {
 
     /// @}
 
+  public:
+    /// @name   Inverting permutations
+    /// @{
+
+    /// Get the inverse (i.e. the transpose) of the permutation matrix.
+    /// Unlike @ref transpose_inplace, which simply reverses the order of the
+    /// swaps, the result is converted to a sequence of swaps that is applied
+    /// in the usual order. Requires O(n) operations.
+    PermutationMatrix inverse() const;
+
+    /// Return the inverse of the given permutation, that is, the permutation
+    /// `q` such that `q[p[i]] == i` for all i. Requires O(n) operations.
+    static Permutation inverse_permutation(const Permutation &p);
+
+    /// @}
+
   public:
     /// @name   Applying the permutation to matrices
     /// @{
 
     /// Apply the permutation to the columns of matrix A.
+    /// Large matrices are permuted in parallel, see
+    /// @ref set_parallel_permutation_threshold.
     void permute_columns(Matrix &A) const;
     /// Apply the permutation to the rows of matrix A.
+    /// The swaps are applied to chunks of columns that fit in the cache, and
+    /// large matrices are permuted in parallel, see
+    /// @ref set_parallel_permutation_threshold.
     void permute_rows(Matrix &A) const;
 
+    /// Apply the permutation to the columns of matrix A, and store the result
+    /// in matrix B, without modifying A. B should have the same size as A.
+    /// Each column of B is gathered from A in a single pass, rather than
+    /// swapping columns one at a time.
+    void permute_columns(const Matrix &A, Matrix &B) const;
+    /// Apply the permutation to the rows of matrix A, and store the result
+    /// in matrix B, without modifying A. B should have the same size as A.
+    /// Each row of B is gathered from A in a single pass, rather than
+    /// swapping rows one at a time.
+    void permute_rows(const Matrix &A, Matrix &B) const;
+
     /// @}
 
   public:
@@ -168,12 +205,9 @@ class PermutationMatrix {
     void fill_identity() { std::iota(begin(), end(), size_t(0)); }
 
     /// Create a permutation matrix from the given permutation.
-    /// @note   This isn't a very fast method, it's mainly used for tests.
-    ///         Internally, the permutation matrix is represented by a sequence
-    ///         of swap operations. Converting from this representation to a
-    ///         mathematical permutation is fast, but the other way around
-    ///         requires O(n²) operations (with the naive implementation used 
-    ///         here, anyway).
+    /// Internally, the permutation matrix is represented by a sequence of swap
+    /// operations. The permutation is converted to this representation in
+    /// O(n) operations, using an index of the positions of its elements.
     void fill_from_permutation(Permutation permutation);
 
     /// Fill the matrix with a random permutation.
@@ -273,8 +307,8 @@ std::ostream &operator<<(std::ostream &os, const PermutationMatrix &M);
 
 /// Left application of permutation matrix (P permutes rows of A).
 inline Matrix operator*(const PermutationMatrix &P, const Matrix &A) {
-    Matrix result = A;
-    P.permute_rows(result);
+    Matrix result(A.rows(), A.cols());
+    P.permute_rows(A, result);
     return result;
 }
 /// Left application of permutation matrix (P permutes rows of A).
@@ -284,8 +318,8 @@ inline Matrix &&operator*(const PermutationMatrix &P, Matrix &&A) {
 }
 /// Right application of permutation matrix (P permutes columns of A).
 inline Matrix operator*(const Matrix &A, const PermutationMatrix &P) {
-    Matrix result = A;
-    P.permute_columns(result);
+    Matrix result(A.rows(), A.cols());
+    P.permute_columns(A, result);
     return result;
 }
 /// Right application of permutation matrix (P permutes columns of A).
@@ -297,8 +331,8 @@ inline Matrix &&operator*(Matrix &&A, const PermutationMatrix &P) {
 /// Left application of permutation matrix (P permutes rows of A).
 inline SquareMatrix operator*(const PermutationMatrix &P,
                               const SquareMatrix &A) {
-    SquareMatrix result = A;
-    P.permute_rows(result);
+    SquareMatrix result(A.rows());
+    P.permute_rows(A, result);
     return result;
 }
 /// Left application of permutation matrix (P permutes rows of A).
@@ -309,8 +343,8 @@ inline SquareMatrix &&operator*(const PermutationMatrix &P, SquareMatrix &&A) {
 /// Right application of permutation matrix (P permutes columns of A).
 inline SquareMatrix operator*(const SquareMatrix &A,
                               const PermutationMatrix &P) {
-    SquareMatrix result = A;
-    P.permute_columns(result);
+    SquareMatrix result(A.rows());
+    P.permute_columns(A, result);
     return result;
 }
 /// Right application of permutation matrix (P permutes columns of A).
@@ -321,8 +355,8 @@ inline SquareMatrix &&operator*(SquareMatrix &&A, const PermutationMatrix &P) {
 
 /// Left application of permutation matrix (P permutes rows of v).
 inline Vector operator*(const PermutationMatrix &P, const Vector &v) {
-    Vector result = v;
-    P.permute_rows(result);
+    Vector result(v.size());
+    P.permute_rows(v, result);
     return result;
 }
 /// Left application of permutation matrix (P permutes rows of v).
@@ -333,8 +367,8 @@ inline Vector &&operator*(const PermutationMatrix &P, Vector &&v) {
 
 /// Right application of permutation matrix (P permutes columns of v).
 inline RowVector operator*(const RowVector &v, const PermutationMatrix &P) {
-    RowVector result = v;
-    P.permute_columns(result);
+    RowVector result(v.size());
+    P.permute_columns(v, result);
     return result;
 }
 /// Right application of permutation matrix (P permutes columns of v).
@@ -343,6 +377,15 @@ inline RowVector &&operator*(RowVector &&v, const PermutationMatrix &P) {
     return std::move(v);
 }
 
+/// Compose two permutation matrices, i.e. compute their product P·Q without
+/// converting them to full matrices. Requires O(n) operations.
+/// Both matrices should have the same type (or an unspecified type). For row
+/// permutations, `compose(P, Q) * A == P * (Q * A)`, and for column
+/// permutations, `A * compose(P, Q) == (A * P) * Q`. Matrices of unspecified
+/// type are composed as row permutations.
+PermutationMatrix compose(const PermutationMatrix &P,
+                          const PermutationMatrix &Q);
+
 /// @}
 
 /// @addtogroup MatTrans
@@ -430,36 +473,4 @@ PermutationMatrix::operator=(std::initializer_list<size_t> init) {
     return *this;
 }
 
-inline void PermutationMatrix::permute_columns(Matrix &A) const {
-    assert(A.cols() == size());
-    assert(get_type() != RowPermutation);
-    auto &This = *this;
-    if (is_reversed()) {
-        // Count down
-        for (size_t i = size(); i-- > 0;)
-            if (i != This(i))
-                A.swap_columns(i, This(i));
-    } else {
-        // Count up
-        for (size_t i = 0; i < size(); ++i)
-            if (i != This(i))
-                A.swap_columns(i, This(i));
-    }
-}
 
-inline void PermutationMatrix::permute_rows(Matrix &A) const {
-    assert(A.rows() == size());
-    assert(get_type() != ColumnPermutation);
-    auto &This = *this;
-    if (is_reversed()) {
-        // Count down
-        for (size_t i = size(); i-- > 0;)
-            if (i != This(i))
-                A.swap_rows(i, This(i));
-    } else {
-        // Count up
-        for (size_t i = 0; i < size(); ++i)
-            if (i != This(i))
-                A.swap_rows(i, This(i));
-    }
-}
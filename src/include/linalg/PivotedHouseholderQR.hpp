@@ -0,0 +1,201 @@
+#pragma once
+
+#include "Matrix.hpp"
+#include "PermutationMatrix.hpp"
+
+/**
+ * @brief   QR factorization using Householder reflectors with column pivoting.
+ *
+ * Factorizes an m×n matrix A with m >= n as AP = QR, where P is an n×n
+ * permutation matrix, Q is an m×m unitary matrix and R is an m×n upper
+ * triangular matrix.
+ *
+ * At each step, the column with the largest remaining norm is moved to the
+ * front, so the magnitudes of the diagonal elements of R are non-increasing.
+ * This makes the factorization rank-revealing: the numerical rank of A is the
+ * number of diagonal elements of R that are not negligible compared to the
+ * first one (see @ref get_rank). It can be used for solving least squares
+ * problems with matrices that are rank-deficient or have nearly collinear
+ * columns.
+ *
+ * The Householder reflectors are stored in the same format as for
+ * @ref HouseholderQR.
+ *
+ * @ingroup Factorizations
+ */
+class PivotedHouseholderQR {
+  public:
+    /// @name Constructors
+    /// @{
+
+    /// Default constructor.
+    PivotedHouseholderQR() = default;
+    /// Factorize the given matrix.
+    PivotedHouseholderQR(const Matrix &matrix) { compute(matrix); }
+    /// Factorize the given matrix.
+    PivotedHouseholderQR(Matrix &&matrix) { compute(std::move(matrix)); }
+
+    /// @}
+
+  public:
+    /// @name Factorization
+    /// @{
+
+    /// Perform the QR factorization of the given matrix.
+    void compute(Matrix &&matrix);
+    /// Perform the QR factorization of the given matrix.
+    void compute(const Matrix &matrix);
+
+    /// @}
+
+  public:
+    /// @name   Retrieving the Q factor
+    /// @{
+
+    /// Compute the product QᵀB, overwriting B with the result.
+    void apply_QT_inplace(Matrix &B) const;
+    /// Compute the product QᵀB.
+    Matrix apply_QT(const Matrix &B) const;
+    /// Compute the product QᵀB.
+    Matrix &&apply_QT(Matrix &&B) const;
+
+    /// Compute the product QB, overwriting B with the result.
+    void apply_Q_inplace(Matrix &X) const;
+    /// Compute the product QB.
+    Matrix apply_Q(const Matrix &X) const;
+    /// Compute the product QB.
+    Matrix &&apply_Q(Matrix &&B) const;
+
+    /// Compute the unitary matrix Q and copy it to the given matrix.
+    void get_Q_inplace(SquareMatrix &Q) const;
+    /// Compute the unitary matrix Q.
+    SquareMatrix get_Q() const;
+
+    /// @}
+
+  public:
+    /// @name   Retrieving the R factor
+    /// @{
+
+    /// Get the upper-triangular matrix R, reusing the internal storage.
+    /// @warning    After calling this function, the PivotedHouseholderQR
+    ///             object is no longer valid, because this function steals its
+    ///             storage. Stealing both R and P is allowed.
+    Matrix &&steal_R();
+
+    /// Copy the upper-triangular matrix R to the given matrix.
+    void get_R_inplace(Matrix &R) const;
+    /// Get a copy of the upper-triangular matrix R.
+    Matrix get_R() const &;
+    /// Get the upper-triangular matrix R.
+    Matrix &&get_R() && { return steal_R(); }
+
+    /// @}
+
+  public:
+    /// @name   Retrieving the P factor
+    /// @{
+
+    /// Get the column permutation matrix P, reusing the internal storage.
+    /// @warning    After calling this function, the PivotedHouseholderQR
+    ///             object is no longer valid, because this function steals its
+    ///             storage. Stealing both R and P is allowed.
+    PermutationMatrix &&steal_P();
+
+    /// Get a copy of the column permutation matrix P.
+    PermutationMatrix get_P() const & { return P; }
+    /// Get the column permutation matrix P.
+    PermutationMatrix &&get_P() && { return steal_P(); }
+
+    /// @}
+
+  public:
+    /// @name   Numerical rank
+    /// @{
+
+    /// Get the numerical rank of the matrix: the number of diagonal elements
+    /// of R whose magnitude is larger than `tolerance` times the magnitude of
+    /// the first diagonal element.
+    size_t get_rank(double tolerance) const;
+    /// Get the numerical rank of the matrix, using the default tolerance.
+    size_t get_rank() const { return get_rank(default_tolerance()); }
+
+    /// Get the default relative tolerance for the numerical rank:
+    /// max(m, n)·ε, where ε is the machine epsilon.
+    double default_tolerance() const;
+
+    /// @}
+
+  public:
+    /// @name   Solving systems of equations and least-squares problems
+    /// @{
+
+    /// Solve the least-squares problem AX ≈ B, using the numerical rank r with
+    /// the default tolerance. Only the first r columns of AP are used, the
+    /// remaining elements of the solution (in permuted order) are zero
+    /// (this is the so-called basic solution).
+    /// Matrix B is overwritten with the result X. If the matrix A is square,
+    /// no new allocations occur, and the storage of B is reused for X.
+    /// If A is not square, new storage will be allocated for X.
+    void solve_inplace(Matrix &B) const;
+    /// Solve the least-squares problem AX ≈ B, see @ref solve_inplace.
+    Matrix solve(const Matrix &B) const;
+    /// Solve the least-squares problem AX ≈ B, see @ref solve_inplace.
+    Matrix &&solve(Matrix &&B) const;
+    /// Solve the least-squares problem Ax ≈ b, see @ref solve_inplace.
+    Vector solve(const Vector &B) const;
+    /// Solve the least-squares problem Ax ≈ b, see @ref solve_inplace.
+    Vector &&solve(Vector &&B) const;
+
+    /// @}
+
+  public:
+    /// @name   Access to internal representation
+    /// @{
+
+    /// Check if this object contains a valid factorization.
+    bool is_factored() const { return state == Factored; }
+
+    /// Get the internal storage of the strict upper-triangular part of R and
+    /// the Householder reflector vectors W.
+    const Matrix &get_RW() const & { return RW; }
+    /// @copydoc    get_RW
+    Matrix &&get_RW() && { return std::move(RW); }
+    /// Get the internal storage of the diagonal elements of R.
+    const Vector &get_R_diag() const & { return R_diag; }
+    /// @copydoc    get_R_diag
+    Vector &&get_R_diag() && { return std::move(R_diag); }
+
+    /// @}
+
+  private:
+    /// The actual QR factorization algorithm.
+    void compute_factorization();
+    /// Back substitution algorithm for solving the upper-triangular system
+    /// R₁₁X = B, where R₁₁ is the leading r×r block of R.
+    void back_subs(const Matrix &B, Matrix &X, size_t r) const;
+
+  private:
+    /// Result of a Householder QR factorization: stores the strict
+    /// upper-triangular part of matrix R and the full matrix of scaled
+    /// Householder reflection vectors W. The reflection vectors have norm √2.
+    Matrix RW;
+    /// Contains the diagonal elements of R.
+    Vector R_diag;
+    /// The column permutation that moves the columns with the largest norms
+    /// to the front.
+    PermutationMatrix P = PermutationMatrix::ColumnPermutation;
+    /// Column norms of the trailing submatrix, used during the factorization.
+    Vector norms;
+    /// Column norms at the time they were last computed explicitly.
+    Vector norms_ref;
+
+    enum State {
+        NotFactored = 0,
+        Factored    = 1,
+    } state = NotFactored;
+};
+
+/// Print the Q, R and P matrices of a PivotedHouseholderQR object.
+/// @related    PivotedHouseholderQR
+std::ostream &operator<<(std::ostream &os, const PivotedHouseholderQR &qr);
@@ -0,0 +1,111 @@
+#pragma once
+
+#include <cstddef> // size_t
+
+using std::size_t;
+
+/// @addtogroup Runtime
+/// @{
+
+/// @name   SIMD kernels
+/// @{
+
+/// Get the name of the instruction set used by the element-wise, reduction
+/// and matrix multiplication kernels: `"avx512"`, `"avx2"`, `"sse2"` or
+/// `"generic"`.
+///
+/// The kernel set is selected once, the first time a kernel is used: it is
+/// the most recent instruction set that the CPU supports, unless the
+/// `LINALG_SIMD` environment variable contains the name of another supported
+/// kernel set.
+const char *get_simd_kernel_set();
+
+/// Select the instruction set used by the kernels, see
+/// @ref get_simd_kernel_set for the available names.
+/// @return False if the name is unknown or if the instruction set is not
+///         supported by the CPU, in which case the active kernel set is left
+///         unchanged.
+bool set_simd_kernel_set(const char *name);
+
+/// @}
+
+/// @name   Multithreading
+/// @{
+
+/// Set the number of threads used by the parallel kernels, including the
+/// calling thread. Zero selects the number of hardware threads.
+///
+/// The library owns a persistent pool of worker threads. Initially, its size
+/// is given by the `LINALG_NUM_THREADS` environment variable, or by the number
+/// of hardware threads if that variable is not set.
+void set_num_threads(size_t num_threads);
+/// Get the number of threads used by the parallel kernels.
+size_t get_num_threads();
+
+/// Matrix products with fewer multiply-accumulate operations than the given
+/// number (m·n·k for the product of an m×k and a k×n matrix) are computed on a
+/// single thread.
+void set_parallel_gemm_threshold(size_t num_mac);
+/// @copydoc set_parallel_gemm_threshold
+size_t get_parallel_gemm_threshold();
+
+/// Matrix-vector products with fewer elements in the matrix than the given
+/// number are computed on a single thread. Larger products are split into
+/// blocks of rows that are computed in parallel.
+void set_parallel_gemv_threshold(size_t num_elem);
+/// @copydoc set_parallel_gemv_threshold
+size_t get_parallel_gemv_threshold();
+
+/// Row and column permutations of matrices with fewer elements than the given
+/// number are applied on a single thread. Larger matrices are split into
+/// chunks of columns (or rows) that are permuted in parallel.
+void set_parallel_permutation_threshold(size_t num_elem);
+/// @copydoc set_parallel_permutation_threshold
+size_t get_parallel_permutation_threshold();
+
+/// Matrices with fewer elements than the given number are transposed on a
+/// single thread. Larger matrices are split into blocks that are transposed
+/// in parallel.
+void set_parallel_transpose_threshold(size_t num_elem);
+/// @copydoc set_parallel_transpose_threshold
+size_t get_parallel_transpose_threshold();
+
+/// @}
+
+/// @name   Factorizations
+/// @{
+
+/// Set the number of columns per panel of the blocked @ref HouseholderQR
+/// factorization. Matrices with fewer than 8·nb columns are factored using
+/// the unblocked algorithm. The reflectors of @ref HouseholderQR and
+/// @ref PivotedHouseholderQR are applied in panels of nb as well, if there
+/// are at least nb right-hand sides. Zero disables blocking altogether.
+void set_qr_block_size(size_t nb);
+/// @copydoc set_qr_block_size
+size_t get_qr_block_size();
+
+/// Set the number of columns per panel of the blocked @ref RowPivotLU and
+/// @ref NoPivotLU factorizations. Matrices with fewer than 8·nb columns are
+/// factored using the unblocked algorithm. Zero disables blocking
+/// altogether.
+void set_lu_block_size(size_t nb);
+/// @copydoc set_lu_block_size
+size_t get_lu_block_size();
+
+/// Set the number of columns per panel of the blocked @ref Cholesky
+/// factorization. Matrices with fewer than 8·nb columns are factored using
+/// the unblocked algorithm. Zero disables blocking altogether.
+void set_cholesky_block_size(size_t nb);
+/// @copydoc set_cholesky_block_size
+size_t get_cholesky_block_size();
+
+/// Set the number of columns per panel of the blocked @ref LDLT
+/// factorization. Matrices with fewer than 8·nb columns are factored using
+/// the unblocked algorithm. Zero or one disables blocking altogether.
+void set_ldlt_block_size(size_t nb);
+/// @copydoc set_ldlt_block_size
+size_t get_ldlt_block_size();
+
+/// @}
+
+/// @}
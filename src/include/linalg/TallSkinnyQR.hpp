@@ -0,0 +1,159 @@
+#pragma once
+
+#include "HouseholderQR.hpp"
+#include "Matrix.hpp"
+
+#include <vector> // std::vector
+
+/**
+ * @brief   QR factorization of tall and skinny matrices (TSQR).
+ *
+ * Factorizes an m×n matrix with m >= n into an m×m unitary factor Q and an n×n
+ * upper triangular factor R, for matrices that have many more rows than
+ * columns, e.g. least squares problems with millions of observations of a
+ * handful of regressors.
+ *
+ * The rows are split into blocks, and each block is factored independently
+ * using a @ref HouseholderQR, in parallel. The resulting R factors are then
+ * combined pairwise in a binary tree: each pair of n×n factors is stacked and
+ * factored again, until a single R remains. Each block is small enough to stay
+ * in the cache while it is factored, whereas @ref HouseholderQR streams the
+ * entire matrix from memory once per column.
+ *
+ * The Q factor is kept implicitly, as the tree of Householder reflectors, so
+ * it can be applied using @ref apply_QT_inplace and @ref apply_Q_inplace,
+ * which process the blocks in parallel as well. QᵀA has R in its first n rows
+ * and zeros below, as for @ref HouseholderQR.
+ *
+ * @ingroup Factorizations
+ */
+class TallSkinnyQR {
+  public:
+    /// @name Constructors
+    /// @{
+
+    /// Default constructor.
+    TallSkinnyQR() = default;
+    /// Factorize the given matrix.
+    TallSkinnyQR(const Matrix &matrix) { compute(matrix); }
+
+    /// @}
+
+  public:
+    /// @name Factorization
+    /// @{
+
+    /// Perform the QR factorization of the given matrix.
+    void compute(const Matrix &matrix);
+
+    /// Set the number of rows of each block (the last block may be larger).
+    /// Zero (the default) selects a size based on the number of columns,
+    /// such that each block fits in the L2 cache.
+    void set_block_rows(size_t block_rows) { this->block_rows = block_rows; }
+    /// Get the number of rows of each block, see @ref set_block_rows.
+    size_t get_block_rows() const { return block_rows; }
+
+    /// @}
+
+  public:
+    /// @name   Retrieving the Q factor
+    /// @{
+
+    /// Compute the product QᵀB, overwriting B with the result.
+    void apply_QT_inplace(Matrix &B) const;
+    /// Compute the product QᵀB.
+    Matrix apply_QT(const Matrix &B) const;
+    /// Compute the product QᵀB.
+    Matrix &&apply_QT(Matrix &&B) const;
+
+    /// Compute the product QB, overwriting B with the result.
+    void apply_Q_inplace(Matrix &X) const;
+    /// Compute the product QB.
+    Matrix apply_Q(const Matrix &X) const;
+    /// Compute the product QB.
+    Matrix &&apply_Q(Matrix &&B) const;
+
+    /// @}
+
+  public:
+    /// @name   Retrieving the R factor
+    /// @{
+
+    /// Get the n×n upper-triangular matrix R. (Unlike @ref HouseholderQR,
+    /// the zero rows below R are not included.)
+    const SquareMatrix &get_R() const & { return R; }
+    /// @copydoc    get_R
+    SquareMatrix &&get_R() && { return std::move(R); }
+
+    /// @}
+
+  public:
+    /// @name   Solving systems of equations and least-squares problems
+    /// @{
+
+    /// Solve the system AX = B or QRX = B.
+    /// Matrix B is overwritten with the result X. If the matrix A is square,
+    /// no new allocations occur, and the storage of B is reused for X.
+    /// If A is not square, new storage will be allocated for X.
+    void solve_inplace(Matrix &B) const;
+    /// Solve the system AX = B or QRX = B.
+    Matrix solve(const Matrix &B) const;
+    /// Solve the system AX = B or QRX = B.
+    Matrix &&solve(Matrix &&B) const;
+    /// Solve the system Ax = b or QRx = b.
+    Vector solve(const Vector &B) const;
+    /// Solve the system Ax = b or QRx = b.
+    Vector &&solve(Vector &&B) const;
+
+    /// @}
+
+  public:
+    /// @name   Access to internal representation
+    /// @{
+
+    /// Check if this object contains a valid factorization.
+    bool is_factored() const { return state == Factored; }
+
+    /// Get the number of rows of the factored matrix.
+    size_t rows() const { return rows_; }
+    /// Get the number of columns of the factored matrix.
+    size_t cols() const { return R.cols(); }
+
+    /// @}
+
+  private:
+    /// Back substitution algorithm for solving upper-triangular systems RX = B.
+    void back_subs(const Matrix &B, Matrix &X) const;
+
+  private:
+    /// Factorization of the rows [`row`, `row` + `qr.get_RW().rows()`) of the
+    /// matrix.
+    struct Leaf {
+        size_t row;
+        HouseholderQR qr;
+    };
+    /// Factorization of the two stacked n×n R factors that are stored in the
+    /// rows [`top`, `top` + n) and [`bottom`, `bottom` + n).
+    struct Node {
+        size_t top, bottom;
+        HouseholderQR qr;
+    };
+
+    /// The factorizations of the blocks of rows.
+    std::vector<Leaf> leaves;
+    /// The nodes of the reduction tree, level by level, starting from the
+    /// level right above the leaves.
+    std::vector<Node> nodes;
+    /// The index of the first node of each level, followed by the total
+    /// number of nodes.
+    std::vector<size_t> levels;
+    /// The final R factor, at the root of the tree.
+    SquareMatrix R;
+    size_t rows_      = 0;
+    size_t block_rows = 0;
+
+    enum State {
+        NotFactored = 0,
+        Factored    = 1,
+    } state = NotFactored;
+};
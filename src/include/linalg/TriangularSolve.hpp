@@ -0,0 +1,55 @@
+#pragma once
+
+#include "MatrixView.hpp"
+
+template <class T>
+class Transposed;
+
+/// @addtogroup MatVecOp
+/// @{
+
+/// Side of the unknown matrix X on which the triangular matrix A is
+/// multiplied, see @ref triangular_solve.
+enum class Side {
+    Left,  ///< Solve A·X = B.
+    Right, ///< Solve X·A = B.
+};
+
+/// Which triangle of the matrix A contains the triangular matrix, see
+/// @ref triangular_solve.
+enum class Triangle {
+    Lower, ///< A is lower triangular, the elements above the diagonal are
+           ///< not accessed.
+    Upper, ///< A is upper triangular, the elements below the diagonal are
+           ///< not accessed.
+};
+
+/// Whether the diagonal of the triangular matrix A is stored, see
+/// @ref triangular_solve.
+enum class Diagonal {
+    NonUnit, ///< The diagonal elements of A are used.
+    Unit,    ///< The diagonal elements of A are implicitly one, and they are
+             ///< not accessed.
+};
+
+/// Solve the triangular system A·X = B or X·A = B, for many right-hand sides
+/// at once. B is overwritten with the solution X.
+///
+/// A is a square matrix, of which only the given triangle is used. Transposed
+/// triangular matrices can be passed as views with swapped strides (the
+/// transpose of a lower-triangular matrix is upper triangular).
+///
+/// The diagonal blocks are solved using substitution, the off-diagonal blocks
+/// are applied to the remaining right-hand sides using matrix-matrix products.
+void triangular_solve(Side side, Triangle triangle, Diagonal diagonal,
+                      const ConstMatrixView &A, MatrixView B);
+
+/// Solve the triangular system Aᵀ·X = B or X·Aᵀ = B, where `A` is a lazy
+/// transpose (e.g. `transpose(L)`), without evaluating the transpose.
+template <class T>
+void triangular_solve(Side side, Triangle triangle, Diagonal diagonal,
+                      const Transposed<T> &A, MatrixView B) {
+    triangular_solve(side, triangle, diagonal, A.view(), B);
+}
+
+/// @}
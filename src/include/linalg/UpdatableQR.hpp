@@ -0,0 +1,141 @@
+#pragma once
+
+#include "HouseholderQR.hpp"
+#include "Matrix.hpp"
+
+/**
+ * @brief   QR factorization that can be updated when rows or columns of the
+ *          matrix are added or removed.
+ *
+ * Stores the thin factorization A = QR of an m×n matrix with m >= n, where Q
+ * is an m×n matrix with orthonormal columns and R is an n×n upper-triangular
+ * matrix. Unlike @ref HouseholderQR, Q is stored explicitly, which allows the
+ * factorization to be updated using Givens rotations after inserting or
+ * deleting a row or a column of A, or after a rank-one update A + uvᵀ. Each
+ * update costs O(mn) operations, instead of O(mn²) for computing a new
+ * factorization from scratch.
+ *
+ * A typical use case is a sliding-window least-squares problem, where a new
+ * observation is inserted and the oldest one is deleted at every time step.
+ *
+ * Rounding errors accumulate over many updates, so it may be necessary to
+ * compute a new factorization from scratch every once in a while.
+ *
+ * @ingroup Factorizations
+ */
+class UpdatableQR {
+  public:
+    /// @name Constructors
+    /// @{
+
+    /// Default constructor.
+    UpdatableQR() = default;
+    /// Factorize the given matrix.
+    UpdatableQR(const Matrix &matrix) { compute(matrix); }
+    /// Copy the factors of an existing Householder QR factorization.
+    UpdatableQR(const HouseholderQR &qr) { compute(qr); }
+
+    /// @}
+
+  public:
+    /// @name Factorization
+    /// @{
+
+    /// Perform the QR factorization of the given matrix.
+    void compute(const Matrix &matrix);
+    /// Copy the factors of an existing Householder QR factorization.
+    void compute(const HouseholderQR &qr);
+
+    /// @}
+
+  public:
+    /// @name   Updating the factorization
+    /// @{
+
+    /// Update the factorization after inserting the given row before row `i`
+    /// of the matrix.
+    void insert_row(size_t i, const RowVector &row);
+    /// Update the factorization after deleting row `i` of the matrix.
+    /// @pre    `rows() > cols()`
+    void delete_row(size_t i);
+    /// Update the factorization after inserting the given column before
+    /// column `j` of the matrix.
+    /// @pre    `rows() > cols()`
+    void insert_column(size_t j, const Vector &column);
+    /// Update the factorization after deleting column `j` of the matrix.
+    void delete_column(size_t j);
+    /// Update the factorization of A to a factorization of A + uvᵀ.
+    void rank_one_update(const Vector &u, const Vector &v);
+
+    /// @}
+
+  public:
+    /// @name   Retrieving the factors
+    /// @{
+
+    /// Get the m×n matrix Q with orthonormal columns.
+    const Matrix &get_Q() const & { return Q; }
+    /// @copydoc    get_Q
+    Matrix &&get_Q() && { return std::move(Q); }
+    /// Get the n×n upper-triangular matrix R.
+    const Matrix &get_R() const & { return R; }
+    /// @copydoc    get_R
+    Matrix &&get_R() && { return std::move(R); }
+
+    /// Compute the n×k product QᵀB.
+    Matrix apply_QT(const Matrix &B) const;
+
+    /// @}
+
+  public:
+    /// @name   Solving systems of equations and least-squares problems
+    /// @{
+
+    /// Solve the system AX = B or QRX = B.
+    /// Matrix B is overwritten with the result X. New storage is always
+    /// allocated for X.
+    void solve_inplace(Matrix &B) const;
+    /// Solve the system AX = B or QRX = B.
+    Matrix solve(const Matrix &B) const;
+    /// Solve the system AX = B or QRX = B.
+    Matrix &&solve(Matrix &&B) const;
+    /// Solve the system Ax = b or QRx = b.
+    Vector solve(const Vector &B) const;
+    /// Solve the system Ax = b or QRx = b.
+    Vector &&solve(Vector &&B) const;
+
+    /// @}
+
+  public:
+    /// @name   Access to internal representation
+    /// @{
+
+    /// Check if this object contains a valid factorization.
+    bool is_factored() const { return state == Factored; }
+
+    /// Get the number of rows of the factored matrix.
+    size_t rows() const { return Q.rows(); }
+    /// Get the number of columns of the factored matrix.
+    size_t cols() const { return R.cols(); }
+
+    /// @}
+
+  private:
+    /// Back substitution algorithm for solving upper-triangular systems RX = B.
+    void back_subs(const Matrix &B, Matrix &X) const;
+
+  private:
+    /// The m×n matrix with orthonormal columns.
+    Matrix Q;
+    /// The n×n upper-triangular matrix.
+    Matrix R;
+
+    enum State {
+        NotFactored = 0,
+        Factored    = 1,
+    } state = NotFactored;
+};
+
+/// Print the Q and R matrices of an UpdatableQR object.
+/// @related    UpdatableQR
+std::ostream &operator<<(std::ostream &os, const UpdatableQR &qr);
@@ -0,0 +1,433 @@
+#pragma once
+
+#include <cassert>     // assert
+#include <cmath>       // std::sqrt
+#include <cstddef>     // size_t
+#include <type_traits> // std::conditional, std::enable_if, std::is_base_of,
+                       // std::is_same
+
+using std::size_t;
+
+class Matrix;
+class Vector;
+class RowVector;
+class ConstMatrixView;
+
+namespace util {
+
+/**
+ * @brief   Lazily evaluated element-wise matrix expressions.
+ *
+ * Element-wise operations on matrices (addition, subtraction, negation, and
+ * multiplication and division by a scalar) don't compute their result right
+ * away. They return a small expression object that refers to its operands
+ * instead. When the expression is assigned to (or converted to) a matrix, all
+ * operations are evaluated in a single loop over the elements, without any
+ * temporary matrices in between. For example, `A + B - 2 * C` reads the
+ * elements of the three matrices once, and writes the elements of the result
+ * once.
+ *
+ * Matrix views (@ref ConstMatrixView) can be used as operands as well, they
+ * are always evaluated lazily.
+ *
+ * @warning Expressions refer to the matrices they were created from, so they
+ *          must not outlive them. Don't store expressions using `auto`,
+ *          assign them to a matrix instead.
+ */
+namespace expr {
+
+/// Base class of all expressions, used to detect them.
+struct ExpressionBase {};
+
+template <class T>
+using decay_t = typename std::decay<T>::type;
+
+/// Check whether T is an expression.
+template <class T>
+struct is_expression : std::is_base_of<ExpressionBase, T> {};
+
+/// Check whether T is a matrix or vector.
+template <class T>
+struct is_matrix : std::is_base_of<Matrix, T> {};
+
+/// Check whether T is a column or row vector.
+template <class T>
+struct is_vector
+    : std::integral_constant<bool, std::is_same<T, Vector>::value ||
+                                       std::is_same<T, RowVector>::value> {};
+
+/// Check whether T is a view of a matrix.
+template <class T>
+struct is_view : std::is_base_of<ConstMatrixView, T> {};
+
+/// Check whether T is always evaluated lazily: expressions and views.
+template <class T>
+struct is_lazy_operand
+    : std::integral_constant<bool,
+                             is_expression<T>::value || is_view<T>::value> {};
+
+/// Check whether T can be an operand of an expression.
+template <class T>
+struct is_operand
+    : std::integral_constant<bool, is_lazy_operand<T>::value ||
+                                       is_matrix<T>::value> {};
+
+/// Check whether L and R can be the operands of an expression: at least one
+/// of them has to be an expression or a view, the other one can be any
+/// operand.
+template <class L, class R>
+struct are_operands
+    : std::integral_constant<
+          bool, (is_lazy_operand<L>::value && is_operand<R>::value) ||
+                    (is_operand<L>::value && is_lazy_operand<R>::value)> {};
+
+/// Check whether the forwarding reference type T binds to an rvalue matrix,
+/// whose storage can be reused for the result.
+template <class T>
+struct is_matrix_rvalue
+    : std::integral_constant<bool, is_matrix<decay_t<T>>::value &&
+                                       !std::is_lvalue_reference<T>::value> {};
+
+/// Check whether an operation on L and R results in a new expression, i.e.
+/// when neither of the operands is an rvalue matrix.
+template <class L, class R>
+struct is_lazy
+    : std::integral_constant<
+          bool, are_operands<decay_t<L>, decay_t<R>>::value &&
+                    !is_matrix_rvalue<L>::value &&
+                    !is_matrix_rvalue<R>::value> {};
+
+/// Check whether an operation on L and R is evaluated into the storage of the
+/// left operand, an rvalue matrix.
+template <class L, class R>
+struct is_into_lhs
+    : std::integral_constant<bool, is_matrix_rvalue<L>::value &&
+                                       is_lazy_operand<decay_t<R>>::value> {};
+
+/// Check whether an operation on L and R is evaluated into the storage of the
+/// right operand, an rvalue matrix.
+template <class L, class R>
+struct is_into_rhs
+    : std::integral_constant<bool, is_lazy_operand<decay_t<L>>::value &&
+                                       is_matrix_rvalue<R>::value> {};
+
+/// Type of the result of combining the results of two operands: if both have
+/// the same type, the result has that type as well, otherwise, it's a general
+/// matrix. E.g. the sum of two vectors is a vector, but the sum of a vector
+/// and a matrix is a matrix.
+template <class L, class R>
+using common_result_t =
+    typename std::conditional<std::is_same<L, R>::value, L, Matrix>::type;
+
+template <class Result, class E>
+Result evaluate_as(const E &expression);
+template <class E>
+double normFro(const E &expression);
+
+/// Common interface of all expressions.
+/// @tparam Derived
+///         The type of the expression itself (CRTP).
+/// @tparam Result
+///         The type of matrix that the expression evaluates to.
+template <class Derived, class Result>
+class Expression : public ExpressionBase {
+  public:
+    using result_type = Result;
+
+    /// Get the number of elements of the result.
+    size_t num_elems() const { return derived().rows() * derived().cols(); }
+
+    /// Evaluate the expression.
+    operator result_type() const {
+        return evaluate_as<result_type>(derived());
+    }
+    /// Evaluate the expression.
+    result_type eval() const { return *this; }
+
+    /// Compute the Frobenius norm of the result, without storing it.
+    double normFro() const { return expr::normFro(derived()); }
+    /// Compute the 2-norm of the result of a vector expression, without
+    /// storing it. For vectors, it's the same as the Frobenius norm.
+    template <class R = Result>
+    typename std::enable_if<is_vector<R>::value, double>::type norm2() const {
+        return normFro();
+    }
+
+  private:
+    const Derived &derived() const {
+        return static_cast<const Derived &>(*this);
+    }
+};
+
+/// Check whether a matrix with the given strides is stored in consecutive
+/// memory locations. The stride of a dimension with only one element is
+/// irrelevant.
+inline bool is_dense(size_t rows, size_t cols, size_t rs, size_t cs) {
+    bool col_major = (rows <= 1 || rs == 1) && (cols <= 1 || cs == rows);
+    bool row_major = (cols <= 1 || cs == 1) && (rows <= 1 || rs == cols);
+    return col_major || row_major;
+}
+
+/// Reference to the elements of a matrix or a view that's used as an operand
+/// of an expression.
+/// @tparam T
+///         The type of matrix that the operand evaluates to.
+template <class T>
+class Ref {
+  public:
+    using result_type = T;
+
+    template <class M>
+    Ref(const M &matrix)
+        : data_(matrix.data()), rows_(matrix.rows()), cols_(matrix.cols()),
+          rs(matrix.row_stride()), cs(matrix.col_stride()) {}
+
+    size_t rows() const { return rows_; }
+    size_t cols() const { return cols_; }
+    size_t num_elems() const { return rows_ * cols_; }
+    double operator()(size_t row, size_t col) const {
+        return data_[row * rs + col * cs];
+    }
+    /// Linear access, only valid if @ref has_strides is true for a dense
+    /// layout.
+    double operator()(size_t index) const { return data_[index]; }
+    const double *data() const { return data_; }
+
+    /// Check whether the elements are stored with the given strides.
+    bool has_strides(size_t row_stride, size_t col_stride) const {
+        return (rows_ <= 1 || rs == row_stride) &&
+               (cols_ <= 1 || cs == col_stride);
+    }
+
+  private:
+    const double *data_;
+    size_t rows_, cols_;
+    size_t rs, cs;
+};
+
+/// Expressions are stored by value, matrices and views by reference.
+template <class T>
+using operand_t = typename std::conditional<
+    is_expression<decay_t<T>>::value, decay_t<T>,
+    Ref<typename std::conditional<is_view<decay_t<T>>::value, Matrix,
+                                  decay_t<T>>::type>>::type;
+
+/// Type of the result of an operand.
+template <class T>
+using result_t = typename operand_t<T>::result_type;
+
+/// @name   Operations
+/// @{
+
+struct Plus {
+    static double apply(double a, double b) { return a + b; }
+};
+struct Minus {
+    static double apply(double a, double b) { return a - b; }
+};
+struct Times {
+    static double apply(double a, double s) { return a * s; }
+};
+struct Divides {
+    static double apply(double a, double s) { return a / s; }
+};
+
+/// @}
+
+/// Element-wise operation on two matrices of the same size.
+template <class Op, class L, class R>
+class Binary
+    : public Expression<Binary<Op, L, R>,
+                        common_result_t<typename L::result_type,
+                                        typename R::result_type>> {
+  public:
+    Binary(const L &lhs, const R &rhs) : lhs_(lhs), rhs_(rhs) {
+        assert(lhs.rows() == rhs.rows());
+        assert(lhs.cols() == rhs.cols());
+    }
+
+    size_t rows() const { return lhs_.rows(); }
+    size_t cols() const { return lhs_.cols(); }
+    double operator()(size_t row, size_t col) const {
+        return Op::apply(lhs_(row, col), rhs_(row, col));
+    }
+    double operator()(size_t index) const {
+        return Op::apply(lhs_(index), rhs_(index));
+    }
+    bool has_strides(size_t rs, size_t cs) const {
+        return lhs_.has_strides(rs, cs) && rhs_.has_strides(rs, cs);
+    }
+
+    const L &lhs() const { return lhs_; }
+    const R &rhs() const { return rhs_; }
+
+  private:
+    L lhs_;
+    R rhs_;
+};
+
+/// Operation on the elements of a matrix and a scalar.
+template <class Op, class E>
+class Scalar : public Expression<Scalar<Op, E>, typename E::result_type> {
+  public:
+    Scalar(const E &operand, double scalar)
+        : operand_(operand), scalar_(scalar) {}
+
+    size_t rows() const { return operand_.rows(); }
+    size_t cols() const { return operand_.cols(); }
+    double operator()(size_t row, size_t col) const {
+        return Op::apply(operand_(row, col), scalar_);
+    }
+    double operator()(size_t index) const {
+        return Op::apply(operand_(index), scalar_);
+    }
+    bool has_strides(size_t rs, size_t cs) const {
+        return operand_.has_strides(rs, cs);
+    }
+
+    const E &operand() const { return operand_; }
+    double scalar() const { return scalar_; }
+
+  private:
+    E operand_;
+    double scalar_;
+};
+
+/// Negation of the elements of a matrix.
+template <class E>
+class Negation : public Expression<Negation<E>, typename E::result_type> {
+  public:
+    Negation(const E &operand) : operand_(operand) {}
+
+    size_t rows() const { return operand_.rows(); }
+    size_t cols() const { return operand_.cols(); }
+    double operator()(size_t row, size_t col) const {
+        return -operand_(row, col);
+    }
+    double operator()(size_t index) const { return -operand_(index); }
+    bool has_strides(size_t rs, size_t cs) const {
+        return operand_.has_strides(rs, cs);
+    }
+
+    const E &operand() const { return operand_; }
+
+  private:
+    E operand_;
+};
+
+/// @name   Expression types of the operators
+/// @{
+
+template <class L, class R>
+using Sum = Binary<Plus, operand_t<L>, operand_t<R>>;
+template <class L, class R>
+using Difference = Binary<Minus, operand_t<L>, operand_t<R>>;
+template <class E>
+using Product = Scalar<Times, operand_t<E>>;
+template <class E>
+using Quotient = Scalar<Divides, operand_t<E>>;
+template <class E>
+using Negated = Negation<operand_t<E>>;
+
+/// Type of an rvalue matrix that holds the result of an operation on L and R
+/// that was evaluated in place.
+template <class L, class R>
+using rvalue_result_t = common_result_t<result_t<L>, result_t<R>> &&;
+
+/// @}
+
+/// @name   SIMD kernels for expressions with a single operation
+/// These simple expressions are evaluated by the runtime-dispatched SIMD
+/// kernels, longer expressions are fused into a single loop.
+/// @{
+
+void add(size_t n, const double *a, const double *b, double *c);
+void sub(size_t n, const double *a, const double *b, double *c);
+void neg(size_t n, const double *a, double *c);
+void mul_scalar(size_t n, const double *a, double s, double *c);
+void div_scalar(size_t n, const double *a, double s, double *c);
+
+/// @}
+
+/// Evaluate an expression whose operands have the same dense layout as the
+/// destination, so all elements can be accessed using a single index.
+template <class E>
+void evaluate_linear(const E &expression, double *out) {
+    const size_t n = expression.num_elems();
+    for (size_t i = 0; i < n; ++i)
+        out[i] = expression(i);
+}
+
+template <class L, class R>
+void evaluate_linear(const Binary<Plus, Ref<L>, Ref<R>> &e, double *out) {
+    add(e.num_elems(), e.lhs().data(), e.rhs().data(), out);
+}
+template <class L, class R>
+void evaluate_linear(const Binary<Minus, Ref<L>, Ref<R>> &e, double *out) {
+    sub(e.num_elems(), e.lhs().data(), e.rhs().data(), out);
+}
+template <class T>
+void evaluate_linear(const Negation<Ref<T>> &e, double *out) {
+    neg(e.num_elems(), e.operand().data(), out);
+}
+template <class T>
+void evaluate_linear(const Scalar<Times, Ref<T>> &e, double *out) {
+    mul_scalar(e.num_elems(), e.operand().data(), e.scalar(), out);
+}
+template <class T>
+void evaluate_linear(const Scalar<Divides, Ref<T>> &e, double *out) {
+    div_scalar(e.num_elems(), e.operand().data(), e.scalar(), out);
+}
+
+/// Evaluate an expression element by element, in the order that matches the
+/// strides of the destination.
+template <class E>
+void evaluate_strided(const E &e, double *out, size_t rs, size_t cs) {
+    if (rs <= cs) {
+        for (size_t c = 0; c < e.cols(); ++c)
+            for (size_t r = 0; r < e.rows(); ++r)
+                out[r * rs + c * cs] = e(r, c);
+    } else {
+        for (size_t r = 0; r < e.rows(); ++r)
+            for (size_t c = 0; c < e.cols(); ++c)
+                out[r * rs + c * cs] = e(r, c);
+    }
+}
+
+/// Evaluate the expression, and write the element (r, c) of the result to
+/// `out[r * rs + c * cs]`.
+/// The destination may be the storage of one of the operands, because every
+/// element of the result only depends on the elements of the operands at the
+/// same position. Other kinds of overlap are not allowed.
+template <class E>
+void evaluate(const E &expression, double *out, size_t rs, size_t cs) {
+    if (is_dense(expression.rows(), expression.cols(), rs, cs) &&
+        expression.has_strides(rs, cs))
+        evaluate_linear(expression, out);
+    else
+        evaluate_strided(expression, out, rs, cs);
+}
+
+/// Evaluate the expression into a new matrix of the given type.
+template <class Result, class E>
+Result evaluate_as(const E &expression) {
+    Result result;
+    result = expression;
+    return result;
+}
+
+/// Compute the Frobenius norm of the result of the expression.
+template <class E>
+double normFro(const E &expression) {
+    double sum = 0;
+    for (size_t c = 0; c < expression.cols(); ++c)
+        for (size_t r = 0; r < expression.rows(); ++r) {
+            double x = expression(r, c);
+            sum += x * x;
+        }
+    return std::sqrt(sum);
+}
+
+} // namespace expr
+
+} // namespace util
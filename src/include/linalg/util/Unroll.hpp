@@ -0,0 +1,43 @@
+#pragma once
+
+#include <cstddef> // size_t
+
+namespace util {
+
+/// Call `f(Offset)`, `f(Offset + 1)`, ..., `f(Offset + N - 1)`. The loop is
+/// unrolled at compile time, so after inlining, each call sees a constant
+/// index. The range is split in halves, so the template recursion is only
+/// log₂(N) deep, and long loops don't run into the compiler's instantiation
+/// depth limit.
+template <std::size_t Offset, std::size_t N>
+struct Unroll {
+    template <class F>
+    static void apply(F &&f) {
+        Unroll<Offset, N / 2>::apply(f);
+        Unroll<Offset + N / 2, N - N / 2>::apply(f);
+    }
+};
+
+/// @copydoc Unroll
+template <std::size_t Offset>
+struct Unroll<Offset, 1> {
+    template <class F>
+    static void apply(F &&f) {
+        f(Offset);
+    }
+};
+
+/// @copydoc Unroll
+template <std::size_t Offset>
+struct Unroll<Offset, 0> {
+    template <class F>
+    static void apply(F &&) {}
+};
+
+/// Call `f(i)` for all i in [0, N), unrolled at compile time.
+template <std::size_t N, class F>
+inline void unroll(F &&f) {
+    Unroll<0, N>::apply(f);
+}
+
+} // namespace util
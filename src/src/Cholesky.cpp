@@ -0,0 +1,274 @@
+#include <linalg/Cholesky.hpp>
+#include <linalg/Runtime.hpp>
+
+#include "kernels/Gemm.hpp"
+#include "kernels/Trsm.hpp"
+
+#include <algorithm> // std::min
+#include <atomic>    // std::atomic
+#include <cassert>
+#include <cmath> // std::sqrt, std::hypot
+
+namespace {
+
+/// Number of columns per panel of the blocked factorization, see
+/// @ref set_cholesky_block_size.
+std::atomic<size_t> cholesky_block_size{32};
+
+} // namespace
+
+void set_cholesky_block_size(size_t nb) {
+    cholesky_block_size.store(nb, std::memory_order_relaxed);
+}
+
+size_t get_cholesky_block_size() {
+    return cholesky_block_size.load(std::memory_order_relaxed);
+}
+
+/**
+ * @pre     The lower-triangular part of `LLT` contains the lower-triangular
+ *          part of the symmetric matrix A to be factorized
+ * @pre     `LLT.rows() == LLT.cols()`
+ *
+ * @post    The lower-triangular part of `LLT` contains the matrix L, the
+ *          upper-triangular part is unspecified.
+ * @post    `get_L() * transpose(get_L()) == A`
+ *          (up to rounding errors)
+ *
+ * ## Implementation
+ * @snippet this Cholesky::compute_factorization
+ */
+//! <!-- [Cholesky::compute_factorization] -->
+void Cholesky::compute_factorization() {
+    assert(LLT.rows() == LLT.cols());
+    state = NotFactored;
+
+    // For large matrices, the columns are processed in panels of nb columns
+    // (right-looking blocked Cholesky). Each panel is factored using the
+    // unblocked algorithm, but the updates are only applied to the columns of
+    // the panel itself. The rest of the matrix is then updated using
+    // matrix-matrix products, see update_trailing_matrix.
+    size_t nb = get_cholesky_block_size();
+    if (nb == 0 || LLT.cols() < 8 * nb) {
+        if (!compute_panel_factorization(0, LLT.cols()))
+            return;
+    } else {
+        for (size_t k = 0; k < LLT.cols(); k += nb) {
+            size_t b = std::min(nb, LLT.cols() - k);
+            if (!compute_panel_factorization(k, b))
+                return;
+            if (k + b < LLT.cols())
+                update_trailing_matrix(k, b, nb);
+        }
+    }
+    state = Factored;
+}
+//! <!-- [Cholesky::compute_factorization] -->
+
+/**
+ * @pre     Columns 0 through `k - 1` have been factored, and the remaining
+ *          columns have been updated accordingly.
+ * @post    Columns `k` through `k + b - 1` are factored, columns `k + b`
+ *          and up have not been updated.
+ *
+ * ## Implementation
+ * @snippet this Cholesky::compute_panel_factorization
+ */
+//! <!-- [Cholesky::compute_panel_factorization] -->
+bool Cholesky::compute_panel_factorization(size_t k_begin, size_t b) {
+    // Partition the active part of the matrix as
+    //
+    //     ┌          ┐   ┌        ┐┌          ┐
+    //     │ a₁₁  a₂₁ᵀ│ = │ l₁₁  0 ││ l₁₁ l₂₁ᵀ │
+    //     │ a₂₁  A₂₂ │   │ l₂₁  I ││ 0   A₂₂' │
+    //     └          ┘   └        ┘└          ┘
+    //
+    // where a₁₁ is a scalar. Then
+    //
+    //     a₁₁ = l₁₁²              ⟺ l₁₁  = √a₁₁
+    //     a₂₁ = l₂₁·l₁₁           ⟺ l₂₁  = a₂₁ / l₁₁
+    //     A₂₂ = l₂₁·l₂₁ᵀ + A₂₂'   ⟺ A₂₂' = A₂₂ - l₂₁·l₂₁ᵀ
+    //
+    // and the algorithm continues with the trailing matrix A₂₂'. It is
+    // symmetric, so only its lower-triangular part is updated.
+    // If a₁₁ is not positive, the matrix is not positive definite.
+    const size_t n = LLT.rows(), k_end = k_begin + b;
+    const size_t rs = LLT.row_stride();
+    for (size_t k = k_begin; k < k_end; ++k) {
+        double a_kk = LLT(k, k);
+        if (!(a_kk > 0)) // also catches NaN
+            return false;
+        double l_kk = std::sqrt(a_kk);
+        LLT(k, k)   = l_kk;
+        // l₂₁ = a₂₁ / l₁₁
+        double *l_k = &LLT(k, k);
+        for (size_t i = 1; i < n - k; ++i)
+            l_k[i * rs] /= l_kk;
+        // A₂₂' = A₂₂ - l₂₁·l₂₁ᵀ, only the columns of the current panel, the
+        // columns to the right of it are updated all at once by
+        // update_trailing_matrix.
+        for (size_t c = k + 1; c < k_end; ++c) {
+            double *a_c = &LLT(c, c), l_ck = LLT(c, k);
+            const double *l_ik = &LLT(c, k);
+            for (size_t i = 0; i < n - c; ++i)
+                a_c[i * rs] -= l_ik[i * rs] * l_ck;
+        }
+    }
+    return true;
+}
+//! <!-- [Cholesky::compute_panel_factorization] -->
+
+/**
+ * @pre     Columns `k` through `k + b - 1` have just been factored by
+ *          @ref compute_panel_factorization.
+ * @post    The lower-triangular part of the trailing submatrix
+ *          A(k+b:n,k+b:n) has been updated.
+ *
+ * ## Implementation
+ * @snippet this Cholesky::update_trailing_matrix
+ */
+//! <!-- [Cholesky::update_trailing_matrix] -->
+void Cholesky::update_trailing_matrix(size_t k, size_t b, size_t nb) {
+    // Partition the active part of the matrix as
+    //     ┌         ┐   ┌         ┐┌           ┐
+    //     │ A₁₁     │ = │ L₁₁     ││ L₁₁ᵀ L₂₁ᵀ │
+    //     │ A₂₁ A₂₂ │   │ L₂₁ I   ││      A₂₂' │
+    //     └         ┘   └         ┘└           ┘
+    // where A₁₁ is b×b. The panel factorization computed L₁₁ and L₂₁, so
+    // what's left is the update
+    //     A₂₂' = A₂₂ - L₂₁·L₂₁ᵀ
+    // A₂₂' is symmetric, so only its lower-triangular part is needed. It is
+    // computed in blocks of nb columns, each block is a single matrix-matrix
+    // product (which also computes the upper-triangular part of the diagonal
+    // nb×nb blocks, but that part is never read).
+    const size_t n = LLT.cols() - k - b;
+    const size_t rs = LLT.row_stride(), cs = LLT.col_stride();
+    for (size_t j = 0; j < n; j += nb) {
+        size_t jb = std::min(nb, n - j);
+        // L₂₁(j:n,:) and its transpose L₂₁(j:j+jb,:)ᵀ
+        const double *L21 = &LLT(k + b + j, k);
+        double *A22       = &LLT(k + b + j, k + b + j);
+        kernels::gemm(n - j, jb, b,      //
+                      -1, L21, rs, cs, //
+                      L21, cs, rs,     //
+                      1, A22, rs, cs);
+    }
+}
+//! <!-- [Cholesky::update_trailing_matrix] -->
+
+/**
+ * ## Implementation
+ * @snippet this Cholesky::rank_one_update
+ */
+//! <!-- [Cholesky::rank_one_update] -->
+void Cholesky::rank_one_update(const Vector &x) {
+    assert(is_factored());
+    assert(x.size() == LLT.rows());
+    // Process one column at a time: a Givens rotation combines the k-th
+    // column of L with the vector x, such that the k-th element of x becomes
+    // zero. The rotation is then applied to the rest of the column and of x.
+    // Since the rotation is orthogonal, the product LLᵀ + xxᵀ is preserved.
+    const size_t n = LLT.rows(), rs = LLT.row_stride();
+    Vector w = x;
+    for (size_t k = 0; k < n; ++k) {
+        double l_kk = LLT(k, k);
+        double r    = std::hypot(l_kk, w(k));
+        double c = r / l_kk, s = w(k) / l_kk;
+        LLT(k, k) = r;
+        double *l_k = &LLT(k, k);
+        for (size_t i = 1; i < n - k; ++i) {
+            l_k[i * rs] = (l_k[i * rs] + s * w(k + i)) / c;
+            w(k + i)    = c * w(k + i) - s * l_k[i * rs];
+        }
+    }
+}
+//! <!-- [Cholesky::rank_one_update] -->
+
+/**
+ * ## Implementation
+ * @snippet this Cholesky::rank_one_downdate
+ */
+//! <!-- [Cholesky::rank_one_downdate] -->
+bool Cholesky::rank_one_downdate(const Vector &x) {
+    assert(is_factored());
+    assert(x.size() == LLT.rows());
+    // Same as rank_one_update, but using hyperbolic rotations, which
+    // preserve the difference LLᵀ - xxᵀ. The new diagonal element is
+    // √(lₖₖ² - xₖ²), if that's not real and positive, the downdated matrix is
+    // not positive definite.
+    const size_t n = LLT.rows(), rs = LLT.row_stride();
+    Vector w = x;
+    for (size_t k = 0; k < n; ++k) {
+        double l_kk = LLT(k, k);
+        double r_sq = (l_kk - w(k)) * (l_kk + w(k));
+        if (!(r_sq > 0)) {
+            state = NotFactored;
+            return false;
+        }
+        double r = std::sqrt(r_sq);
+        double c = r / l_kk, s = w(k) / l_kk;
+        LLT(k, k) = r;
+        double *l_k = &LLT(k, k);
+        for (size_t i = 1; i < n - k; ++i) {
+            l_k[i * rs] = (l_k[i * rs] - s * w(k + i)) / c;
+            w(k + i)    = c * w(k + i) - s * l_k[i * rs];
+        }
+    }
+    return true;
+}
+//! <!-- [Cholesky::rank_one_downdate] -->
+
+/**
+ * ## Implementation
+ * @snippet this Cholesky::forward_subs
+ */
+//! <!-- [Cholesky::forward_subs] -->
+void Cholesky::forward_subs(Matrix &B) const {
+    // Solve lower triangular system LX = B by solving each column of B as a
+    // vector system Lxᵢ = bᵢ, see NoPivotLU::forward_subs. All columns are
+    // solved at once by the blocked triangular solve kernel.
+    kernels::trsm(Side::Left, Triangle::Lower, Diagonal::NonUnit,   //
+                  LLT.rows(), B.cols(),                             //
+                  LLT.data(), LLT.row_stride(), LLT.col_stride(),   //
+                  B.data(), B.row_stride(), B.col_stride());
+}
+//! <!-- [Cholesky::forward_subs] -->
+
+/**
+ * ## Implementation
+ * @snippet this Cholesky::back_subs
+ */
+//! <!-- [Cholesky::back_subs] -->
+void Cholesky::back_subs(Matrix &B) const {
+    // Solve upper triangular system LᵀX = B by solving each column of B as a
+    // vector system Lᵀxᵢ = bᵢ, see NoPivotLU::back_subs. Lᵀ is passed to the
+    // triangular solve kernel as L with its strides swapped.
+    kernels::trsm(Side::Left, Triangle::Upper, Diagonal::NonUnit,   //
+                  LLT.rows(), B.cols(),                             //
+                  LLT.data(), LLT.col_stride(), LLT.row_stride(),   //
+                  B.data(), B.row_stride(), B.col_stride());
+}
+//! <!-- [Cholesky::back_subs] -->
+
+/**
+ * ## Implementation
+ * @snippet this Cholesky::solve_inplace
+ */
+//! <!-- [Cholesky::solve_inplace] -->
+void Cholesky::solve_inplace(Matrix &B) const {
+    // Solve the system AX = B, or LLᵀX = B.
+    //
+    // Let LᵀX = Z, and first solve LZ = B, which is a simple lower-triangular
+    // system of equations.
+    // Now that Z is known, solve LᵀX = Z, which is a simple upper-triangular
+    // system of equations.
+    assert(is_factored());
+    assert(B.rows() == LLT.rows());
+
+    forward_subs(B); // overwrite B with Z
+    back_subs(B);    // overwrite B (Z) with X
+}
+//! <!-- [Cholesky::solve_inplace] -->
+
+// All implementations of the less interesting functions can be found here:
+#include "boilerplate/Cholesky.ipp"
@@ -1,7 +1,29 @@
 #include <linalg/HouseholderQR.hpp>
+#include <linalg/Runtime.hpp>
 
+#include "kernels/Householder.hpp"
+#include "kernels/Trsm.hpp"
+
+#include <algorithm> // std::min
+#include <atomic>    // std::atomic
 #include <cassert>
 
+namespace {
+
+/// Number of columns per panel of the blocked factorization, see
+/// @ref set_qr_block_size.
+std::atomic<size_t> qr_block_size{16};
+
+} // namespace
+
+void set_qr_block_size(size_t nb) {
+    qr_block_size.store(nb, std::memory_order_relaxed);
+}
+
+size_t get_qr_block_size() {
+    return qr_block_size.load(std::memory_order_relaxed);
+}
+
 /**
  * @pre     `RW` contains the matrix A to be factorized
  * @pre     `RW.rows() >= RW.cols()`
@@ -31,10 +53,54 @@ void HouseholderQR::compute_factorization() {
     assert(RW.rows() >= RW.cols());
     assert(R_diag.size() == RW.cols());
 
+    // The matrix is split into panels of nb columns. Each panel is factored
+    // using the unblocked algorithm, and the product of its reflectors is then
+    // applied to all columns to the right of the panel at once, using
+    // matrix-matrix products. The result is exactly the same as for the
+    // unblocked algorithm (up to rounding errors), but most of the work is
+    // done by the cache-friendly matrix multiplication kernel.
+    // Small matrices fit in the cache anyway, and there the unblocked
+    // algorithm is faster, because it does less work in total.
+    size_t nb = get_qr_block_size();
+    if (nb == 0 || RW.cols() < 8 * nb) {
+        compute_panel_factorization(0, RW.cols());
+    } else {
+        Matrix V(RW.rows(), nb), T(nb, nb), W(nb, RW.cols() - nb);
+        for (size_t k = 0; k < RW.cols(); k += nb) {
+            size_t b = std::min(nb, RW.cols() - k);
+            compute_panel_factorization(k, b);
+            if (k + b == RW.cols())
+                break;
+            // Apply the transposed reflectors of the panel to the trailing
+            // matrix A[k:m,k+b:n].
+            size_t m = RW.rows() - k, nc = RW.cols() - k - b;
+            MatrixView V_k = V.block(0, 0, m, b), T_k = T.block(0, 0, b, b);
+            kernels::build_block_reflector(RW.block(k, k, m, b), V_k, T_k);
+            kernels::apply_block_reflector(V_k, T_k,
+                                           RW.block(k, k + b, m, nc),
+                                           W.block(0, 0, b, nc), true);
+        }
+    }
+    state = Factored;
+}
+//! <!-- [HouseholderQR::compute_factorization] -->
+
+/**
+ * @pre     Columns 0 through `k - 1` have been factored, and the remaining
+ *          columns have been updated accordingly.
+ * @post    Columns `k` through `k + b - 1` are factored, columns `k + b`
+ *          and up have not been updated.
+ * 
+ * ## Implementation
+ * @snippet this HouseholderQR::compute_panel_factorization
+ */
+//! <!-- [HouseholderQR::compute_panel_factorization] -->
+void HouseholderQR::compute_panel_factorization(size_t k_begin, size_t b) {
     // Helper function to square a number
     auto sq = [](double x) { return x * x; };
 
-    for (size_t k = 0; k < RW.cols(); ++k) {
+    size_t k_end = k_begin + b;
+    for (size_t k = k_begin; k < k_end; ++k) {
         // Introduce a column vector x = A[k:M,k], it's the lower part of the
         // k-th column of the matrix.
         // First compute the norm of x:
@@ -162,20 +228,29 @@ void HouseholderQR::compute_factorization() {
         // This can be computed column-wise:
         //     aᵢ' = aᵢ - wₖ·wₖᵀ·aᵢ
         // where aᵢ is the i-th column of A.
+        //
+        // Only the columns of the current panel are updated here, the columns
+        // to the right of it are updated all at once by
+        // kernels::apply_block_reflector.
+
+        // The columns are accessed through pointers, because this loop is
+        // where the panel factorization spends most of its time.
 
-        for (size_t c = k + 1; c < RW.cols(); ++c) {
+        const double *w_k = &RW(k, k);
+        const size_t rs = RW.row_stride(), len = RW.rows() - k;
+        for (size_t c = k + 1; c < k_end; ++c) {
+            double *a_i = &RW(k, c);
             // Compute wₖᵀ·aᵢ
             double dot_product = 0;
-            for (size_t r = k; r < RW.rows(); ++r)
-                dot_product += RW(r, k) * RW(r, c);
+            for (size_t r = 0; r < len; ++r)
+                dot_product += w_k[r * rs] * a_i[r * rs];
             // Subtract wₖ·wₖᵀ·aᵢ
-            for (size_t r = k; r < RW.rows(); ++r)
-                RW(r, c) -= RW(r, k) * dot_product;
+            for (size_t r = 0; r < len; ++r)
+                a_i[r * rs] -= w_k[r * rs] * dot_product;
         }
     }
-    state = Factored;
 }
-//! <!-- [HouseholderQR::compute_factorization] -->
+//! <!-- [HouseholderQR::compute_panel_factorization] -->
 
 /**
  * ## Implementation
@@ -185,21 +260,9 @@ void HouseholderQR::compute_factorization() {
 void HouseholderQR::apply_QT_inplace(Matrix &B) const {
     assert(is_factored());
     assert(RW.rows() == B.rows());
-    // Apply the Householder reflectors to each column of B.
-    for (size_t i = 0; i < B.cols(); ++i) {
-        // Recall that the Householder reflector H is applied as follows:
-        //     bᵢ'[k+1:m] = H·bᵢ[k+1:m]
-        //                = bᵢ[k+1:m] - wₖ·wₖᵀ·bᵢ[k+1:m]
-        for (size_t k = 0; k < RW.cols(); ++k) {
-            // Compute wₖᵀ·bᵢ
-            double dot_product = 0;
-            for (size_t r = k; r < RW.rows(); ++r)
-                dot_product += RW(r, k) * B(r, i);
-            // Subtract wₖ·wₖᵀ·bᵢ
-            for (size_t r = k; r < RW.rows(); ++r)
-                B(r, i) -= RW(r, k) * dot_product;
-        }
-    }
+    // With many right-hand sides, the reflectors are applied in blocks, see
+    // kernels/Householder.cpp.
+    kernels::apply_reflectors(RW, B, get_qr_block_size(), true);
 }
 //! <!-- [HouseholderQR::apply_QT_inplace] -->
 
@@ -211,23 +274,70 @@ void HouseholderQR::apply_QT_inplace(Matrix &B) const {
 void HouseholderQR::apply_Q_inplace(Matrix &X) const {
     assert(is_factored());
     assert(RW.rows() == X.rows());
-    // Apply the Householder reflectors in reverse order to each column of X.
-    for (size_t i = 0; i < X.cols(); ++i) {
-        // Recall that the Householder reflector H is applied as follows:
-        //     xᵢ'[k+1:m] = H·xᵢ[k+1:m]
-        //                = xᵢ[k+1:m] - wₖ·wₖᵀ·xᵢ[k+1:m]
-        for (size_t k = RW.cols(); k-- > 0;) {
-            // Compute wₖᵀ·xᵢ
+    // With many right-hand sides, the reflectors are applied in blocks, see
+    // kernels/Householder.cpp.
+    kernels::apply_reflectors(RW, X, get_qr_block_size(), false);
+}
+//! <!-- [HouseholderQR::apply_Q_inplace] -->
+
+/**
+ * @pre     `Q.rows() == RW.rows()`
+ * @pre     `Q.cols() == RW.cols()`
+ * @post    `Q` contains the first n columns of the unitary factor Q.
+ * 
+ * ## Implementation
+ * @snippet this HouseholderQR::get_thin_Q_inplace
+ */
+//! <!-- [HouseholderQR::get_thin_Q_inplace] -->
+void HouseholderQR::get_thin_Q_inplace(Matrix &Q) const {
+    assert(is_factored());
+    assert(Q.rows() == RW.rows());
+    assert(Q.cols() == RW.cols());
+    const size_t m = RW.rows(), n = RW.cols();
+
+    // The first n columns of Q = H₀·H₁·...·Hₙ₋₁ are obtained by applying the
+    // reflectors to the first n columns of the identity matrix, in reverse
+    // order (this is LAPACK's DORGQR).
+    // Reflector Hₖ only changes rows k through m - 1. Before it is applied,
+    // the columns j < k are still equal to the unit vectors eⱼ, which are
+    // zero in those rows, so Hₖ only needs to be applied to Q[k:m,k:n].
+    Q.fill_identity();
+
+    // Blocked version: apply a panel of nb reflectors at once, using their
+    // compact WY form, see kernels/Householder.cpp.
+    size_t nb = get_qr_block_size();
+    if (nb != 0 && n >= nb) {
+        Matrix V(m, nb), T(nb, nb), W(nb, n);
+        for (size_t p = (n + nb - 1) / nb; p-- > 0;) {
+            size_t k = p * nb, b = std::min(nb, n - k);
+            MatrixView V_k = V.block(0, 0, m - k, b), T_k = T.block(0, 0, b, b);
+            kernels::build_block_reflector(RW.block(k, k, m - k, b), V_k,
+                                           T_k);
+            kernels::apply_block_reflector(V_k, T_k,
+                                           Q.block(k, k, m - k, n - k),
+                                           W.block(0, 0, b, n - k), false);
+        }
+        return;
+    }
+
+    // Unblocked version: apply one reflector at a time.
+    const size_t rs_W = RW.row_stride(), rs_Q = Q.row_stride();
+    for (size_t k = n; k-- > 0;) {
+        const double *w_k = &RW(k, k);
+        const size_t len  = m - k;
+        for (size_t i = k; i < n; ++i) {
+            double *q_i = &Q(k, i);
+            // Compute wₖᵀ·qᵢ
             double dot_product = 0;
-            for (size_t r = k; r < RW.rows(); ++r)
-                dot_product += RW(r, k) * X(r, i);
-            // Subtract wₖ·wₖᵀ·xᵢ
-            for (size_t r = k; r < RW.rows(); ++r)
-                X(r, i) -= RW(r, k) * dot_product;
+            for (size_t r = 0; r < len; ++r)
+                dot_product += w_k[r * rs_W] * q_i[r * rs_Q];
+            // Subtract wₖ·wₖᵀ·qᵢ
+            for (size_t r = 0; r < len; ++r)
+                q_i[r * rs_Q] -= w_k[r * rs_W] * dot_product;
         }
     }
 }
-//! <!-- [HouseholderQR::apply_Q_inplace] -->
+//! <!-- [HouseholderQR::get_thin_Q_inplace] -->
 
 /**
  * ## Implementation
@@ -249,16 +359,20 @@ void HouseholderQR::back_subs(const Matrix &B, Matrix &X) const {
     // b₃ᵢ = r₃₃·x₃ᵢ + r₃₄·x₄ᵢ           ⟺ x₃ᵢ = (b₃ᵢ - r₃₄·x₄ᵢ)/r₃₃
     // b₂ᵢ = r₂₂·x₂ᵢ + r₂₃·x₃ᵢ + r₂₄·x₄ᵢ ⟺ x₂ᵢ = (b₂ᵢ - r₂₃·x₃ᵢ + r₂₄·x₄ᵢ)/r₂₂
     // ...
-
-    for (size_t i = 0; i < B.cols(); ++i) {
-        for (size_t k = RW.cols(); k-- > 0;) {
-            X(k, i) = B(k, i);
-            for (size_t j = k + 1; j < RW.cols(); ++j) {
-                X(k, i) -= RW(k, j) * X(j, i);
-            }
-            X(k, i) /= R_diag(k);
-        }
-    }
+    //
+    // Rather than solving one column at a time, the triangular solve kernel
+    // solves blocks of rows of all columns at once, and applies the
+    // off-diagonal blocks of R using matrix-matrix products. The diagonal of
+    // RW contains the reflection vectors, the diagonal of R is passed
+    // separately.
+    const size_t n = RW.cols();
+    if (&X != &B)
+        X.block(0, 0, n, B.cols()) = B.block(0, 0, n, B.cols());
+    kernels::trsm(Side::Left, Triangle::Upper, Diagonal::NonUnit, //
+                  n, X.cols(),                                    //
+                  RW.data(), RW.row_stride(), RW.col_stride(),    //
+                  X.data(), X.row_stride(), X.col_stride(),       //
+                  R_diag.data());
 }
 //! <!-- [HouseholderQR::back_subs] -->
 
@@ -0,0 +1,496 @@
+#include <linalg/LDLT.hpp>
+#include <linalg/Runtime.hpp>
+
+#include "kernels/Gemm.hpp"
+#include "kernels/Laswp.hpp"
+#include "kernels/Trsm.hpp"
+
+#include <algorithm> // std::min, std::max, std::swap
+#include <atomic>    // std::atomic
+#include <cassert>
+#include <cmath> // std::abs, std::sqrt
+
+namespace {
+
+/// Number of columns per panel of the blocked factorization, see
+/// @ref set_ldlt_block_size.
+std::atomic<size_t> ldlt_block_size{32};
+
+/// Bunch-Kaufman pivoting threshold (1 + √17)/8, which minimizes the bound on
+/// the element growth.
+const double bk_alpha = (1 + std::sqrt(17.)) / 8;
+
+/// Symmetric permutation of rows and columns i and p (with i < p) of the
+/// symmetric matrix whose lower-triangular part is stored in A. The rows of
+/// the columns to the left of column i (the computed columns of L) are swapped
+/// as well.
+void symmetric_swap(Matrix &A, size_t i, size_t p) {
+    assert(i < p);
+    // Rows i and p to the left of column i
+    for (size_t c = 0; c < i; ++c)
+        std::swap(A(i, c), A(p, c));
+    // The diagonal elements
+    std::swap(A(i, i), A(p, p));
+    // Column i between rows i and p is row p between columns i and p
+    for (size_t c = i + 1; c < p; ++c)
+        std::swap(A(c, i), A(p, c));
+    // Columns i and p below row p
+    for (size_t r = p + 1; r < A.rows(); ++r)
+        std::swap(A(r, i), A(r, p));
+}
+
+} // namespace
+
+void set_ldlt_block_size(size_t nb) {
+    ldlt_block_size.store(nb, std::memory_order_relaxed);
+}
+
+size_t get_ldlt_block_size() {
+    return ldlt_block_size.load(std::memory_order_relaxed);
+}
+
+/**
+ * @pre     The lower-triangular part of `LD` contains the lower-triangular
+ *          part of the symmetric matrix A to be factorized
+ * @pre     `P` contains the identity matrix (no permutations)
+ * @pre     `LD.rows() == LD.cols()`
+ * @pre     `P.size() == LD.rows()`
+ * @pre     `D_sub.size() == LD.rows()`
+ *
+ * @post    The strict lower-triangular part of `LD` contains the matrix L,
+ *          its diagonal contains the diagonal of D, and `D_sub` contains the
+ *          subdiagonal of D. The upper-triangular part of `LD` is unspecified.
+ * @post    `get_L() * get_D() * transpose(get_L()) == get_P() * A * transpose(get_P())`
+ *          (up to rounding errors)
+ *
+ * ## Implementation
+ * @snippet this LDLT::compute_factorization
+ */
+//! <!-- [LDLT::compute_factorization] -->
+void LDLT::compute_factorization() {
+    assert(LD.rows() == LD.cols());
+    assert(P.size() == LD.rows());
+    assert(D_sub.size() == LD.rows());
+
+    // For large matrices, the columns are processed in panels (right-looking
+    // blocked LDLᵀ, like LAPACK's DSYTRF). The pivot search needs up-to-date
+    // columns, so the columns of a panel are updated on the fly, one at a time,
+    // and stored in a workspace W. After factoring the panel, the rest of
+    // the matrix is updated using matrix-matrix products, see
+    // update_trailing_matrix. The last columns are factored using the
+    // unblocked algorithm.
+    const size_t n = LD.cols(), nb = get_ldlt_block_size();
+    size_t k = 0;
+    if (nb >= 2 && n >= 8 * nb) {
+        Matrix W(n, nb);
+        while (n - k > nb) {
+            size_t b = compute_panel_factorization(k, nb, W);
+            update_trailing_matrix(k, b, nb, W);
+            k += b;
+        }
+    }
+    compute_unblocked_factorization(k);
+    state = Factored;
+    valid_LD = true;
+    valid_P = true;
+}
+//! <!-- [LDLT::compute_factorization] -->
+
+/**
+ * @pre     Columns 0 through `k - 1` have been factored, and the remaining
+ *          columns have been updated accordingly.
+ * @post    All columns are factored.
+ *
+ * ## Implementation
+ * @snippet this LDLT::compute_unblocked_factorization
+ */
+//! <!-- [LDLT::compute_unblocked_factorization] -->
+void LDLT::compute_unblocked_factorization(size_t k_begin) {
+    // Partition the active part of the matrix as
+    //
+    //     ┌          ┐   ┌        ┐┌         ┐┌          ┐
+    //     │ A₁₁  A₂₁ᵀ│ = │ I    0 ││ D₁₁  0  ││ I   L₂₁ᵀ │
+    //     │ A₂₁  A₂₂ │   │ L₂₁  I ││ 0   A₂₂'││ 0   I    │
+    //     └          ┘   └        ┘└         ┘└          ┘
+    //
+    // where A₁₁ = D₁₁ is either a 1×1 or a 2×2 block. Then
+    //
+    //     A₂₁ = L₂₁·D₁₁                 ⟺ L₂₁  = A₂₁·D₁₁⁻¹
+    //     A₂₂ = L₂₁·D₁₁·L₂₁ᵀ + A₂₂'     ⟺ A₂₂' = A₂₂ - A₂₁·D₁₁⁻¹·A₂₁ᵀ
+    //
+    // and the algorithm continues with the trailing matrix A₂₂'. It is
+    // symmetric, so only its lower-triangular part is updated.
+    //
+    // Before each step, the Bunch-Kaufman strategy selects the pivot block
+    // D₁₁ and moves it to the top left using a symmetric permutation. A large
+    // diagonal element is used as a 1×1 pivot. If all diagonal elements are
+    // small compared to the off-diagonal elements, a 2×2 pivot that contains
+    // the largest off-diagonal element of the current column is used instead.
+    // This bounds the growth of the elements of A₂₂', just like partial
+    // pivoting does for the LU factorization.
+    const size_t n = LD.rows(), rs = LD.row_stride();
+    size_t kstep = 1;
+    for (size_t k = k_begin; k < n; k += kstep) {
+        // Find the largest off-diagonal element in column k
+        double absakk = std::abs(LD(k, k));
+        double colmax = 0;
+        size_t imax = k;
+        for (size_t i = k + 1; i < n; ++i) {
+            double abs_elem = std::abs(LD(i, k));
+            if (abs_elem > colmax) {
+                colmax = abs_elem;
+                imax = i;
+            }
+        }
+
+        // Select the pivot
+        size_t kp = k;
+        kstep = 1;
+        if (std::max(absakk, colmax) == 0) {
+            // The column is zero, the matrix is singular: D(k,k) is zero and
+            // the column of L is left zero as well.
+        } else if (absakk >= bk_alpha * colmax) {
+            // The diagonal element is large enough, no interchange
+        } else {
+            // Find the largest off-diagonal element in row/column imax
+            double rowmax = 0;
+            for (size_t j = k; j < imax; ++j)
+                rowmax = std::max(rowmax, std::abs(LD(imax, j)));
+            for (size_t i = imax + 1; i < n; ++i)
+                rowmax = std::max(rowmax, std::abs(LD(i, imax)));
+
+            if (absakk >= bk_alpha * colmax * (colmax / rowmax)) {
+                // The diagonal element is still large enough, no interchange
+            } else if (std::abs(LD(imax, imax)) >= bk_alpha * rowmax) {
+                // Use the diagonal element imax as a 1×1 pivot
+                kp = imax;
+            } else {
+                // Use a 2×2 pivot, interchange rows/columns k+1 and imax
+                kp = imax;
+                kstep = 2;
+            }
+        }
+
+        // Move the pivot block to the top left of the active matrix
+        size_t kk = k + kstep - 1;
+        if (kp != kk) {
+            P(kk) = kp;
+            symmetric_swap(LD, kk, kp);
+        }
+
+        if (kstep == 1) {
+            // L₂₁ = A₂₁ / d₁₁
+            double d = LD(k, k);
+            double *l_k = &LD(k, k);
+            if (d != 0)
+                for (size_t i = 1; i < n - k; ++i)
+                    l_k[i * rs] /= d;
+            // A₂₂' = A₂₂ - L₂₁·d₁₁·L₂₁ᵀ
+            for (size_t c = k + 1; c < n; ++c) {
+                double *a_c = &LD(c, c), w_c = d * LD(c, k);
+                const double *l_ik = &LD(c, k);
+                for (size_t i = 0; i < n - c; ++i)
+                    a_c[i * rs] -= l_ik[i * rs] * w_c;
+            }
+            D_sub(k) = 0;
+        } else {
+            // D₁₁⁻¹ is computed as in LAPACK's DSYTF2, scaled by the
+            // off-diagonal element d₂₁, which is never zero here, because it
+            // has the largest magnitude in its column.
+            double d21 = LD(k + 1, k);
+            double d11 = LD(k + 1, k + 1) / d21;
+            double d22 = LD(k, k) / d21;
+            double t = 1 / (d11 * d22 - 1);
+            double s = t / d21;
+            for (size_t c = k + 2; c < n; ++c) {
+                // Row c of L₂₁ = A₂₁·D₁₁⁻¹
+                double w0 = s * (d11 * LD(c, k) - LD(c, k + 1));
+                double w1 = s * (d22 * LD(c, k + 1) - LD(c, k));
+                // A₂₂' = A₂₂ - A₂₁·L₂₁ᵀ
+                double *a_c = &LD(c, c);
+                const double *a_ck = &LD(c, k), *a_ck1 = &LD(c, k + 1);
+                for (size_t i = 0; i < n - c; ++i)
+                    a_c[i * rs] -= a_ck[i * rs] * w0 + a_ck1[i * rs] * w1;
+                LD(c, k) = w0;
+                LD(c, k + 1) = w1;
+            }
+            D_sub(k) = d21;
+            D_sub(k + 1) = 0;
+            LD(k + 1, k) = 0;
+        }
+    }
+}
+//! <!-- [LDLT::compute_unblocked_factorization] -->
+
+/**
+ * @pre     Columns 0 through `k - 1` have been factored, and the remaining
+ *          columns have been updated accordingly.
+ * @pre     `W.rows() == LD.rows()`, `W.cols() == nb`, `nb >= 2`
+ * @post    Columns `k` through `k + b - 1` are factored, where `b` is the
+ *          return value. The lower-triangular part of the trailing submatrix
+ *          A(k+b:n,k+b:n) has not been updated, rows `k` through `n - 1` of
+ *          the first `b` columns of `W` contain the updated columns L·D of the
+ *          panel.
+ *
+ * ## Implementation
+ * @snippet this LDLT::compute_panel_factorization
+ */
+//! <!-- [LDLT::compute_panel_factorization] -->
+size_t LDLT::compute_panel_factorization(size_t k_begin, size_t nb,
+                                         Matrix &W) {
+    // This is the same algorithm as compute_unblocked_factorization, but the
+    // rank-one and rank-two updates of the columns to the right of the
+    // current pivot are postponed. Instead, just before a column j is needed
+    // (either because it is the current column, or because it's a candidate
+    // pivot column imax), the pending updates of the panel are applied to a
+    // copy of that column in the workspace W:
+    //
+    //     W(:,j) = A(:,j) - L(:,k₀:k)·W(j,0:k-k₀)ᵀ
+    //
+    // because the columns of W that have been factored already contain the
+    // product L·D, so L·W(j,:)ᵀ = L·D·L(j,:)ᵀ.
+    const size_t n = LD.rows(), rs_W = W.row_stride(), rs = LD.row_stride();
+
+    // Copy column `src` of the lower-triangular part of A, starting at row k,
+    // to column j of W, and apply the pending updates of the panel.
+    auto update_column = [&](size_t k, size_t src, size_t j) {
+        for (size_t i = k; i < src; ++i)
+            W(i, j) = LD(src, i);
+        for (size_t i = src; i < n; ++i)
+            W(i, j) = LD(i, src);
+        double *w_j = &W(k, j);
+        for (size_t p = 0; p < k - k_begin; ++p) {
+            const double *l_p = &LD(k, k_begin + p);
+            double w_srcp = W(src, p);
+            for (size_t i = 0; i < n - k; ++i)
+                w_j[i * rs_W] -= l_p[i * rs] * w_srcp;
+        }
+    };
+
+    size_t k = k_begin;
+    while (k - k_begin < nb - 1) {
+        size_t j = k - k_begin; // column of W
+        update_column(k, k, j);
+
+        // Find the largest off-diagonal element in column k
+        double absakk = std::abs(W(k, j));
+        double colmax = 0;
+        size_t imax = k;
+        for (size_t i = k + 1; i < n; ++i) {
+            double abs_elem = std::abs(W(i, j));
+            if (abs_elem > colmax) {
+                colmax = abs_elem;
+                imax = i;
+            }
+        }
+
+        // Select the pivot
+        size_t kp = k, kstep = 1;
+        if (std::max(absakk, colmax) == 0) {
+            // The column is zero, the matrix is singular
+        } else if (absakk >= bk_alpha * colmax) {
+            // The diagonal element is large enough, no interchange
+        } else {
+            // Get the updated column imax in the next column of W, and find
+            // its largest off-diagonal element
+            update_column(k, imax, j + 1);
+            double rowmax = 0;
+            for (size_t i = k; i < n; ++i)
+                if (i != imax)
+                    rowmax = std::max(rowmax, std::abs(W(i, j + 1)));
+
+            if (absakk >= bk_alpha * colmax * (colmax / rowmax)) {
+                // The diagonal element is still large enough, no interchange
+            } else if (std::abs(W(imax, j + 1)) >= bk_alpha * rowmax) {
+                // Use the diagonal element imax as a 1×1 pivot
+                kp = imax;
+                for (size_t i = k; i < n; ++i)
+                    W(i, j) = W(i, j + 1);
+            } else {
+                // Use a 2×2 pivot
+                kp = imax;
+                kstep = 2;
+            }
+        }
+
+        // Move the pivot block to the top left of the active matrix. Only the
+        // computed columns of L and the pending columns in W are up to date,
+        // the rest of the trailing matrix is permuted as well, so that the
+        // pending updates can be applied to it later.
+        size_t kk = k + kstep - 1;
+        if (kp != kk) {
+            P(kk) = kp;
+            symmetric_swap(LD, kk, kp);
+            for (size_t c = 0; c < j + kstep; ++c)
+                std::swap(W(kk, c), W(kp, c));
+        }
+
+        if (kstep == 1) {
+            // L₂₁ = A₂₁ / d₁₁
+            double d = W(k, j);
+            LD(k, k) = d;
+            for (size_t i = k + 1; i < n; ++i)
+                LD(i, k) = d != 0 ? W(i, j) / d : 0;
+            D_sub(k) = 0;
+        } else {
+            // L₂₁ = A₂₁·D₁₁⁻¹, see compute_unblocked_factorization
+            double d21 = W(k + 1, j);
+            double d11 = W(k + 1, j + 1) / d21;
+            double d22 = W(k, j) / d21;
+            double t = 1 / (d11 * d22 - 1);
+            double s = t / d21;
+            for (size_t i = k + 2; i < n; ++i) {
+                LD(i, k) = s * (d11 * W(i, j) - W(i, j + 1));
+                LD(i, k + 1) = s * (d22 * W(i, j + 1) - W(i, j));
+            }
+            LD(k, k) = W(k, j);
+            LD(k + 1, k) = 0;
+            LD(k + 1, k + 1) = W(k + 1, j + 1);
+            D_sub(k) = d21;
+            D_sub(k + 1) = 0;
+        }
+        k += kstep;
+    }
+    return k - k_begin;
+}
+//! <!-- [LDLT::compute_panel_factorization] -->
+
+/**
+ * @pre     Columns `k` through `k + b - 1` have just been factored by
+ *          @ref compute_panel_factorization, using workspace `W`.
+ * @post    The lower-triangular part of the trailing submatrix
+ *          A(k+b:n,k+b:n) has been updated.
+ *
+ * ## Implementation
+ * @snippet this LDLT::update_trailing_matrix
+ */
+//! <!-- [LDLT::update_trailing_matrix] -->
+void LDLT::update_trailing_matrix(size_t k, size_t b, size_t nb,
+                                  const Matrix &W) {
+    // Partition the active part of the matrix as
+    //     ┌         ┐   ┌         ┐┌          ┐┌           ┐
+    //     │ A₁₁     │ = │ L₁₁     ││ D₁₁      ││ L₁₁ᵀ L₂₁ᵀ │
+    //     │ A₂₁ A₂₂ │   │ L₂₁ I   ││      A₂₂'││      I    │
+    //     └         ┘   └         ┘└          ┘└           ┘
+    // where A₁₁ is b×b. The panel factorization computed L₁₁, D₁₁, L₂₁, and
+    // W₂ = L₂₁·D₁₁ (the last rows of W), so what's left is the update
+    //     A₂₂' = A₂₂ - L₂₁·D₁₁·L₂₁ᵀ = A₂₂ - L₂₁·W₂ᵀ
+    // Only the lower-triangular part is needed. It is computed in blocks of nb
+    // columns, each block is a single matrix-matrix product (which also
+    // computes the upper-triangular part of the diagonal nb×nb blocks, but
+    // that part is never read).
+    const size_t t = k + b, n = LD.cols() - t;
+    const size_t rs = LD.row_stride(), cs = LD.col_stride();
+    const size_t rs_W = W.row_stride(), cs_W = W.col_stride();
+    for (size_t j = 0; j < n; j += nb) {
+        size_t jb = std::min(nb, n - j);
+        // L₂₁(j:n,:) and W₂(j:j+jb,:)ᵀ
+        const double *L21 = &LD(t + j, k), *W2 = &W(t + j, 0);
+        double *A22 = &LD(t + j, t + j);
+        kernels::gemm(n - j, jb, b,      //
+                      -1, L21, rs, cs,   //
+                      W2, cs_W, rs_W,    //
+                      1, A22, rs, cs);
+    }
+}
+//! <!-- [LDLT::update_trailing_matrix] -->
+
+/**
+ * ## Implementation
+ * @snippet this LDLT::forward_subs
+ */
+//! <!-- [LDLT::forward_subs] -->
+void LDLT::forward_subs(Matrix &B) const {
+    // Solve lower triangular system LX = B, where L has an implicit unit
+    // diagonal, see NoPivotLU::forward_subs. L is stored in the strict
+    // lower-triangular part of LD, so the triangular solve kernel can be
+    // used directly.
+    kernels::trsm(Side::Left, Triangle::Lower, Diagonal::Unit,  //
+                  LD.rows(), B.cols(),                          //
+                  LD.data(), LD.row_stride(), LD.col_stride(),  //
+                  B.data(), B.row_stride(), B.col_stride());
+}
+//! <!-- [LDLT::forward_subs] -->
+
+/**
+ * ## Implementation
+ * @snippet this LDLT::diagonal_solve
+ */
+//! <!-- [LDLT::diagonal_solve] -->
+void LDLT::diagonal_solve(Matrix &B) const {
+    // Solve the block-diagonal system DX = B, one 1×1 or 2×2 block at a time.
+    // The 2×2 blocks
+    //
+    //     ┌          ┐
+    //     │ d₁₁  d₂₁ │
+    //     │ d₂₁  d₂₂ │
+    //     └          ┘
+    //
+    // are inverted explicitly, after scaling by d₂₁, like LAPACK's DSYTRS.
+    const size_t n = LD.rows();
+    for (size_t k = 0; k < n;) {
+        if (D_sub(k) == 0) {
+            double d = LD(k, k);
+            for (size_t i = 0; i < B.cols(); ++i)
+                B(k, i) /= d;
+            k += 1;
+        } else {
+            double d21 = D_sub(k);
+            double d11 = LD(k, k) / d21;
+            double d22 = LD(k + 1, k + 1) / d21;
+            double denom = d11 * d22 - 1;
+            for (size_t i = 0; i < B.cols(); ++i) {
+                double b1 = B(k, i) / d21;
+                double b2 = B(k + 1, i) / d21;
+                B(k, i) = (d22 * b1 - b2) / denom;
+                B(k + 1, i) = (d11 * b2 - b1) / denom;
+            }
+            k += 2;
+        }
+    }
+}
+//! <!-- [LDLT::diagonal_solve] -->
+
+/**
+ * ## Implementation
+ * @snippet this LDLT::back_subs
+ */
+//! <!-- [LDLT::back_subs] -->
+void LDLT::back_subs(Matrix &B) const {
+    // Solve upper triangular system LᵀX = B, see Cholesky::back_subs. The
+    // diagonal of L is implicitly 1.
+    kernels::trsm(Side::Left, Triangle::Upper, Diagonal::Unit,  //
+                  LD.rows(), B.cols(),                          //
+                  LD.data(), LD.col_stride(), LD.row_stride(),  //
+                  B.data(), B.row_stride(), B.col_stride());
+}
+//! <!-- [LDLT::back_subs] -->
+
+/**
+ * ## Implementation
+ * @snippet this LDLT::solve_inplace
+ */
+//! <!-- [LDLT::solve_inplace] -->
+void LDLT::solve_inplace(Matrix &B) const {
+    // Solve the system AX = B, or PᵀLDLᵀPX = B.
+    //
+    // Let DLᵀPX = Z, and first solve LZ = PB, which is a simple
+    // lower-triangular system of equations.
+    // Let LᵀPX = Y, and solve DY = Z, which is a block-diagonal system.
+    // Now that Y is known, solve LᵀV = Y, which is a simple upper-triangular
+    // system of equations, and finally X = PᵀV.
+    assert(is_factored());
+    assert(B.rows() == LD.rows());
+
+    P.permute_rows(B);
+    forward_subs(B);   // overwrite B with Z
+    diagonal_solve(B); // overwrite B (Z) with Y
+    back_subs(B);      // overwrite B (Y) with V
+    // Apply Pᵀ by undoing the row swaps of P in reverse order
+    kernels::laswp(B.cols(), B.data(), B.row_stride(), B.col_stride(),
+                   P.data(), 0, P.size(), true);
+}
+//! <!-- [LDLT::solve_inplace] -->
+
+// All implementations of the less interesting functions can be found here:
+#include "boilerplate/LDLT.ipp"
@@ -1,21 +1,83 @@
 #include <linalg/Matrix.hpp>
 
-#pragma region // Constructors -------------------------------------------------
-
-Matrix::Matrix(storage_t &&storage, size_t rows, size_t cols)
-    : rows_(rows), //
-      cols_(cols), //
-      storage(std::move(storage)) {}
+#include "kernels/Gemm.hpp"
+#include "kernels/Gemv.hpp"
+#include "kernels/Simd.hpp"
+#include "kernels/Transpose.hpp"
+
+#include <functional>
+
+namespace {
+
+/// Check whether the elements of A and B with the same indices are stored at
+/// the same positions in memory, so that element-wise operations can treat
+/// their storage as flat arrays. This is the case if they have the same
+/// storage order, and for vectors, regardless of their storage order.
+bool have_same_layout(const Matrix &A, const Matrix &B) {
+    return A.storage_order() == B.storage_order() || A.rows() <= 1 ||
+           A.cols() <= 1;
+}
+
+/// Check whether the memory spanned by the elements of A and B overlaps.
+/// This is conservative: interleaved views that don't share any elements are
+/// considered to overlap as well.
+bool may_overlap(const ConstMatrixView &A, const ConstMatrixView &B) {
+    if (A.num_elems() == 0 || B.num_elems() == 0)
+        return false;
+    auto end = [](const ConstMatrixView &V) {
+        return V.data() + (V.rows() - 1) * V.row_stride() +
+               (V.cols() - 1) * V.col_stride() + 1;
+    };
+    std::less<const double *> less;
+    return less(A.data(), end(B)) && less(B.data(), end(A));
+}
+
+/// Compute C = α·A·B + β·C, also if C overlaps with A or B. The kernels
+/// overwrite C while they are still reading A and B, so in that case, the
+/// product has to be computed separately first.
+void accumulate_product(double alpha, const ConstMatrixView &A,
+                        const ConstMatrixView &B, MatrixView C) {
+    if (!may_overlap(C, A) && !may_overlap(C, B))
+        return gemm(alpha, A, B, 1, C);
+    Matrix AB(C.rows(), C.cols());
+    gemm(alpha, A, B, 0, AB);
+    C += AB;
+}
+
+/// Transpose a rectangular matrix in place, reusing its storage. The storage
+/// order is preserved: a row major m×n matrix is stored as a column major n×m
+/// matrix, so the kernel simply gets its dimensions swapped.
+void transpose_inplace_rectangular(Matrix &A) {
+    if (A.storage_order() == StorageOrder::ColMajor)
+        kernels::transpose_inplace_rectangular(A.rows(), A.cols(), A.data());
+    else
+        kernels::transpose_inplace_rectangular(A.cols(), A.rows(), A.data());
+    A.reshape(A.cols(), A.rows());
+}
+
+} // namespace
 
-Matrix::Matrix(const storage_t &storage, size_t rows, size_t cols)
-    : rows_(rows), //
-      cols_(cols), //
-      storage(storage) {}
+#pragma region // Constructors -------------------------------------------------
 
-Matrix::Matrix(size_t rows, size_t cols)
-    : rows_(rows), //
-      cols_(cols), //
-      storage(rows * cols) {}
+Matrix::Matrix(storage_t &&storage, size_t rows, size_t cols,
+               StorageOrder order)
+    : rows_(rows),                 //
+      cols_(cols),                 //
+      storage(std::move(storage)), //
+      order_(order) {}
+
+Matrix::Matrix(const storage_t &storage, size_t rows, size_t cols,
+               StorageOrder order)
+    : rows_(rows),      //
+      cols_(cols),      //
+      storage(storage), //
+      order_(order) {}
+
+Matrix::Matrix(size_t rows, size_t cols, StorageOrder order)
+    : rows_(rows),          //
+      cols_(cols),          //
+      storage(rows * cols), //
+      order_(order) {}
 
 Matrix::Matrix(Matrix &&other) { *this = std::move(other); }
 
@@ -33,6 +95,7 @@ Matrix &Matrix::operator=(Matrix &&other) {
     this->storage = std::move(other.storage);
     this->rows_ = other.rows_;
     this->cols_ = other.cols_;
+    this->order_ = other.order_;
     other.clear_and_deallocate();
     return *this;
 }
@@ -71,12 +134,6 @@ Matrix::operator=(std::initializer_list<std::initializer_list<double>> init) {
 
 #pragma region // Matrix size --------------------------------------------------
 
-void Matrix::reshape(size_t newrows, size_t newcols) {
-    assert(newrows * newcols == rows() * cols());
-    this->rows_ = newrows;
-    this->cols_ = newcols;
-}
-
 Matrix Matrix::reshaped(size_t newrows, size_t newcols) const {
     Matrix result = *this;
     result.reshape(newrows, newcols);
@@ -85,37 +142,6 @@ Matrix Matrix::reshaped(size_t newrows, size_t newcols) const {
 
 #pragma endregion // -----------------------------------------------------------
 
-#pragma region // Element access -----------------------------------------------
-
-double &Matrix::operator()(size_t row, size_t col) {
-#if COL_MAJ_ORDER == 1
-    return storage[row + rows_ * col];
-#else
-    return storage[row * cols_ + col];
-#endif
-}
-
-const double &Matrix::operator()(size_t row, size_t col) const {
-#if COL_MAJ_ORDER == 1
-    return storage[row + rows_ * col];
-#else
-    return storage[row * cols_ + col];
-#endif
-}
-
-#pragma endregion // -----------------------------------------------------------
-
-#pragma region // Memory management --------------------------------------------
-
-void Matrix::clear_and_deallocate() {
-    this->rows_ = 0;
-    this->cols_ = 0;
-    storage_t().swap(this->storage); // replace storage with empty storage
-    // temporary storage goes out of scope and deallocates original storage
-}
-
-#pragma endregion // -----------------------------------------------------------
-
 #pragma region // Filling matrices ---------------------------------------------
 
 void Matrix::fill(double value) {
@@ -171,20 +197,6 @@ Matrix Matrix::random(size_t rows, size_t cols, double min, double max,
 
 #pragma endregion // -----------------------------------------------------------
 
-#pragma region // Swapping rows and columns ------------------------------------
-
-void Matrix::swap_columns(size_t a, size_t b) {
-    for (size_t r = 0; r < rows(); ++r)
-        std::swap((*this)(r, a), (*this)(r, b));
-}
-
-void Matrix::swap_rows(size_t a, size_t b) {
-    for (size_t c = 0; c < cols(); ++c)
-        std::swap((*this)(a, c), (*this)(b, c));
-}
-
-#pragma endregion // -----------------------------------------------------------
-
 #pragma region // Equality -----------------------------------------------------
 
 bool Matrix::operator==(const Matrix &other) const {
@@ -192,6 +204,15 @@ bool Matrix::operator==(const Matrix &other) const {
     // a bug, so don't return false, fail instead.
     assert(this->rows() == other.rows());
     assert(this->cols() == other.cols());
+    // Matrices with a different storage order are compared element by
+    // element.
+    if (!have_same_layout(*this, other)) {
+        for (size_t c = 0; c < cols(); ++c)
+            for (size_t r = 0; r < rows(); ++r)
+                if ((*this)(r, c) != other(r, c))
+                    return false;
+        return true;
+    }
     // Find the first element of the matrices that differs:
     auto res = std::mismatch(begin(), end(), other.begin());
     // If such an element doesn't exist (i.e. when the two matrices are the
@@ -291,7 +312,7 @@ Vector Vector::random(size_t size, double min, double max,
 
 double Vector::dot_unchecked(const Matrix &a, const Matrix &b) {
     assert(a.num_elems() == b.num_elems());
-    return std::inner_product(a.begin(), a.end(), b.begin(), double(0));
+    return kernels::simd().dot(a.num_elems(), a.data(), b.data());
 }
 
 double Vector::dot_unchecked(Matrix &&a, const Matrix &b) {
@@ -312,6 +333,32 @@ double Vector::dot_unchecked(Matrix &&a, Matrix &&b) {
     return result;
 }
 
+double Vector::dot_unchecked(const ConstMatrixView &a,
+                             const ConstMatrixView &b) {
+    assert(a.num_elems() == b.num_elems());
+    auto vector_stride = [](const ConstMatrixView &v) {
+        return v.rows() == 1 ? v.col_stride() : v.row_stride();
+    };
+    bool vectors = (a.rows() == 1 || a.cols() == 1) && //
+                   (b.rows() == 1 || b.cols() == 1);
+    if (vectors) {
+        size_t sa = vector_stride(a), sb = vector_stride(b);
+        if (sa == 1 && sb == 1)
+            return kernels::simd().dot(a.num_elems(), a.data(), b.data());
+        double result = 0;
+        for (size_t i = 0; i < a.num_elems(); ++i)
+            result += a.data()[i * sa] * b.data()[i * sb];
+        return result;
+    }
+    // Sum of the dot products of the columns:
+    assert(a.rows() == b.rows());
+    assert(a.cols() == b.cols());
+    double result = 0;
+    for (size_t c = 0; c < a.cols(); ++c)
+        result += dot_unchecked(a.col(c), b.col(c));
+    return result;
+}
+
 double Vector::dot(const Vector &a, const Vector &b) {
     return dot_unchecked(a, b);
 }
@@ -559,9 +606,8 @@ SquareMatrix &SquareMatrix::operator=(
 
 void SquareMatrix::transpose_inplace(Matrix &A) {
     assert(A.cols() == A.rows() && "Matrix should be square.");
-    for (size_t n = 0; n < A.rows() - 1; ++n)
-        for (size_t m = n + 1; m < A.rows(); ++m)
-            std::swap(A(n, m), A(m, n));
+    kernels::transpose_inplace(A.rows(), A.data(), A.row_stride(),
+                               A.col_stride());
 }
 
 #pragma endregion // -----------------------------------------------------------
@@ -602,11 +648,13 @@ SquareMatrix::random(size_t rows, double min, double max,
 //! <!-- [operator*(Matrix, Matrix)] -->
 Matrix operator*(const Matrix &A, const Matrix &B) {
     assert(A.cols() == B.rows() && "Inner dimensions don't match");
-    Matrix C = Matrix::zeros(A.rows(), B.cols());
-    for (size_t j = 0; j < B.cols(); ++j)
-        for (size_t k = 0; k < A.cols(); ++k)
-            for (size_t i = 0; i < A.rows(); ++i)
-                C(i, j) += A(i, k) * B(k, j);
+    Matrix C(A.rows(), B.cols());
+    // The actual work is done by a cache-blocked kernel that packs panels of
+    // A and B into contiguous buffers and computes the product in small
+    // register tiles, see kernels/Gemm.cpp. If B is a column vector or A a
+    // row vector, a vectorized matrix-vector kernel is used instead, see
+    // kernels/Gemv.cpp.
+    gemm(1, A, B, 0, C);
     return C;
 }
 //! <!-- [operator*(Matrix, Matrix)] -->
@@ -651,29 +699,45 @@ SquareMatrix operator*(SquareMatrix &&A, SquareMatrix &&B) {
 }
 
 Vector operator*(const Matrix &A, const Vector &b) {
-    return Vector(A * static_cast<const Matrix &>(b));
+    return ConstMatrixView(A) * b;
 }
 Vector operator*(Matrix &&A, const Vector &b) {
-    return Vector(std::move(A) * static_cast<const Matrix &>(b));
+    Vector result = static_cast<const Matrix &>(A) * b;
+    A.clear_and_deallocate();
+    return result;
 }
 Vector operator*(const Matrix &A, Vector &&b) {
-    return Vector(A * static_cast<Matrix &&>(b));
+    Vector result = A * static_cast<const Vector &>(b);
+    b.clear_and_deallocate();
+    return result;
 }
 Vector operator*(Matrix &&A, Vector &&b) {
-    return Vector(std::move(A) * static_cast<Matrix &&>(b));
+    Vector result = static_cast<const Matrix &>(A) * //
+                    static_cast<const Vector &>(b);
+    A.clear_and_deallocate();
+    b.clear_and_deallocate();
+    return result;
 }
 
 RowVector operator*(const RowVector &a, const Matrix &B) {
-    return RowVector(static_cast<const Matrix &>(a) * B);
+    return a * ConstMatrixView(B);
 }
 RowVector operator*(RowVector &&a, const Matrix &B) {
-    return RowVector(static_cast<Matrix &&>(a) * B);
+    RowVector result = static_cast<const RowVector &>(a) * B;
+    a.clear_and_deallocate();
+    return result;
 }
 RowVector operator*(const RowVector &a, Matrix &&B) {
-    return RowVector(static_cast<const Matrix &>(a) * std::move(B));
+    RowVector result = a * static_cast<const Matrix &>(B);
+    B.clear_and_deallocate();
+    return result;
 }
 RowVector operator*(RowVector &&a, Matrix &&B) {
-    return RowVector(static_cast<Matrix &&>(a) * std::move(B));
+    RowVector result = static_cast<const RowVector &>(a) * //
+                       static_cast<const Matrix &>(B);
+    a.clear_and_deallocate();
+    B.clear_and_deallocate();
+    return result;
 }
 
 double operator*(const RowVector &a, const Vector &b) {
@@ -689,30 +753,110 @@ double operator*(RowVector &&a, Vector &&b) {
     return Vector::dot_unchecked(std::move(a), std::move(b));
 }
 
+Matrix operator*(const ConstMatrixView &A, const ConstMatrixView &B) {
+    assert(A.cols() == B.rows() && "Inner dimensions don't match");
+    Matrix C(A.rows(), B.cols());
+    gemm(1, A, B, 0, C);
+    return C;
+}
+Vector operator*(const ConstMatrixView &A, const Vector &b) {
+    assert(A.cols() == b.rows() && "Inner dimensions don't match");
+    Vector c(A.rows());
+    gemm(1, A, b, 0, c);
+    return c;
+}
+RowVector operator*(const RowVector &a, const ConstMatrixView &B) {
+    assert(a.cols() == B.rows() && "Inner dimensions don't match");
+    RowVector c(B.cols());
+    gemm(1, a, B, 0, c);
+    return c;
+}
+
+void gemm(double alpha, const ConstMatrixView &A, const ConstMatrixView &B,
+          double beta, MatrixView C) {
+    assert(A.cols() == B.rows() && "Inner dimensions don't match");
+    assert(C.rows() == A.rows() && C.cols() == B.cols());
+    assert(!may_overlap(C, A) && !may_overlap(C, B));
+    // The GEMM and GEMV kernels support arbitrary strides, so views and
+    // transposes don't have to be copied first.
+    if (B.cols() == 1) // C = α·A·b + β·C
+        kernels::gemv(A.rows(), A.cols(),                              //
+                      alpha, A.data(), A.row_stride(), A.col_stride(), //
+                      B.data(), B.row_stride(),                        //
+                      beta, C.data(), C.row_stride());
+    else if (A.rows() == 1) // C = α·a·B + β·C ⟺ Cᵀ = α·Bᵀ·aᵀ + β·Cᵀ
+        kernels::gemv(B.cols(), B.rows(),                              //
+                      alpha, B.data(), B.col_stride(), B.row_stride(), //
+                      A.data(), A.col_stride(),                        //
+                      beta, C.data(), C.col_stride());
+    else
+        kernels::gemm(A.rows(), B.cols(), A.cols(),                      //
+                      alpha, A.data(), A.row_stride(), A.col_stride(), //
+                      B.data(), B.row_stride(), B.col_stride(),        //
+                      beta, C.data(), C.row_stride(), C.col_stride());
+}
+
+void add_product(MatrixView C, const ConstMatrixView &A,
+                 const ConstMatrixView &B) {
+    accumulate_product(1, A, B, C);
+}
+
+void subtract_product(MatrixView C, const ConstMatrixView &A,
+                      const ConstMatrixView &B) {
+    accumulate_product(-1, A, B, C);
+}
+
+void gemv(double alpha, const ConstMatrixView &A, const ConstMatrixView &x,
+          double beta, MatrixView y) {
+    assert(x.rows() == 1 || x.cols() == 1);
+    assert(y.rows() == 1 || y.cols() == 1);
+    assert(A.cols() == x.num_elems() && "Inner dimensions don't match");
+    assert(A.rows() == y.num_elems());
+    size_t incx = x.rows() == 1 ? x.col_stride() : x.row_stride();
+    size_t incy = y.rows() == 1 ? y.col_stride() : y.row_stride();
+    kernels::gemv(A.rows(), A.cols(),                              //
+                  alpha, A.data(), A.row_stride(), A.col_stride(), //
+                  x.data(), incx,                                  //
+                  beta, y.data(), incy);
+}
+
 #pragma endregion // -----------------------------------------------------------
 
-#pragma region // Addition -----------------------------------------------------
+#pragma region // Expression evaluation ----------------------------------------
 
-/**
- * ## Implementation
- * @snippet this operator+(Matrix, Matrix)
- */
-//! <!-- [operator+(Matrix, Matrix)] -->
-Matrix operator+(const Matrix &A, const Matrix &B) {
-    assert(A.rows() == B.rows());
-    assert(A.cols() == B.cols());
-    Matrix C(A.rows(), A.cols());
-    std::transform(A.begin(), A.end(), B.begin(), C.begin(),
-                   std::plus<double>());
-    return C;
+namespace util {
+namespace expr {
+
+void add(size_t n, const double *a, const double *b, double *c) {
+    kernels::simd().add(n, a, b, c);
+}
+void sub(size_t n, const double *a, const double *b, double *c) {
+    kernels::simd().sub(n, a, b, c);
+}
+void neg(size_t n, const double *a, double *c) {
+    kernels::simd().neg(n, a, c);
+}
+void mul_scalar(size_t n, const double *a, double s, double *c) {
+    kernels::simd().mul_scalar(n, a, s, c);
 }
-//! <!-- [operator+(Matrix, Matrix)] -->
+void div_scalar(size_t n, const double *a, double s, double *c) {
+    kernels::simd().div_scalar(n, a, s, c);
+}
+
+} // namespace expr
+} // namespace util
+
+#pragma endregion // -----------------------------------------------------------
+
+#pragma region // Addition -----------------------------------------------------
 
 void operator+=(Matrix &A, const Matrix &B) {
     assert(A.rows() == B.rows());
     assert(A.cols() == B.cols());
-    std::transform(A.begin(), A.end(), B.begin(), A.begin(),
-                   std::plus<double>());
+    if (have_same_layout(A, B))
+        kernels::simd().add(A.num_elems(), A.data(), B.data(), A.data());
+    else // strided evaluation
+        A = static_cast<const Matrix &>(A) + B;
 }
 Matrix &&operator+(Matrix &&A, const Matrix &B) {
     A += B;
@@ -766,51 +910,30 @@ SquareMatrix &&operator+(SquareMatrix &&a, SquareMatrix &&b) {
     b.clear_and_deallocate();
     return std::move(a);
 }
-Vector operator+(const Vector &a, const Vector &b) {
-    return Vector(static_cast<const Matrix &>(a) +
-                  static_cast<const Matrix &>(b));
-}
-RowVector operator+(const RowVector &a, const RowVector &b) {
-    return RowVector(static_cast<const Matrix &>(a) +
-                     static_cast<const Matrix &>(b));
-}
-SquareMatrix operator+(const SquareMatrix &a, const SquareMatrix &b) {
-    return SquareMatrix(static_cast<const Matrix &>(a) +
-                        static_cast<const Matrix &>(b));
-}
 
 #pragma endregion // -----------------------------------------------------------
 
 #pragma region // Subtraction --------------------------------------------------
 
-/**
- * ## Implementation
- * @snippet this operator-(Matrix, Matrix)
- */
-//! <!-- [operator-(Matrix, Matrix)] -->
-Matrix operator-(const Matrix &A, const Matrix &B) {
-    assert(A.rows() == B.rows());
-    assert(A.cols() == B.cols());
-    Matrix C(A.rows(), A.cols());
-    std::transform(A.begin(), A.end(), B.begin(), C.begin(),
-                   std::minus<double>());
-    return C;
-}
-//! <!-- [operator-(Matrix, Matrix)] -->
-
 void operator-=(Matrix &A, const Matrix &B) {
     assert(A.rows() == B.rows());
     assert(A.cols() == B.cols());
-    std::transform(A.begin(), A.end(), B.begin(), A.begin(),
-                   std::minus<double>());
+    if (have_same_layout(A, B))
+        kernels::simd().sub(A.num_elems(), A.data(), B.data(), A.data());
+    else // strided evaluation
+        A = static_cast<const Matrix &>(A) - B;
 }
 Matrix &&operator-(Matrix &&A, const Matrix &B) {
     A -= B;
     return std::move(A);
 }
 Matrix &&operator-(const Matrix &A, Matrix &&B) {
-    std::transform(A.begin(), A.end(), B.begin(), B.begin(),
-                   std::minus<double>());
+    assert(A.rows() == B.rows());
+    assert(A.cols() == B.cols());
+    if (have_same_layout(A, B))
+        kernels::simd().sub(A.num_elems(), A.data(), B.data(), B.data());
+    else // strided evaluation
+        B = A - static_cast<const Matrix &>(B);
     return std::move(B);
 }
 Matrix &&operator-(Matrix &&A, Matrix &&B) {
@@ -857,39 +980,13 @@ SquareMatrix &&operator-(SquareMatrix &&a, SquareMatrix &&b) {
     b.clear_and_deallocate();
     return std::move(a);
 }
-Vector operator-(const Vector &a, const Vector &b) {
-    return Vector(static_cast<const Matrix &>(a) -
-                  static_cast<const Matrix &>(b));
-}
-RowVector operator-(const RowVector &a, const RowVector &b) {
-    return RowVector(static_cast<const Matrix &>(a) -
-                     static_cast<const Matrix &>(b));
-}
-SquareMatrix operator-(const SquareMatrix &a, const SquareMatrix &b) {
-    return SquareMatrix(static_cast<const Matrix &>(a) -
-                        static_cast<const Matrix &>(b));
-}
 
 #pragma endregion // -----------------------------------------------------------
 
 #pragma region // Negation -----------------------------------------------------
 
-/**
- * @brief   Matrix negation.
- * 
- * ## Implementation
- * @snippet this operator-(Matrix)
- */
-//! <!-- [operator-(Matrix)] -->
-Matrix operator-(const Matrix &A) {
-    Matrix result(A.rows(), A.cols());
-    std::transform(A.begin(), A.end(), result.begin(), std::negate<double>());
-    return result;
-}
-//! <!-- [operator-(Matrix)] -->
-
 Matrix &&operator-(Matrix &&A) {
-    std::transform(A.begin(), A.end(), A.begin(), std::negate<double>());
+    kernels::simd().neg(A.num_elems(), A.data(), A.data());
     return std::move(A);
 }
 Vector &&operator-(Vector &&a) {
@@ -904,50 +1001,18 @@ SquareMatrix &&operator-(SquareMatrix &&a) {
     -static_cast<Matrix &&>(a);
     return std::move(a);
 }
-Vector operator-(const Vector &a) {
-    return Vector(-static_cast<const Matrix &>(a));
-}
-RowVector operator-(const RowVector &a) {
-    return RowVector(-static_cast<const Matrix &>(a));
-}
-SquareMatrix operator-(const SquareMatrix &a) {
-    return SquareMatrix(-static_cast<const Matrix &>(a));
-}
 
 #pragma endregion // -----------------------------------------------------------
 
 #pragma region // Scalar multiplication ----------------------------------------
 
-/**
- * ## Implementation
- * @snippet this operator*(Matrix, double)
- */
-//! <!-- [operator*(Matrix, double)] -->
-Matrix operator*(const Matrix &A, double s) {
-    Matrix C(A.rows(), A.cols());
-    std::transform(A.begin(), A.end(), C.begin(),
-                   [s](double a) { return a * s; });
-    return C;
-}
-//! <!-- [operator*(Matrix, double)] -->
-
 void operator*=(Matrix &A, double s) {
-    std::transform(A.begin(), A.end(), A.begin(),
-                   [s](double a) { return a * s; });
+    kernels::simd().mul_scalar(A.num_elems(), A.data(), s, A.data());
 }
 Matrix &&operator*(Matrix &&A, double s) {
     A *= s;
     return std::move(A);
 }
-Vector operator*(const Vector &a, double s) {
-    return Vector(static_cast<const Matrix &>(a) * s);
-}
-RowVector operator*(const RowVector &a, double s) {
-    return RowVector(static_cast<const Matrix &>(a) * s);
-}
-SquareMatrix operator*(const SquareMatrix &a, double s) {
-    return SquareMatrix(static_cast<const Matrix &>(a) * s);
-}
 Vector &&operator*(Vector &&a, double s) {
     static_cast<Matrix &>(a) *= s;
     return std::move(a);
@@ -961,11 +1026,7 @@ SquareMatrix &&operator*(SquareMatrix &&a, double s) {
     return std::move(a);
 }
 
-Matrix operator*(double s, const Matrix &A) { return A * s; }
 Matrix &&operator*(double s, Matrix &&A) { return std::move(A) * s; }
-Vector operator*(double s, const Vector &a) { return a * s; }
-RowVector operator*(double s, const RowVector &a) { return a * s; }
-SquareMatrix operator*(double s, const SquareMatrix &a) { return a * s; }
 Vector &&operator*(double s, Vector &&a) { return std::move(a) * s; }
 RowVector &&operator*(double s, RowVector &&a) { return std::move(a) * s; }
 SquareMatrix &&operator*(double s, SquareMatrix &&a) {
@@ -976,36 +1037,13 @@ SquareMatrix &&operator*(double s, SquareMatrix &&a) {
 
 #pragma region // Scalar division ----------------------------------------------
 
-/**
- * ## Implementation
- * @snippet this operator/(Matrix, double)
- */
-//! <!-- [operator/(Matrix, double)] -->
-Matrix operator/(const Matrix &A, double s) {
-    Matrix C(A.rows(), A.cols());
-    std::transform(A.begin(), A.end(), C.begin(),
-                   [s](double a) { return a / s; });
-    return C;
-}
-//! <!-- [operator/(Matrix, double)] -->
-
 void operator/=(Matrix &A, double s) {
-    std::transform(A.begin(), A.end(), A.begin(),
-                   [s](double a) { return a / s; });
+    kernels::simd().div_scalar(A.num_elems(), A.data(), s, A.data());
 }
 Matrix &&operator/(Matrix &&A, double s) {
     A /= s;
     return std::move(A);
 }
-Vector operator/(const Vector &a, double s) {
-    return Vector(static_cast<const Matrix &>(a) / s);
-}
-RowVector operator/(const RowVector &a, double s) {
-    return RowVector(static_cast<const Matrix &>(a) / s);
-}
-SquareMatrix operator/(const SquareMatrix &a, double s) {
-    return SquareMatrix(static_cast<const Matrix &>(a) / s);
-}
 Vector &&operator/(Vector &&a, double s) {
     static_cast<Matrix &>(a) /= s;
     return std::move(a);
@@ -1029,30 +1067,16 @@ SquareMatrix &&operator/(SquareMatrix &&a, double s) {
  */
 //! <!-- [explicit_transpose] -->
 Matrix explicit_transpose(const Matrix &in) {
-    Matrix out(in.cols(), in.rows());
-    for (size_t n = 0; n < in.rows(); ++n)
-        for (size_t m = 0; m < in.cols(); ++m)
-            out(m, n) = in(n, m);
+    // The result has the same storage order as the input, so that the
+    // transposition kernel can use its tiled, vectorized path.
+    Matrix out(in.cols(), in.rows(), in.storage_order());
+    kernels::transpose(in.rows(), in.cols(),                        //
+                       in.data(), in.row_stride(), in.col_stride(), //
+                       out.data(), out.row_stride(), out.col_stride());
     return out;
 }
 //! <!-- [explicit_transpose] -->
 
-/**
- * ## Implementation
- * @snippet this transpose(const Matrix &)
- */
-//! <!-- [transpose(const Matrix &)] -->
-Matrix transpose(const Matrix &in) {
-    if (in.rows() == 1 || in.cols() == 1) { // Vectors
-        Matrix out = in;
-        out.reshape(in.cols(), in.rows());
-        return out;
-    } else { // General matrices (square and rectangular)
-        return explicit_transpose(in);
-    }
-}
-//! <!-- [transpose(const Matrix &)] -->
-
 /**
  * ## Implementation
  * @snippet this transpose(Matrix &&)
@@ -1064,16 +1088,11 @@ Matrix &&transpose(Matrix &&in) {
     else if (in.rows() == 1 || in.cols() == 1) // Vectors
         in.reshape(in.cols(), in.rows());      //     → reshape row ↔ column
     else                                       // General rectangular matrices
-        in = explicit_transpose(in);           //     → full transpose
+        transpose_inplace_rectangular(in);     //     → reuse storage
     return std::move(in);
 }
 //! <!-- [transpose(Matrix &&)] -->
 
-SquareMatrix transpose(const SquareMatrix &in) {
-    SquareMatrix out = in;
-    out.transpose_inplace();
-    return out;
-}
 SquareMatrix &&transpose(SquareMatrix &&in) {
     in.transpose_inplace();
     return std::move(in);
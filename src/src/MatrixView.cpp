@@ -0,0 +1,31 @@
+#include <linalg/Matrix.hpp>
+#include <linalg/MatrixView.hpp>
+
+#include <cmath> // std::sqrt
+#include <ostream>
+
+#pragma region // Filling ------------------------------------------------------
+
+void MatrixView::fill(double value) {
+    for (size_t c = 0; c < cols(); ++c)
+        for (size_t r = 0; r < rows(); ++r)
+            (*this)(r, c) = value;
+}
+
+#pragma endregion // -----------------------------------------------------------
+
+#pragma region // Norms --------------------------------------------------------
+
+double ConstMatrixView::normFro() const {
+    return std::sqrt(Vector::dot_unchecked(*this, *this));
+}
+
+#pragma endregion // -----------------------------------------------------------
+
+#pragma region // Printing -----------------------------------------------------
+
+std::ostream &operator<<(std::ostream &os, const ConstMatrixView &view) {
+    return os << Matrix(view);
+}
+
+#pragma endregion // -----------------------------------------------------------
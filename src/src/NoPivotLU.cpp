@@ -1,5 +1,11 @@
 #include <linalg/NoPivotLU.hpp>
+#include <linalg/Runtime.hpp>
 
+#include "kernels/Lu.hpp"
+#include "kernels/Trsm.hpp"
+
+
+#include <algorithm> // std::min
 #include <cassert>
 
 /**
@@ -33,8 +39,43 @@ void NoPivotLU::compute_factorization() {
     // second column of L₁A (while preserving the zeros introduced by L₁), and
     // so on, until all elements below the diagonal are zero.
 
-    // Loop over all columns of A:
-    for (size_t k = 0; k < LU.cols(); ++k) {
+    // For large matrices, the columns are processed in panels of nb columns
+    // (right-looking blocked LU). Each panel is factored using the algorithm
+    // below, but the elimination steps are only applied to the columns of the
+    // panel itself. The rest of the matrix is then updated using a triangular
+    // solve and a single matrix-matrix product, see kernels/Lu.cpp.
+    // This gives the same factors, but most of the work is done by the
+    // cache-friendly matrix multiplication kernel.
+    size_t nb = get_lu_block_size();
+    if (nb == 0 || LU.cols() < 8 * nb) {
+        compute_panel_factorization(0, LU.cols());
+    } else {
+        const size_t n = LU.cols(), rs = LU.row_stride(), cs = LU.col_stride();
+        for (size_t k = 0; k < n; k += nb) {
+            size_t b = std::min(nb, n - k);
+            compute_panel_factorization(k, b);
+            if (k + b < n)
+                kernels::lu_trailing_update(n, k, b, LU.data(), rs, cs);
+        }
+    }
+    state = Factored;
+}
+//! <!-- [NoPivotLU::compute_factorization] -->
+
+/**
+ * @pre     Columns 0 through `k - 1` have been factored, and the remaining
+ *          columns have been updated accordingly.
+ * @post    Columns `k` through `k + b - 1` are factored, columns `k + b`
+ *          and up have not been updated.
+ * 
+ * ## Implementation
+ * @snippet this NoPivotLU::compute_panel_factorization
+ */
+//! <!-- [NoPivotLU::compute_panel_factorization] -->
+void NoPivotLU::compute_panel_factorization(size_t k_begin, size_t b) {
+    size_t k_end = k_begin + b;
+    // Loop over all columns of the panel:
+    for (size_t k = k_begin; k < k_end; ++k) {
         // In the following comments, k = [1, n], because this is more intuitive
         // and it follows the usual mathematical convention.
         // In the code, however, array indices start at zero, so k = [0, n-1].
@@ -141,11 +182,18 @@ void NoPivotLU::compute_factorization() {
         // updated.
 
         // Update the trailing submatrix A'(k+1:n,k+1:n) = LₖA(k+1:n,k+1:n):
-        for (size_t c = k + 1; c < LU.cols(); ++c)
+        // Only the columns of the current panel are updated here, the columns
+        // to the right of it are updated all at once by
+        // kernels::lu_trailing_update.
+        const size_t rs = LU.row_stride(), len = LU.rows() - k - 1;
+        for (size_t c = k + 1; c < k_end; ++c) {
+            const double *l_k = &LU(k + 1, k);
+            double *a_c = &LU(k + 1, c), u_kc = LU(k, c);
             // Subtract lᵢₖ times the current pivot row A(k,:):
-            for (size_t i = k + 1; i < LU.rows(); ++i)
+            for (size_t i = 0; i < len; ++i)
                 // A'(i,c) = 1·A(i,c) - lᵢₖ·A(k,c)
-                LU(i, c) -= LU(i, k) * LU(k, c);
+                a_c[i * rs] -= l_k[i * rs] * u_kc;
+        }
 
         // We won't handle this here explicitly, but notice how the algorithm
         // fails when the value of the pivot is zero (or very small), as this
@@ -159,16 +207,15 @@ void NoPivotLU::compute_factorization() {
         // factorization, it fails.
         // Zero pivots occur even when the matrix is non-singular.
     }
-    state = Factored;
 }
-//! <!-- [NoPivotLU::compute_factorization] -->
+//! <!-- [NoPivotLU::compute_panel_factorization] -->
 
 /**
  * ## Implementation
  * @snippet this NoPivotLU::back_subs
  */
 //! <!-- [NoPivotLU::back_subs] -->
-void NoPivotLU::back_subs(const Matrix &B, Matrix &X) const {
+void NoPivotLU::back_subs(Matrix &B) const {
     // Solve upper triangular system UX = B by solving each column of B as a
     // vector system Uxᵢ = bᵢ
     //
@@ -183,15 +230,15 @@ void NoPivotLU::back_subs(const Matrix &B, Matrix &X) const {
     // b₃ᵢ = u₃₃·x₃ᵢ + u₃₄·x₄ᵢ           ⟺ x₃ᵢ = (b₃ᵢ - u₃₄·x₄ᵢ)/u₃₃
     // b₂ᵢ = u₂₂·x₂ᵢ + u₂₃·x₃ᵢ + u₂₄·x₄ᵢ ⟺ x₂ᵢ = (b₂ᵢ - u₂₃·x₃ᵢ + u₂₄·x₄ᵢ)/u₂₂
     // ...
+    //
+    // Rather than solving one column at a time, the triangular solve kernel
+    // solves blocks of rows of all columns at once, and applies the
+    // off-diagonal blocks of U using matrix-matrix products.
 
-    for (size_t i = 0; i < B.cols(); ++i) {
-        for (size_t r = LU.rows(); r-- > 0;) {
-            X(r, i) = B(r, i);
-            for (size_t c = r + 1; c < LU.cols(); ++c)
-                X(r, i) -= LU(r, c) * X(c, i);
-            X(r, i) /= LU(r, r);
-        }
-    }
+    kernels::trsm(Side::Left, Triangle::Upper, Diagonal::NonUnit,  //
+                  LU.rows(), B.cols(),                             //
+                  LU.data(), LU.row_stride(), LU.col_stride(),     //
+                  B.data(), B.row_stride(), B.col_stride());
 }
 //! <!-- [NoPivotLU::back_subs] -->
 
@@ -200,7 +247,7 @@ void NoPivotLU::back_subs(const Matrix &B, Matrix &X) const {
  * @snippet this NoPivotLU::forward_subs
  */
 //! <!-- [NoPivotLU::forward_subs] -->
-void NoPivotLU::forward_subs(const Matrix &B, Matrix &X) const {
+void NoPivotLU::forward_subs(Matrix &B) const {
     // Solve lower triangular system LX = B by solving each column of B as a
     // vector system Lxᵢ = bᵢ.
     // The diagonal is always 1, due to the construction of the L matrix in the
@@ -217,14 +264,14 @@ void NoPivotLU::forward_subs(const Matrix &B, Matrix &X) const {
     // b₂ᵢ = l₂₁·x₁ᵢ +   1·x₂ᵢ         ⟺ x₂ᵢ = b₂ᵢ - l₂₁·x₁ᵢ
     // b₃ᵢ = l₃₁·x₁ᵢ + l₃₂·x₂ᵢ + 1·x₃ᵢ ⟺ x₃ᵢ = b₃ᵢ - l₃₂·x₂ᵢ - l₃₁·x₁ᵢ
     // ...
+    //
+    // As in back_subs, all columns are solved at once by the blocked
+    // triangular solve kernel, which never accesses the diagonal of L.
 
-    for (size_t i = 0; i < B.cols(); ++i) {
-        for (size_t r = 0; r < LU.rows(); ++r) {
-            X(r, i) = B(r, i);
-            for (size_t c = 0; c < r; ++c)
-                X(r, i) -= LU(r, c) * X(c, i);
-        }
-    }
+    kernels::trsm(Side::Left, Triangle::Lower, Diagonal::Unit,     //
+                  LU.rows(), B.cols(),                             //
+                  LU.data(), LU.row_stride(), LU.col_stride(),     //
+                  B.data(), B.row_stride(), B.col_stride());
 }
 //! <!-- [NoPivotLU::forward_subs] -->
 
@@ -242,8 +289,8 @@ void NoPivotLU::solve_inplace(Matrix &B) const {
     // system of equations.
     assert(is_factored());
 
-    forward_subs(B, B); // overwrite B with Z
-    back_subs(B, B);    // overwrite B (Z) with X
+    forward_subs(B); // overwrite B with Z
+    back_subs(B);    // overwrite B (Z) with X
 }
 //! <!-- [NoPivotLU::solve_inplace] -->
 
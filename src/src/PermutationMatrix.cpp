@@ -1,5 +1,7 @@
 #include <linalg/PermutationMatrix.hpp>
 
+#include "kernels/Laswp.hpp"
+
 #include <iomanip>
 #include <iostream>
 
@@ -26,7 +28,9 @@ PermutationMatrix::identity_permutation(size_t length) {
 }
 
 void PermutationMatrix::fill_from_permutation(Permutation permutation) {
-    resize(permutation.size());
+    const size_t n = permutation.size();
+    resize(n);
+    reverse_ = false;
     // Convert the permutation to a sequence of swaps.
     //
     // Sort the permuted sequence using selection sort, starting from the
@@ -34,27 +38,110 @@ void PermutationMatrix::fill_from_permutation(Permutation permutation) {
     // will be used as the internal representation of the permutation
     // matrix.
     //
-    // TODO: Selection sort is O(n²), is there a better way?
-    for (size_t i = size(); i-- > 0;) {
+    // Instead of searching for the next element in the unsorted sublist,
+    // which would require O(n²) operations, the position of each element is
+    // looked up in an inverse index, which is updated after every swap.
+    // This index is also used to check that the permutation is valid.
+    Permutation position(n, n);
+    for (size_t i = 0; i < n; ++i) {
+        assert(permutation[i] < n && "Invalid permutation");
+        assert(position[permutation[i]] == n && "Invalid permutation");
+        position[permutation[i]] = i;
+    }
+    for (size_t i = n; i-- > 0;) {
         // Boundaries of the sorted and unsorted sublists:
         // | unsorted | sorted |
-        auto unsorted_begin = permutation.begin();
-        auto unsorted_end = permutation.begin() + i + 1; // one-past-end
-        // Find the element that comes at the i-th place in the sorted list:
-        auto next_element = std::find(unsorted_begin, unsorted_end, i);
-        // Ensure the number exists in the list. If it doesn't, the list
-        // didn't contain a valid permutation in the first place.
-        assert(next_element != unsorted_end && "Invalid permutation");
-        // Find the index of that element:
-        auto swap_idx = next_element - permutation.begin();
-        // Swap it with the current element, so the *next_element is in the
-        // correct place for a sorted list:
-        std::swap(permutation[i], *next_element);
+        // Find the index of the element that comes at the i-th place in the
+        // sorted list (it is always in the unsorted sublist):
+        size_t swap_idx = position[i];
+        // Swap it with the current element, so it's in the correct place for
+        // a sorted list, and update the position of the element that was
+        // moved out of the way:
+        std::swap(permutation[i], permutation[swap_idx]);
+        position[permutation[swap_idx]] = swap_idx;
         // Record the swap:
         (*this)(i) = swap_idx;
     }
 }
 
+PermutationMatrix::Permutation
+PermutationMatrix::inverse_permutation(const Permutation &p) {
+    Permutation q(p.size());
+    for (size_t i = 0; i < p.size(); ++i)
+        q[p[i]] = i;
+    return q;
+}
+
+PermutationMatrix PermutationMatrix::inverse() const {
+    // If P gathers the rows (or columns) of A using the permutation p, its
+    // inverse gathers them using the inverse permutation of p.
+    return from_permutation(inverse_permutation(to_permutation()), type);
+}
+
+void PermutationMatrix::permute_columns(Matrix &A) const {
+    assert(A.cols() == size());
+    assert(get_type() != RowPermutation);
+    // Swapping columns of A is the same as swapping rows of Aᵀ, which is A
+    // with its row and column strides swapped.
+    kernels::laswp(A.rows(), A.data(), A.col_stride(), A.row_stride(),
+                   storage.data(), 0, size(), is_reversed());
+}
+
+void PermutationMatrix::permute_rows(Matrix &A) const {
+    assert(A.rows() == size());
+    assert(get_type() != ColumnPermutation);
+    kernels::laswp(A.cols(), A.data(), A.row_stride(), A.col_stride(),
+                   storage.data(), 0, size(), is_reversed());
+}
+
+void PermutationMatrix::permute_columns(const Matrix &A, Matrix &B) const {
+    assert(A.cols() == size());
+    assert(B.rows() == A.rows() && B.cols() == A.cols());
+    assert(&A != &B);
+    assert(get_type() != RowPermutation);
+    // The i-th column of the result is column p[i] of A.
+    Permutation p = to_permutation();
+    for (size_t c = 0; c < B.cols(); ++c)
+        for (size_t r = 0; r < B.rows(); ++r)
+            B(r, c) = A(r, p[c]);
+}
+
+void PermutationMatrix::permute_rows(const Matrix &A, Matrix &B) const {
+    assert(A.rows() == size());
+    assert(B.rows() == A.rows() && B.cols() == A.cols());
+    assert(&A != &B);
+    assert(get_type() != ColumnPermutation);
+    // The i-th row of the result is row p[i] of A.
+    Permutation p = to_permutation();
+    for (size_t c = 0; c < B.cols(); ++c)
+        for (size_t r = 0; r < B.rows(); ++r)
+            B(r, c) = A(p[r], c);
+}
+
+PermutationMatrix compose(const PermutationMatrix &P,
+                          const PermutationMatrix &Q) {
+    using Type = PermutationMatrix::Type;
+    assert(P.size() == Q.size());
+    assert(P.get_type() == Q.get_type() ||
+           P.get_type() == PermutationMatrix::Unspecified ||
+           Q.get_type() == PermutationMatrix::Unspecified);
+    Type type = P.get_type() != PermutationMatrix::Unspecified ? P.get_type()
+                                                                : Q.get_type();
+    // Row permutations gather rows: (P·Q·A)(i) = (Q·A)(p[i]) = A(q[p[i]]).
+    // Column permutations gather columns: (A·P·Q)(i) = (A·P)(q[i]) =
+    // A(p[q[i]]).
+    PermutationMatrix::Permutation p = P.to_permutation();
+    PermutationMatrix::Permutation q = Q.to_permutation();
+    PermutationMatrix::Permutation r(p.size());
+    if (type == PermutationMatrix::ColumnPermutation)
+        for (size_t i = 0; i < r.size(); ++i)
+            r[i] = p[q[i]];
+    else
+        for (size_t i = 0; i < r.size(); ++i)
+            r[i] = q[p[i]];
+    return PermutationMatrix::from_permutation(std::move(r), type);
+}
+
 // LCOV_EXCL_START
 
 void PermutationMatrix::print(std::ostream &os, uint8_t precision,
@@ -0,0 +1,246 @@
+#include <linalg/PivotedHouseholderQR.hpp>
+#include <linalg/Runtime.hpp>
+
+#include "kernels/Householder.hpp"
+#include "kernels/Laswp.hpp"
+#include "kernels/Trsm.hpp"
+
+#include <algorithm> // std::max
+#include <cassert>
+#include <limits> // std::numeric_limits
+
+/**
+ * @pre     `RW` contains the matrix A to be factorized
+ * @pre     `RW.rows() >= RW.cols()`
+ * @pre     `R_diag.size() == RW.cols()`
+ * @pre     `P.size() == RW.cols()`
+ *
+ * @post    The strict upper-triangular part of `RW` contains the strict
+ *          upper-triangular part of factor R. `R_diag` contains the diagonal
+ *          of R, with non-increasing magnitudes.
+ * @post    The lower-triangular part (including the diagonal) of `RW` contains
+ *          the Householder reflectors wₖ, with ‖wₖ‖ = √2.
+ * @post    `apply_Q(get_R()) == A * get_P()` (up to rounding errors)
+ *
+ * @see     @ref HouseholderQR::compute_factorization() for an introduction to
+ *          Householder reflectors. The basics presented there will not be
+ *          reiterated here.
+ *
+ * ## Implementation
+ * @snippet this PivotedHouseholderQR::compute_factorization
+ */
+//! <!-- [PivotedHouseholderQR::compute_factorization] -->
+void PivotedHouseholderQR::compute_factorization() {
+    assert(RW.rows() >= RW.cols());
+    assert(R_diag.size() == RW.cols());
+    assert(P.size() == RW.cols());
+
+    // Helper function to square a number
+    auto sq = [](double x) { return x * x; };
+
+    const size_t rs = RW.row_stride();
+
+    // The algorithm is the same as the one used by HouseholderQR, but before
+    // computing the k-th reflector, the column of the trailing submatrix
+    // A[k:m,k:n] with the largest norm is swapped with the k-th column.
+    //
+    // Computing the norms of all columns of the trailing submatrix on every
+    // iteration would double the cost of the factorization. Instead, the
+    // norms are computed once, and then updated after each step: the
+    // reflector doesn't change the norm of a column, so when the first
+    // element aₖᵢ is removed from column i, its new norm is
+    //     ‖a'ᵢ‖² = ‖aᵢ‖² - aₖᵢ²
+    // This is subject to cancellation when aₖᵢ makes up most of the norm, in
+    // which case the norm is recomputed explicitly (like LAPACK's DGEQP3).
+    auto column_norm = [&](size_t k, size_t c) {
+        double sq_norm = 0;
+        const double *a = &RW(k, c);
+        for (size_t i = 0; i < RW.rows() - k; ++i)
+            sq_norm += sq(a[i * rs]);
+        return std::sqrt(sq_norm);
+    };
+    for (size_t c = 0; c < RW.cols(); ++c)
+        norms(c) = norms_ref(c) = column_norm(0, c);
+    const double tol_recompute =
+        std::sqrt(std::numeric_limits<double>::epsilon());
+
+    for (size_t k = 0; k < RW.cols(); ++k) {
+        // Find the column with the largest norm
+        size_t max_index = k;
+        for (size_t c = k + 1; c < RW.cols(); ++c)
+            if (norms(c) > norms(max_index))
+                max_index = c;
+
+        // Swap it with the k-th column (all rows, so that the columns of R
+        // are permuted as well), and record the swap:
+        P(k) = max_index;
+        if (max_index != k) {
+            RW.swap_columns(k, max_index);
+            std::swap(norms(k), norms(max_index));
+            std::swap(norms_ref(k), norms_ref(max_index));
+        }
+
+        // Compute the reflector wₖ for the column x = A[k:m,k], exactly as in
+        // HouseholderQR.
+        double norm_x    = column_norm(k, k);
+        double sq_norm_x = sq(norm_x);
+        double &x_0      = RW(k, k);
+        if (norm_x >= std::numeric_limits<double>::min() * 2) {
+            double x_p = -std::copysign(norm_x, x_0); // -sign(x₀)·‖x‖
+            double v_0 = x_0 - x_p;
+            double norm_v_sq2 = std::sqrt(std::abs(x_0) * norm_x + sq_norm_x);
+            x_0 = v_0;
+            for (size_t i = k; i < RW.rows(); ++i)
+                RW(i, k) /= norm_v_sq2;
+            R_diag(k) = x_p;
+        } else {
+            x_0       = std::sqrt(2);
+            R_diag(k) = 0;
+        }
+
+        // Apply the reflector H = I - wₖ·wₖᵀ to the trailing columns, and
+        // update their norms:
+        const double *w_k = &RW(k, k);
+        const size_t len  = RW.rows() - k;
+        for (size_t c = k + 1; c < RW.cols(); ++c) {
+            double *a_i = &RW(k, c);
+            // Compute wₖᵀ·aᵢ
+            double dot_product = 0;
+            for (size_t r = 0; r < len; ++r)
+                dot_product += w_k[r * rs] * a_i[r * rs];
+            // Subtract wₖ·wₖᵀ·aᵢ
+            for (size_t r = 0; r < len; ++r)
+                a_i[r * rs] -= w_k[r * rs] * dot_product;
+
+            // Remove the element in row k, which now belongs to R, from the
+            // norm of column i:
+            if (norms(c) == 0)
+                continue;
+            double ratio = std::abs(a_i[0]) / norms(c);
+            double temp  = std::max(0., (1 - ratio) * (1 + ratio));
+            // Relative size of the updated norm compared to the last norm
+            // that was computed explicitly:
+            double rel = temp * sq(norms(c) / norms_ref(c));
+            if (rel <= tol_recompute) {
+                norms(c) = norms_ref(c) =
+                    k + 1 < RW.rows() ? column_norm(k + 1, c) : 0;
+            } else {
+                norms(c) *= std::sqrt(temp);
+            }
+        }
+    }
+    state = Factored;
+}
+//! <!-- [PivotedHouseholderQR::compute_factorization] -->
+
+/**
+ * ## Implementation
+ * @snippet this PivotedHouseholderQR::apply_QT_inplace
+ */
+//! <!-- [PivotedHouseholderQR::apply_QT_inplace] -->
+void PivotedHouseholderQR::apply_QT_inplace(Matrix &B) const {
+    assert(is_factored());
+    assert(RW.rows() == B.rows());
+    // The reflectors are stored in the same way as in HouseholderQR, so they
+    // are applied by the same (blocked) code, see kernels/Householder.cpp.
+    kernels::apply_reflectors(RW, B, get_qr_block_size(), true);
+}
+//! <!-- [PivotedHouseholderQR::apply_QT_inplace] -->
+
+/**
+ * ## Implementation
+ * @snippet this PivotedHouseholderQR::apply_Q_inplace
+ */
+//! <!-- [PivotedHouseholderQR::apply_Q_inplace] -->
+void PivotedHouseholderQR::apply_Q_inplace(Matrix &X) const {
+    assert(is_factored());
+    assert(RW.rows() == X.rows());
+    // The reflectors are stored in the same way as in HouseholderQR, so they
+    // are applied by the same (blocked) code, see kernels/Householder.cpp.
+    kernels::apply_reflectors(RW, X, get_qr_block_size(), false);
+}
+//! <!-- [PivotedHouseholderQR::apply_Q_inplace] -->
+
+/**
+ * ## Implementation
+ * @snippet this PivotedHouseholderQR::get_rank
+ */
+//! <!-- [PivotedHouseholderQR::get_rank] -->
+size_t PivotedHouseholderQR::get_rank(double tolerance) const {
+    assert(is_factored());
+    // Because of the column pivoting, the magnitudes of the diagonal elements
+    // of R are non-increasing, so the rank is the number of leading diagonal
+    // elements that are larger than the threshold.
+    if (R_diag.size() == 0)
+        return 0;
+    double threshold = tolerance * std::abs(R_diag(0));
+    size_t rank      = 0;
+    while (rank < R_diag.size() && std::abs(R_diag(rank)) > threshold)
+        ++rank;
+    return rank;
+}
+//! <!-- [PivotedHouseholderQR::get_rank] -->
+
+double PivotedHouseholderQR::default_tolerance() const {
+    return std::max(RW.rows(), RW.cols()) *
+           std::numeric_limits<double>::epsilon();
+}
+
+/**
+ * ## Implementation
+ * @snippet this PivotedHouseholderQR::back_subs
+ */
+//! <!-- [PivotedHouseholderQR::back_subs] -->
+void PivotedHouseholderQR::back_subs(const Matrix &B, Matrix &X,
+                                     size_t r) const {
+    // Solve the upper triangular system R₁₁X₁ = B₁ of the first r rows, see
+    // HouseholderQR::back_subs, and set the remaining rows of X to zero.
+    const size_t n = RW.cols();
+    if (&X != &B)
+        X.block(0, 0, r, B.cols()) = B.block(0, 0, r, B.cols());
+    X.block(r, 0, n - r, X.cols()).fill(0);
+    kernels::trsm(Side::Left, Triangle::Upper, Diagonal::NonUnit, //
+                  r, X.cols(),                                    //
+                  RW.data(), RW.row_stride(), RW.col_stride(),    //
+                  X.data(), X.row_stride(), X.col_stride(),       //
+                  R_diag.data());
+}
+//! <!-- [PivotedHouseholderQR::back_subs] -->
+
+/**
+ * ## Implementation
+ * @snippet this PivotedHouseholderQR::solve_inplace
+ */
+//! <!-- [PivotedHouseholderQR::solve_inplace] -->
+void PivotedHouseholderQR::solve_inplace(Matrix &B) const {
+    // If AX ≈ B, then QRPᵀX ≈ B. Let Y = PᵀX, then RY ≈ QᵀB, so first apply
+    // Qᵀ to B:
+    apply_QT_inplace(B);
+
+    // Only the first r columns of AP are linearly independent, so solve
+    // R₁₁Y₁ = (QᵀB)₁ using back substitution, and set Y₂ = 0.
+    size_t r = get_rank();
+
+    // If the matrix is square, B and X have the same size, so we can reuse B's
+    // storage if we operate on B directly:
+    if (RW.cols() == RW.rows()) {
+        back_subs(B, B, r);
+    }
+    // If the matrix is rectangular, the sizes of B and X differ, so use a
+    // separate result variable:
+    else {
+        Matrix X(RW.cols(), B.cols());
+        back_subs(B, X, r);
+        B = std::move(X);
+    }
+
+    // Finally, X = PY. The permutation AP applies the swaps in P to the
+    // columns of A in forward order, so PY applies them to the rows of Y in
+    // reverse order.
+    kernels::laswp(B.cols(), B.data(), B.row_stride(), B.col_stride(),
+                   P.data(), 0, P.size(), true);
+}
+//! <!-- [PivotedHouseholderQR::solve_inplace] -->
+
+// All implementations of the less interesting functions can be found here:
+#include "boilerplate/PivotedHouseholderQR.ipp"
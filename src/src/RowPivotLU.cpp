@@ -1,7 +1,30 @@
 #include <linalg/RowPivotLU.hpp>
+#include <linalg/Runtime.hpp>
 
+#include "kernels/Laswp.hpp"
+#include "kernels/Lu.hpp"
+#include "kernels/Trsm.hpp"
+
+#include <algorithm> // std::min, std::swap
+#include <atomic>    // std::atomic
 #include <cassert>
 
+namespace {
+
+/// Number of columns per panel of the blocked factorizations, see
+/// @ref set_lu_block_size.
+std::atomic<size_t> lu_block_size{32};
+
+} // namespace
+
+void set_lu_block_size(size_t nb) {
+    lu_block_size.store(nb, std::memory_order_relaxed);
+}
+
+size_t get_lu_block_size() {
+    return lu_block_size.load(std::memory_order_relaxed);
+}
+
 /**
  * @pre     `LU` contains the matrix A to be factorized
  * @pre     `P` contains the identity matrix (no permutations)
@@ -42,8 +65,56 @@ void RowPivotLU::compute_factorization() {
     // pivot, rows are swapped so that the element with the largest magnitude
     // ends up on the diagonal and can be used as the pivot.
 
-    // Loop over all columns of A:
-    for (size_t k = 0; k < LU.cols(); ++k) {
+    // For large matrices, the columns are processed in panels of nb columns
+    // (right-looking blocked LU). Each panel is factored using the algorithm
+    // below, but the elimination steps are only applied to the columns of the
+    // panel itself. The rest of the matrix is then updated using a triangular
+    // solve and a single matrix-matrix product, see kernels/Lu.cpp.
+    // This gives the same factors, but most of the work is done by the
+    // cache-friendly matrix multiplication kernel.
+    // Similarly, the row swaps of a panel are applied to the columns outside
+    // of the panel all at once, after the panel has been factored, rather
+    // than swapping entire rows one pivot at a time.
+    size_t nb = get_lu_block_size();
+    if (nb == 0 || LU.cols() < 8 * nb) {
+        compute_panel_factorization(0, LU.cols());
+    } else {
+        const size_t n = LU.cols(), rs = LU.row_stride(), cs = LU.col_stride();
+        for (size_t k = 0; k < n; k += nb) {
+            size_t b = std::min(nb, n - k);
+            compute_panel_factorization(k, b);
+            // Apply the swaps of this panel to the columns on its left …
+            kernels::laswp(k, &LU(0, 0), rs, cs, P.data(), k, k + b, false);
+            // … and to the columns on its right.
+            if (k + b < n) {
+                kernels::laswp(n - k - b, &LU(0, k + b), rs, cs, P.data(), k,
+                               k + b, false);
+                kernels::lu_trailing_update(n, k, b, LU.data(), rs, cs);
+            }
+        }
+    }
+    state = Factored;
+    valid_LU = true;
+    valid_P = true;
+}
+//! <!-- [RowPivotLU::compute_factorization] -->
+
+/**
+ * @pre     Columns 0 through `k - 1` have been factored, and the remaining
+ *          columns have been updated accordingly.
+ * @post    Columns `k` through `k + b - 1` are factored, columns `k + b`
+ *          and up have not been updated.
+ * @post    Rows are swapped within the columns of the panel only, the
+ *          swaps are stored in `P(k)` through `P(k + b - 1)`.
+ * 
+ * ## Implementation
+ * @snippet this RowPivotLU::compute_panel_factorization
+ */
+//! <!-- [RowPivotLU::compute_panel_factorization] -->
+void RowPivotLU::compute_panel_factorization(size_t k_begin, size_t b) {
+    size_t k_end = k_begin + b;
+    // Loop over all columns of the panel:
+    for (size_t k = k_begin; k < k_end; ++k) {
         // In the following comments, k = [1, n], because this is more intuitive
         // and it follows the usual mathematical convention.
         // In the code, however, array indices start at zero, so k = [0, n-1].
@@ -70,11 +141,17 @@ void RowPivotLU::compute_factorization() {
         // the new pivot index.
         // If this index is not the diagonal element, rows have to be swapped:
         if (max_index != k) {
-            P(k) = max_index;           // save the permutation
-            LU.swap_rows(k, max_index); // actually perfrom the permutation
+            P(k) = max_index; // save the permutation
+            // actually perfrom the permutation (for the columns of the panel,
+            // the other columns are swapped later, see compute_factorization)
+            for (size_t c = k_begin; c < k_end; ++c)
+                std::swap(LU(k, c), LU(max_index, c));
         }
 
-        // Note how all columns of the two rows are permuted, not just the
+        // Only the columns of the current panel are swapped here. Once the
+        // whole panel has been factored, compute_factorization applies all of
+        // its swaps to the columns on its left and right at once, using laswp.
+        // Eventually, all columns of the two rows are permuted, not just the
         // columns greater than k. You might wonder how that'll ever work out
         // correctly in the end.
         // Recall that for the LU factorization without pivoting, the result was
@@ -113,6 +190,9 @@ void RowPivotLU::compute_factorization() {
         // The factors Lₖ' are computed implicitly by applying the row
         // permutations to the entire matrix that stores both the U and L
         // factors, rather than just to the elements of the trailing submatrix.
+        // Deferring the swaps of the columns outside of the panel doesn't
+        // change this: those columns aren't read or written while the panel
+        // is being factored.
 
         // The rest of the algorithm is identical to the one explained in
         // NoPivotLU.cpp.
@@ -124,29 +204,33 @@ void RowPivotLU::compute_factorization() {
             LU(i, k) /= pivot;
 
         // Update the trailing submatrix A'(k+1:n,k+1:n) = LₖA(k+1:n,k+1:n):
-        for (size_t c = k + 1; c < LU.cols(); ++c)
+        // Only the columns of the current panel are updated here, the columns
+        // to the right of it are updated all at once by
+        // kernels::lu_trailing_update.
+        const size_t rs = LU.row_stride(), len = LU.rows() - k - 1;
+        for (size_t c = k + 1; c < k_end; ++c) {
+            const double *l_k = &LU(k + 1, k);
+            double *a_c = &LU(k + 1, c), u_kc = LU(k, c);
             // Subtract lᵢₖ times the current pivot row A(k,:):
-            for (size_t i = k + 1; i < LU.rows(); ++i)
+            for (size_t i = 0; i < len; ++i)
                 // A'(i,c) = 1·A(i,c) - lᵢₖ·A(k,c)
-                LU(i, c) -= LU(i, k) * LU(k, c);
+                a_c[i * rs] -= l_k[i * rs] * u_kc;
+        }
 
         // Because of the row pivoting, zero pivots are no longer an issue,
         // since the pivot is always chosen to be the largest possible element.
         // When the matrix is singular, the algorithm will still fail, of
         // course.
     }
-    state = Factored;
-    valid_LU = true;
-    valid_P = true;
 }
-//! <!-- [RowPivotLU::compute_factorization] -->
+//! <!-- [RowPivotLU::compute_panel_factorization] -->
 
 /**
  * ## Implementation
  * @snippet this RowPivotLU::back_subs
  */
 //! <!-- [RowPivotLU::back_subs] -->
-void RowPivotLU::back_subs(const Matrix &B, Matrix &X) const {
+void RowPivotLU::back_subs(Matrix &B) const {
     // Solve upper triangular system UX = B by solving each column of B as a
     // vector system Uxᵢ = bᵢ
     //
@@ -161,15 +245,15 @@ void RowPivotLU::back_subs(const Matrix &B, Matrix &X) const {
     // b₃ᵢ = u₃₃·x₃ᵢ + u₃₄·x₄ᵢ           ⟺ x₃ᵢ = (b₃ᵢ - u₃₄·x₄ᵢ)/u₃₃
     // b₂ᵢ = u₂₂·x₂ᵢ + u₂₃·x₃ᵢ + u₂₄·x₄ᵢ ⟺ x₂ᵢ = (b₂ᵢ - u₂₃·x₃ᵢ + u₂₄·x₄ᵢ)/u₂₂
     // ...
+    //
+    // Rather than solving one column at a time, the triangular solve kernel
+    // solves blocks of rows of all columns at once, and applies the
+    // off-diagonal blocks of U using matrix-matrix products.
 
-    for (size_t i = 0; i < B.cols(); ++i) {
-        for (size_t r = LU.rows(); r-- > 0;) {
-            X(r, i) = B(r, i);
-            for (size_t c = r + 1; c < LU.cols(); ++c)
-                X(r, i) -= LU(r, c) * X(c, i);
-            X(r, i) /= LU(r, r);
-        }
-    }
+    kernels::trsm(Side::Left, Triangle::Upper, Diagonal::NonUnit,  //
+                  LU.rows(), B.cols(),                             //
+                  LU.data(), LU.row_stride(), LU.col_stride(),     //
+                  B.data(), B.row_stride(), B.col_stride());
 }
 //! <!-- [RowPivotLU::back_subs] -->
 
@@ -178,7 +262,7 @@ void RowPivotLU::back_subs(const Matrix &B, Matrix &X) const {
  * @snippet this RowPivotLU::forward_subs
  */
 //! <!-- [RowPivotLU::forward_subs] -->
-void RowPivotLU::forward_subs(const Matrix &B, Matrix &X) const {
+void RowPivotLU::forward_subs(Matrix &B) const {
     // Solve lower triangular system LX = B by solving each column of B as a
     // vector system Lxᵢ = bᵢ.
     // The diagonal is always 1, due to the construction of the L matrix in the
@@ -195,14 +279,14 @@ void RowPivotLU::forward_subs(const Matrix &B, Matrix &X) const {
     // b₂ᵢ = l₂₁·x₁ᵢ +   1·x₂ᵢ         ⟺ x₂ᵢ = b₂ᵢ - l₂₁·x₁ᵢ
     // b₃ᵢ = l₃₁·x₁ᵢ + l₃₂·x₂ᵢ + 1·x₃ᵢ ⟺ x₃ᵢ = b₃ᵢ - l₃₂·x₂ᵢ - l₃₁·x₁ᵢ
     // ...
+    //
+    // As in back_subs, all columns are solved at once by the blocked
+    // triangular solve kernel, which never accesses the diagonal of L.
 
-    for (size_t i = 0; i < B.cols(); ++i) {
-        for (size_t r = 0; r < LU.rows(); ++r) {
-            X(r, i) = B(r, i);
-            for (size_t c = 0; c < r; ++c)
-                X(r, i) -= LU(r, c) * X(c, i);
-        }
-    }
+    kernels::trsm(Side::Left, Triangle::Lower, Diagonal::Unit,     //
+                  LU.rows(), B.cols(),                             //
+                  LU.data(), LU.row_stride(), LU.col_stride(),     //
+                  B.data(), B.row_stride(), B.col_stride());
 }
 //! <!-- [RowPivotLU::forward_subs] -->
 
@@ -221,8 +305,8 @@ void RowPivotLU::solve_inplace(Matrix &B) const {
     assert(is_factored());
 
     P.permute_rows(B);
-    forward_subs(B, B); // overwrite B with Z
-    back_subs(B, B);    // overwrite B (Z) with X
+    forward_subs(B); // overwrite B with Z
+    back_subs(B);    // overwrite B (Z) with X
 }
 //! <!-- [RowPivotLU::solve_inplace] -->
 
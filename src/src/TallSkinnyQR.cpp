@@ -0,0 +1,236 @@
+#include <linalg/TallSkinnyQR.hpp>
+
+#include "kernels/ThreadPool.hpp"
+#include "kernels/Trsm.hpp"
+
+#include <algorithm> // std::max
+#include <cassert>
+
+namespace {
+
+/// Number of elements of a block of rows that fits in the L2 cache
+/// (256 KiB of doubles).
+constexpr size_t l2_block_elems = 32768;
+
+/// Copy the n×n upper-triangular R factor of the given factorization to rows
+/// [`row`, `row` + n) of S. The elements below the diagonal are not written.
+void copy_R(const HouseholderQR &qr, Matrix &S, size_t row) {
+    const Matrix &RW     = qr.get_RW();
+    const Vector &R_diag = qr.get_R_diag();
+    for (size_t c = 0; c < RW.cols(); ++c) {
+        for (size_t r = 0; r < c; ++r)
+            S(row + r, c) = RW(r, c);
+        S(row + c, c) = R_diag(c);
+    }
+}
+
+} // namespace
+
+/**
+ * ## Implementation
+ * @snippet this TallSkinnyQR::compute
+ */
+//! <!-- [TallSkinnyQR::compute] -->
+void TallSkinnyQR::compute(const Matrix &A) {
+    assert(A.rows() >= A.cols());
+    const size_t m = A.rows(), n = A.cols();
+    kernels::ThreadPool &pool = kernels::ThreadPool::instance();
+
+    // Split the rows into blocks of (at least) b rows, the last block gets the
+    // remaining rows. Each block needs at least n rows, so that its R factor
+    // is square.
+    size_t b = block_rows;
+    if (b == 0)
+        b = std::max(2 * n, l2_block_elems / std::max(n, size_t(1)));
+    b = std::max(b, std::max(n, size_t(1)));
+    const size_t num_leaves = std::max(m / b, size_t(1));
+
+    // Factor all blocks independently:
+    //
+    //     ┌    ┐   ┌               ┐┌    ┐
+    //     │ A₀ │   │ Q₀            ││ R₀ │
+    //     │ A₁ │ = │    Q₁         ││ R₁ │
+    //     │ A₂ │   │       Q₂      ││ R₂ │
+    //     │ A₃ │   │          Q₃   ││ R₃ │
+    //     └    ┘   └               ┘└    ┘
+    //
+    // After applying Qᵢᵀ, the rows of block i are zero, except for its first
+    // n rows, which contain Rᵢ.
+    leaves.clear();
+    leaves.resize(num_leaves);
+    for (size_t i = 0; i < num_leaves; ++i)
+        leaves[i].row = i * b;
+    pool.parallel_for(num_leaves, [&](size_t i) {
+        size_t row_end = i + 1 < num_leaves ? leaves[i + 1].row : m;
+        Matrix block(A.block(leaves[i].row, 0, row_end - leaves[i].row, n));
+        leaves[i].qr.compute(std::move(block));
+    });
+
+    // Combine the R factors pairwise, until only one is left:
+    //
+    //     ┌    ┐
+    //     │ R₀ │ = Q₀₁·R₀₁
+    //     │ R₁ │
+    //     └    ┘
+    //
+    // Each R factor is identified by the first row it occupies, and by the
+    // factorization it was computed by (a leaf or a node).
+    struct Factor {
+        size_t row;
+        const HouseholderQR *qr;
+    };
+    std::vector<Factor> active;
+    active.reserve(num_leaves);
+    for (const Leaf &leaf : leaves)
+        active.push_back({leaf.row, &leaf.qr});
+    nodes.clear();
+    nodes.reserve(num_leaves - 1); // no reallocations, so pointers stay valid
+    levels.assign(1, 0);
+    while (active.size() > 1) {
+        const size_t num_pairs = active.size() / 2;
+        const size_t first     = nodes.size();
+        nodes.resize(first + num_pairs);
+        pool.parallel_for(num_pairs, [&](size_t p) {
+            Node &node  = nodes[first + p];
+            node.top    = active[2 * p].row;
+            node.bottom = active[2 * p + 1].row;
+            Matrix S(2 * n, n);
+            copy_R(*active[2 * p].qr, S, 0);
+            copy_R(*active[2 * p + 1].qr, S, n);
+            node.qr.compute(std::move(S));
+        });
+        // The combined factor takes the place of the top one. If the number
+        // of factors is odd, the last one moves up to the next level as is.
+        std::vector<Factor> next;
+        next.reserve(num_pairs + 1);
+        for (size_t p = 0; p < num_pairs; ++p)
+            next.push_back({nodes[first + p].top, &nodes[first + p].qr});
+        if (active.size() % 2 == 1)
+            next.push_back(active.back());
+        active = std::move(next);
+        levels.push_back(nodes.size());
+    }
+
+    // The root of the tree is stored in the first rows, it's the R factor of
+    // the complete matrix.
+    R = SquareMatrix(n);
+    copy_R(*active.front().qr, R, 0);
+    rows_ = m;
+    state = Factored;
+}
+//! <!-- [TallSkinnyQR::compute] -->
+
+/**
+ * ## Implementation
+ * @snippet this TallSkinnyQR::apply_QT_inplace
+ */
+//! <!-- [TallSkinnyQR::apply_QT_inplace] -->
+void TallSkinnyQR::apply_QT_inplace(Matrix &B) const {
+    assert(is_factored());
+    assert(B.rows() == rows());
+    const size_t n = cols(), k = B.cols();
+    kernels::ThreadPool &pool = kernels::ThreadPool::instance();
+
+    // Apply the transposed Q factors in the same order in which they were
+    // computed: first the leaves, then the tree, level by level.
+    pool.parallel_for(leaves.size(), [&](size_t i) {
+        const Leaf &leaf = leaves[i];
+        MatrixView B_i   = B.block(leaf.row, 0, leaf.qr.get_RW().rows(), k);
+        Matrix block(B_i);
+        leaf.qr.apply_QT_inplace(block);
+        B_i = block;
+    });
+    for (size_t l = 0; l + 1 < levels.size(); ++l) {
+        pool.parallel_for(levels[l + 1] - levels[l], [&](size_t p) {
+            const Node &node = nodes[levels[l] + p];
+            Matrix S(2 * n, k);
+            S.block(0, 0, n, k) = B.block(node.top, 0, n, k);
+            S.block(n, 0, n, k) = B.block(node.bottom, 0, n, k);
+            node.qr.apply_QT_inplace(S);
+            B.block(node.top, 0, n, k)    = S.block(0, 0, n, k);
+            B.block(node.bottom, 0, n, k) = S.block(n, 0, n, k);
+        });
+    }
+}
+//! <!-- [TallSkinnyQR::apply_QT_inplace] -->
+
+/**
+ * ## Implementation
+ * @snippet this TallSkinnyQR::apply_Q_inplace
+ */
+//! <!-- [TallSkinnyQR::apply_Q_inplace] -->
+void TallSkinnyQR::apply_Q_inplace(Matrix &X) const {
+    assert(is_factored());
+    assert(X.rows() == rows());
+    const size_t n = cols(), k = X.cols();
+    kernels::ThreadPool &pool = kernels::ThreadPool::instance();
+
+    // Apply the Q factors in the reverse order: first the tree, from the root
+    // down, then the leaves.
+    for (size_t l = levels.size() - 1; l-- > 0;) {
+        pool.parallel_for(levels[l + 1] - levels[l], [&](size_t p) {
+            const Node &node = nodes[levels[l] + p];
+            Matrix S(2 * n, k);
+            S.block(0, 0, n, k) = X.block(node.top, 0, n, k);
+            S.block(n, 0, n, k) = X.block(node.bottom, 0, n, k);
+            node.qr.apply_Q_inplace(S);
+            X.block(node.top, 0, n, k)    = S.block(0, 0, n, k);
+            X.block(node.bottom, 0, n, k) = S.block(n, 0, n, k);
+        });
+    }
+    pool.parallel_for(leaves.size(), [&](size_t i) {
+        const Leaf &leaf = leaves[i];
+        MatrixView X_i   = X.block(leaf.row, 0, leaf.qr.get_RW().rows(), k);
+        Matrix block(X_i);
+        leaf.qr.apply_Q_inplace(block);
+        X_i = block;
+    });
+}
+//! <!-- [TallSkinnyQR::apply_Q_inplace] -->
+
+/**
+ * ## Implementation
+ * @snippet this TallSkinnyQR::back_subs
+ */
+//! <!-- [TallSkinnyQR::back_subs] -->
+void TallSkinnyQR::back_subs(const Matrix &B, Matrix &X) const {
+    // Solve upper triangular system RX = B by solving each column of B as a
+    // vector system Rxᵢ = bᵢ, see HouseholderQR::back_subs.
+    const size_t n = R.cols();
+    if (&X != &B)
+        X.block(0, 0, n, B.cols()) = B.block(0, 0, n, B.cols());
+    kernels::trsm(Side::Left, Triangle::Upper, Diagonal::NonUnit, //
+                  n, X.cols(),                                    //
+                  R.data(), R.row_stride(), R.col_stride(),       //
+                  X.data(), X.row_stride(), X.col_stride());
+}
+//! <!-- [TallSkinnyQR::back_subs] -->
+
+/**
+ * ## Implementation
+ * @snippet this TallSkinnyQR::solve_inplace
+ */
+//! <!-- [TallSkinnyQR::solve_inplace] -->
+void TallSkinnyQR::solve_inplace(Matrix &B) const {
+    // If AX = B, then QRX = B, or RX = QᵀB, so first apply Qᵀ to B:
+    apply_QT_inplace(B);
+
+    // To solve RX = QᵀB, use back substitution:
+
+    // If the matrix is square, B and X have the same size, so we can reuse B's
+    // storage if we operate on B directly:
+    if (cols() == rows()) {
+        back_subs(B, B);
+    }
+    // If the matrix is rectangular, the sizes of B and X differ, so use a
+    // separate result variable:
+    else {
+        Matrix X(cols(), B.cols());
+        back_subs(B, X);
+        B = std::move(X);
+    }
+}
+//! <!-- [TallSkinnyQR::solve_inplace] -->
+
+// All implementations of the less interesting functions can be found here:
+#include "boilerplate/TallSkinnyQR.ipp"
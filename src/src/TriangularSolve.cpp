@@ -0,0 +1,14 @@
+#include <linalg/TriangularSolve.hpp>
+
+#include "kernels/Trsm.hpp"
+
+#include <cassert>
+
+void triangular_solve(Side side, Triangle triangle, Diagonal diagonal,
+                      const ConstMatrixView &A, MatrixView B) {
+    assert(A.rows() == A.cols());
+    assert(A.rows() == (side == Side::Left ? B.rows() : B.cols()));
+    kernels::trsm(side, triangle, diagonal, B.rows(), B.cols(), //
+                  A.data(), A.row_stride(), A.col_stride(),     //
+                  B.data(), B.row_stride(), B.col_stride());
+}
@@ -0,0 +1,359 @@
+#include <linalg/UpdatableQR.hpp>
+
+#include "kernels/Gemm.hpp"
+#include "kernels/Trsm.hpp"
+
+#include <cassert>
+#include <cmath> // std::hypot, std::sqrt
+
+namespace {
+
+/// Givens rotation G = [c s; -s c].
+struct Givens {
+    double c, s;
+};
+
+/// Compute the Givens rotation that maps (a, b) to (r, 0), and overwrite a
+/// and b by r and 0.
+Givens make_givens(double &a, double &b) {
+    double r = std::hypot(a, b);
+    Givens G = r == 0 ? Givens{1, 0} : Givens{a / r, b / r};
+    a        = r;
+    b        = 0;
+    return G;
+}
+
+/// Apply the rotation G to rows p and q of M (M ← G·M), only in columns
+/// `c_begin` and up (the other columns of both rows are zero).
+void rotate_rows(Matrix &M, size_t p, size_t q, size_t c_begin, Givens G) {
+    if (c_begin >= M.cols())
+        return;
+    const size_t cs = M.col_stride(), n = M.cols() - c_begin;
+    double *x = &M(p, c_begin), *y = &M(q, c_begin);
+    for (size_t i = 0; i < n; ++i) {
+        double xi = x[i * cs], yi = y[i * cs];
+        x[i * cs] = G.c * xi + G.s * yi;
+        y[i * cs] = G.c * yi - G.s * xi;
+    }
+}
+
+/// Apply the transpose of the rotation G to columns p and q of M (M ← M·Gᵀ).
+void rotate_cols(Matrix &M, size_t p, size_t q, Givens G) {
+    const size_t rs = M.row_stride(), m = M.rows();
+    if (m == 0)
+        return;
+    double *x = &M(0, p), *y = &M(0, q);
+    for (size_t i = 0; i < m; ++i) {
+        double xi = x[i * rs], yi = y[i * rs];
+        x[i * rs] = G.c * xi + G.s * yi;
+        y[i * rs] = G.c * yi - G.s * xi;
+    }
+}
+
+/// Orthogonalize x against the columns of Q, such that x = Q·w + ρ·x', with
+/// x' a unit vector orthogonal to the columns of Q. Overwrites x by x' and w
+/// by the coefficients w, and returns ρ. If x lies in the range of Q, x' and
+/// ρ are zero.
+double orthogonalize(const Matrix &Q, Vector &x, Vector &w) {
+    const size_t m = Q.rows(), n = Q.cols();
+    const size_t rs_Q = Q.row_stride(), cs_Q = Q.col_stride();
+    w.fill(0);
+    // Classical Gram-Schmidt, twice, to make sure that the result is
+    // orthogonal to working precision ("twice is enough").
+    Vector dw(n);
+    for (int pass = 0; pass < 2; ++pass) {
+        // dw = Qᵀx
+        kernels::gemm(n, 1, m,                                         //
+                      1, Q.data(), cs_Q, rs_Q,                         //
+                      x.data(), x.row_stride(), x.col_stride(),        //
+                      0, dw.data(), dw.row_stride(), dw.col_stride());
+        // x = x - Q·dw
+        kernels::gemm(m, 1, n,                                         //
+                      -1, Q.data(), rs_Q, cs_Q,                        //
+                      dw.data(), dw.row_stride(), dw.col_stride(),     //
+                      1, x.data(), x.row_stride(), x.col_stride());
+        w += dw;
+    }
+    double rho = x.normFro();
+    if (rho == 0)
+        return 0;
+    x /= rho;
+    return rho;
+}
+
+} // namespace
+
+void UpdatableQR::compute(const Matrix &A) {
+    compute(HouseholderQR(A));
+}
+
+void UpdatableQR::compute(const HouseholderQR &qr) {
+    assert(qr.is_factored());
+    const Matrix &RW     = qr.get_RW();
+    const Vector &R_diag = qr.get_R_diag();
+    const size_t n       = RW.cols();
+    Q = qr.get_thin_Q();
+    R = Matrix(n, n);
+    for (size_t c = 0; c < n; ++c) {
+        for (size_t r = 0; r < c; ++r)
+            R(r, c) = RW(r, c);
+        R(c, c) = R_diag(c);
+    }
+    state = Factored;
+}
+
+/**
+ * ## Implementation
+ * @snippet this UpdatableQR::insert_row
+ */
+//! <!-- [UpdatableQR::insert_row] -->
+void UpdatableQR::insert_row(size_t i, const RowVector &row) {
+    assert(is_factored());
+    assert(i <= rows());
+    assert(row.size() == cols());
+    const size_t m = rows(), n = cols();
+
+    // Move the new row to the top:
+    //
+    //     ┌    ┐   ┌       ┐┌    ┐
+    //     │ aᵀ │ = │ 1   0 ││ aᵀ │
+    //     │ A  │   │ 0   Q ││ R  │
+    //     └    ┘   └       ┘└    ┘
+    //
+    // The (n+1)×n matrix H on the right is upper Hessenberg, and the
+    // (m+1)×(n+1) matrix on the left still has orthonormal columns when the
+    // first row is moved back to row i.
+    Matrix Q_ext(m + 1, n + 1), H(n + 1, n);
+    Q_ext(i, 0) = 1;
+    for (size_t c = 0; c < n; ++c) {
+        for (size_t r = 0; r < m; ++r)
+            Q_ext(r < i ? r : r + 1, c + 1) = Q(r, c);
+        H(0, c) = row(c);
+        for (size_t r = 0; r <= c; ++r)
+            H(r + 1, c) = R(r, c);
+    }
+
+    // Reduce H to upper-triangular form by zeroing its subdiagonal, from top
+    // to bottom, and apply the same rotations to Q_ext.
+    for (size_t k = 0; k < n; ++k) {
+        Givens G = make_givens(H(k, k), H(k + 1, k));
+        rotate_rows(H, k, k + 1, k + 1, G);
+        rotate_cols(Q_ext, k, k + 1, G);
+    }
+
+    // The last row of H is now zero, so the last column of Q_ext drops out.
+    Q = Matrix(Q_ext.block(0, 0, m + 1, n));
+    R = Matrix(H.block(0, 0, n, n));
+}
+//! <!-- [UpdatableQR::insert_row] -->
+
+/**
+ * ## Implementation
+ * @snippet this UpdatableQR::delete_row
+ */
+//! <!-- [UpdatableQR::delete_row] -->
+void UpdatableQR::delete_row(size_t i) {
+    assert(is_factored());
+    assert(i < rows());
+    assert(rows() > cols());
+    const size_t m = rows(), n = cols();
+
+    // Extend Q by a unit vector q that is orthogonal to its columns, such
+    // that eᵢ lies in the range of (Q q). Then
+    //
+    //     A = (Q q)·┌ R ┐
+    //               └ 0 ┘
+    //
+    // and row i of (Q q) has unit norm.
+    Vector q(m), w(n);
+    q(i) = 1;
+    orthogonalize(Q, q, w);
+    Matrix Q_ext(m, n + 1), H(n + 1, n);
+    Q_ext.block(0, 0, m, n) = Q;
+    Q_ext.block(0, n, m, 1) = q;
+    H.block(0, 0, n, n)     = R;
+
+    // Rotate row i of (Q q) onto the first unit vector, from the bottom up.
+    // The same rotations turn (R 0) into an upper Hessenberg matrix H.
+    for (size_t k = n; k > 0; --k) {
+        double a = Q_ext(i, k - 1), b = Q_ext(i, k);
+        Givens G = make_givens(a, b);
+        rotate_cols(Q_ext, k - 1, k, G);
+        rotate_rows(H, k - 1, k, k - 1, G);
+    }
+
+    // Now the first column of Q_ext is eᵢ, and the other columns are zero in
+    // row i, so the first row of H is row i of A:
+    //
+    //     ┌    ┐   ┌       ┐┌    ┐
+    //     │ aᵀ │ = │ 1   0 ││ aᵀ │
+    //     │ A' │   │ 0   Q'││ R' │
+    //     └    ┘   └       ┘└    ┘
+    //
+    // where A' = Q'R' is the matrix without row i, and R' is upper-triangular.
+    Matrix Q_new(m - 1, n);
+    for (size_t c = 0; c < n; ++c)
+        for (size_t r = 0; r < m; ++r)
+            if (r != i)
+                Q_new(r < i ? r : r - 1, c) = Q_ext(r, c + 1);
+    Q = std::move(Q_new);
+    R = Matrix(H.block(1, 0, n, n));
+}
+//! <!-- [UpdatableQR::delete_row] -->
+
+/**
+ * ## Implementation
+ * @snippet this UpdatableQR::insert_column
+ */
+//! <!-- [UpdatableQR::insert_column] -->
+void UpdatableQR::insert_column(size_t j, const Vector &column) {
+    assert(is_factored());
+    assert(j <= cols());
+    assert(rows() > cols());
+    assert(column.size() == rows());
+    const size_t m = rows(), n = cols();
+
+    // Split the new column a = Q·w + ρ·q, where q is orthogonal to the
+    // columns of Q. Then
+    //
+    //     (A₁ a A₂) = (Q q)·┌ R₁ w R₂ ┐
+    //                       └ 0  ρ 0  ┘
+    //
+    Vector q = column, w(n);
+    double rho = orthogonalize(Q, q, w);
+    Matrix Q_ext(m, n + 1), R_ext(n + 1, n + 1);
+    Q_ext.block(0, 0, m, n) = Q;
+    Q_ext.block(0, n, m, 1) = q;
+    R_ext.block(0, 0, n, j)         = R.block(0, 0, n, j);
+    R_ext.block(0, j, n, 1)         = w;
+    R_ext(n, j)                     = rho;
+    R_ext.block(0, j + 1, n, n - j) = R.block(0, j, n, n - j);
+
+    // Zero column j below the diagonal, from the bottom up. The columns to
+    // the right of j are upper-triangular with one extra row of zeros, so they
+    // stay upper-triangular.
+    for (size_t k = n; k > j; --k) {
+        Givens G = make_givens(R_ext(k - 1, j), R_ext(k, j));
+        rotate_rows(R_ext, k - 1, k, j + 1, G);
+        rotate_cols(Q_ext, k - 1, k, G);
+    }
+    Q = std::move(Q_ext);
+    R = std::move(R_ext);
+}
+//! <!-- [UpdatableQR::insert_column] -->
+
+/**
+ * ## Implementation
+ * @snippet this UpdatableQR::delete_column
+ */
+//! <!-- [UpdatableQR::delete_column] -->
+void UpdatableQR::delete_column(size_t j) {
+    assert(is_factored());
+    assert(j < cols());
+    const size_t m = rows(), n = cols();
+
+    // Removing column j of R leaves an upper Hessenberg matrix H in columns
+    // j and up.
+    Matrix H(n, n - 1);
+    H.block(0, 0, n, j)         = R.block(0, 0, n, j);
+    H.block(0, j, n, n - j - 1) = R.block(0, j + 1, n, n - j - 1);
+
+    // Zero its subdiagonal, from top to bottom.
+    for (size_t k = j; k + 1 < n; ++k) {
+        Givens G = make_givens(H(k, k), H(k + 1, k));
+        rotate_rows(H, k, k + 1, k + 1, G);
+        rotate_cols(Q, k, k + 1, G);
+    }
+
+    // The last row of H is now zero, so the last column of Q drops out.
+    Q = Matrix(Q.block(0, 0, m, n - 1));
+    R = Matrix(H.block(0, 0, n - 1, n - 1));
+}
+//! <!-- [UpdatableQR::delete_column] -->
+
+/**
+ * ## Implementation
+ * @snippet this UpdatableQR::rank_one_update
+ */
+//! <!-- [UpdatableQR::rank_one_update] -->
+void UpdatableQR::rank_one_update(const Vector &u, const Vector &v) {
+    assert(is_factored());
+    assert(u.size() == rows());
+    assert(v.size() == cols());
+    const size_t m = rows(), n = cols();
+
+    // Split u = Q·w + ρ·q, where q is orthogonal to the columns of Q. Then
+    //
+    //     A + uvᵀ = (Q q)·(┌ R ┐ + ┌ w ┐·vᵀ)
+    //                      └ 0 ┘   └ ρ ┘
+    //
+    Vector q = u, w(n);
+    double rho = orthogonalize(Q, q, w);
+    Matrix Q_ext(m, n + 1), H(n + 1, n);
+    Q_ext.block(0, 0, m, n) = Q;
+    Q_ext.block(0, n, m, 1) = q;
+    H.block(0, 0, n, n)     = R;
+
+    // Rotate (w ρ) onto the first unit vector, from the bottom up. The same
+    // rotations turn (R 0) into an upper Hessenberg matrix H.
+    Vector z(n + 1);
+    z.block(0, 0, n, 1) = w;
+    z(n)                = rho;
+    for (size_t k = n; k > 0; --k) {
+        Givens G = make_givens(z(k - 1), z(k));
+        rotate_rows(H, k - 1, k, k - 1, G);
+        rotate_cols(Q_ext, k - 1, k, G);
+    }
+
+    // Add the rank-one term, which only affects the first row of H.
+    for (size_t c = 0; c < n; ++c)
+        H(0, c) += z(0) * v(c);
+
+    // Reduce H to upper-triangular form by zeroing its subdiagonal, from top
+    // to bottom.
+    for (size_t k = 0; k < n; ++k) {
+        Givens G = make_givens(H(k, k), H(k + 1, k));
+        rotate_rows(H, k, k + 1, k + 1, G);
+        rotate_cols(Q_ext, k, k + 1, G);
+    }
+
+    // The last row of H is now zero, so the last column of Q_ext drops out.
+    Q = Matrix(Q_ext.block(0, 0, m, n));
+    R = Matrix(H.block(0, 0, n, n));
+}
+//! <!-- [UpdatableQR::rank_one_update] -->
+
+/**
+ * ## Implementation
+ * @snippet this UpdatableQR::back_subs
+ */
+//! <!-- [UpdatableQR::back_subs] -->
+void UpdatableQR::back_subs(const Matrix &B, Matrix &X) const {
+    // Solve upper triangular system RX = B by solving each column of B as a
+    // vector system Rxᵢ = bᵢ, see HouseholderQR::back_subs.
+    const size_t n = R.cols();
+    if (&X != &B)
+        X.block(0, 0, n, B.cols()) = B.block(0, 0, n, B.cols());
+    kernels::trsm(Side::Left, Triangle::Upper, Diagonal::NonUnit, //
+                  n, X.cols(),                                    //
+                  R.data(), R.row_stride(), R.col_stride(),       //
+                  X.data(), X.row_stride(), X.col_stride());
+}
+//! <!-- [UpdatableQR::back_subs] -->
+
+/**
+ * ## Implementation
+ * @snippet this UpdatableQR::solve_inplace
+ */
+//! <!-- [UpdatableQR::solve_inplace] -->
+void UpdatableQR::solve_inplace(Matrix &B) const {
+    // If AX = B, then QRX = B, or RX = QᵀB (Q has orthonormal columns), so
+    // first apply Qᵀ to B, and then use back substitution:
+    Matrix X = apply_QT(B);
+    back_subs(X, X);
+    B = std::move(X);
+}
+//! <!-- [UpdatableQR::solve_inplace] -->
+
+// All implementations of the less interesting functions can be found here:
+#include "boilerplate/UpdatableQR.ipp"
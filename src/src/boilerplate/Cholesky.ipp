@@ -0,0 +1,92 @@
+#include <linalg/Cholesky.hpp>
+
+#include <cassert>
+#include <iomanip>
+#include <iostream>
+
+void Cholesky::compute(SquareMatrix &&matrix) {
+    LLT = std::move(matrix);
+    compute_factorization();
+}
+
+void Cholesky::compute(const SquareMatrix &matrix) {
+    LLT = matrix;
+    compute_factorization();
+}
+
+SquareMatrix &&Cholesky::steal_L() {
+    assert(is_factored());
+    state = NotFactored;
+    for (size_t c = 0; c < LLT.cols(); ++c) {
+        // Elements above the diagonal are zero
+        for (size_t r = 0; r < c; ++r)
+            LLT(r, c) = 0;
+        // Elements on and below the diagonal are stored in LLT already
+    }
+    return std::move(LLT);
+}
+
+void Cholesky::get_L_inplace(Matrix &L) const {
+    assert(is_factored());
+    assert(L.rows() == LLT.rows());
+    assert(L.cols() == LLT.cols());
+    for (size_t c = 0; c < L.cols(); ++c) {
+        // Elements above the diagonal are zero
+        for (size_t r = 0; r < c; ++r)
+            L(r, c) = 0;
+        // Elements on and below the diagonal are stored in LLT
+        for (size_t r = c; r < L.rows(); ++r)
+            L(r, c) = LLT(r, c);
+    }
+}
+
+SquareMatrix Cholesky::get_L() const & {
+    SquareMatrix L(LLT.rows());
+    get_L_inplace(L);
+    return L;
+}
+
+Matrix Cholesky::solve(const Matrix &B) const {
+    Matrix B_cpy = B;
+    solve_inplace(B_cpy);
+    return B_cpy;
+}
+
+Matrix &&Cholesky::solve(Matrix &&B) const {
+    solve_inplace(B);
+    return std::move(B);
+}
+
+Vector Cholesky::solve(const Vector &b) const {
+    return Vector(solve(static_cast<const Matrix &>(b)));
+}
+
+Vector &&Cholesky::solve(Vector &&b) const {
+    solve_inplace(b);
+    return std::move(b);
+}
+
+// LCOV_EXCL_START
+
+std::ostream &operator<<(std::ostream &os, const Cholesky &chol) {
+    if (!chol.is_factored()) {
+        os << "Not factored." << std::endl;
+        return os;
+    }
+
+    // Output field width (characters)
+    int w = os.precision() + 9;
+    auto &LLT = chol.get_LLT();
+
+    os << "L = " << std::endl;
+    for (size_t r = 0; r < LLT.rows(); ++r) {
+        for (size_t c = 0; c <= r; ++c)
+            os << std::setw(w) << LLT(r, c);
+        for (size_t c = r + 1; c < LLT.cols(); ++c)
+            os << std::setw(w) << 0;
+        os << std::endl;
+    }
+    return os;
+}
+
+// LCOV_EXCL_STOP
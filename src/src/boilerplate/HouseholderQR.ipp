@@ -88,6 +88,12 @@ SquareMatrix HouseholderQR::get_Q() const {
     return Q;
 }
 
+Matrix HouseholderQR::get_thin_Q() const {
+    Matrix Q(RW.rows(), RW.cols());
+    get_thin_Q_inplace(Q);
+    return Q;
+}
+
 Matrix HouseholderQR::solve(const Matrix &B) const {
     Matrix B_cpy = apply_QT(B);
     Matrix X(RW.cols(), B.cols());
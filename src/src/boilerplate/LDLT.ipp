@@ -0,0 +1,149 @@
+#include <linalg/LDLT.hpp>
+
+#include <cassert>
+#include <iomanip>
+#include <iostream>
+
+void LDLT::compute(SquareMatrix &&matrix) {
+    LD = std::move(matrix);
+    D_sub.resize(LD.rows());
+    P.resize(LD.rows());
+    P.fill_identity();
+    compute_factorization();
+}
+
+void LDLT::compute(const SquareMatrix &matrix) {
+    LD = matrix;
+    D_sub.resize(LD.rows());
+    P.resize(LD.rows());
+    P.fill_identity();
+    compute_factorization();
+}
+
+SquareMatrix &&LDLT::steal_L() {
+    assert(has_LD());
+    state = NotFactored;
+    valid_LD = false;
+    for (size_t c = 0; c < LD.cols(); ++c) {
+        // Elements above the diagonal are zero
+        for (size_t r = 0; r < c; ++r)
+            LD(r, c) = 0;
+        // Diagonal elements are one
+        LD(c, c) = 1;
+        // Elements below the diagonal are stored in LD already
+    }
+    return std::move(LD);
+}
+
+void LDLT::get_L_inplace(Matrix &L) const {
+    assert(has_LD());
+    assert(L.rows() == LD.rows());
+    assert(L.cols() == LD.cols());
+    for (size_t c = 0; c < L.cols(); ++c) {
+        // Elements above the diagonal are zero
+        for (size_t r = 0; r < c; ++r)
+            L(r, c) = 0;
+        // Diagonal elements are one
+        L(c, c) = 1;
+        // Elements below the diagonal are stored in LD
+        for (size_t r = c + 1; r < L.rows(); ++r)
+            L(r, c) = LD(r, c);
+    }
+}
+
+SquareMatrix LDLT::get_L() const & {
+    SquareMatrix L(LD.rows());
+    get_L_inplace(L);
+    return L;
+}
+
+void LDLT::get_D_inplace(Matrix &D) const {
+    assert(has_LD());
+    assert(D.rows() == LD.rows());
+    assert(D.cols() == LD.cols());
+    D.fill(0);
+    for (size_t k = 0; k < D.cols(); ++k) {
+        // Diagonal elements are stored in LD
+        D(k, k) = LD(k, k);
+        // Off-diagonal elements of the 2×2 blocks are stored in D_sub
+        if (D_sub(k) != 0) {
+            D(k + 1, k) = D_sub(k);
+            D(k, k + 1) = D_sub(k);
+        }
+    }
+}
+
+SquareMatrix LDLT::get_D() const {
+    SquareMatrix D(LD.rows());
+    get_D_inplace(D);
+    return D;
+}
+
+PermutationMatrix &&LDLT::steal_P() {
+    state = NotFactored;
+    valid_P = false;
+    return std::move(P);
+}
+
+Matrix LDLT::solve(const Matrix &B) const {
+    Matrix B_cpy = B;
+    solve_inplace(B_cpy);
+    return B_cpy;
+}
+
+Matrix &&LDLT::solve(Matrix &&B) const {
+    solve_inplace(B);
+    return std::move(B);
+}
+
+Vector LDLT::solve(const Vector &b) const {
+    return Vector(solve(static_cast<const Matrix &>(b)));
+}
+
+Vector &&LDLT::solve(Vector &&b) const {
+    solve_inplace(b);
+    return std::move(b);
+}
+
+// LCOV_EXCL_START
+
+std::ostream &operator<<(std::ostream &os, const LDLT &ldlt) {
+    if (!ldlt.is_factored()) {
+        os << "Not factored." << std::endl;
+        return os;
+    }
+
+    // Output field width (characters)
+    int w = os.precision() + 9;
+    auto &LD = ldlt.get_LD();
+    auto &D_sub = ldlt.get_D_subdiag();
+
+    os << "L = " << std::endl;
+    for (size_t r = 0; r < LD.rows(); ++r) {
+        for (size_t c = 0; c < r; ++c)
+            os << std::setw(w) << LD(r, c);
+        os << std::setw(w) << 1;
+        for (size_t c = r + 1; c < LD.cols(); ++c)
+            os << std::setw(w) << 0;
+        os << std::endl;
+    }
+
+    os << "D = " << std::endl;
+    for (size_t r = 0; r < LD.rows(); ++r) {
+        for (size_t c = 0; c < LD.cols(); ++c) {
+            double d = r == c       ? LD(r, c)
+                       : r == c + 1 ? D_sub(c)
+                       : c == r + 1 ? D_sub(r)
+                                    : 0;
+            os << std::setw(w) << d;
+        }
+        os << std::endl;
+    }
+
+    os << "P = " << std::endl;
+    ldlt.get_P().print(os);
+    os << std::endl;
+    return os;
+}
+
+// LCOV_EXCL_STOP
@@ -0,0 +1,160 @@
+#include <linalg/PivotedHouseholderQR.hpp>
+
+#include <cassert>
+#include <iomanip>
+#include <iostream>
+
+void PivotedHouseholderQR::compute(Matrix &&matrix) {
+    RW = std::move(matrix);
+    R_diag.resize(RW.cols());
+    P.resize(RW.cols());
+    P.set_type(PermutationMatrix::ColumnPermutation);
+    norms.resize(RW.cols());
+    norms_ref.resize(RW.cols());
+    compute_factorization();
+}
+
+void PivotedHouseholderQR::compute(const Matrix &matrix) {
+    RW = matrix;
+    R_diag.resize(RW.cols());
+    P.resize(RW.cols());
+    P.set_type(PermutationMatrix::ColumnPermutation);
+    norms.resize(RW.cols());
+    norms_ref.resize(RW.cols());
+    compute_factorization();
+}
+
+Matrix PivotedHouseholderQR::apply_QT(const Matrix &B) const {
+    Matrix result = B;
+    apply_QT_inplace(result);
+    return result;
+}
+
+Matrix &&PivotedHouseholderQR::apply_QT(Matrix &&B) const {
+    apply_QT_inplace(B);
+    return std::move(B);
+}
+
+Matrix PivotedHouseholderQR::apply_Q(const Matrix &X) const {
+    Matrix result = X;
+    apply_Q_inplace(result);
+    return result;
+}
+
+Matrix &&PivotedHouseholderQR::apply_Q(Matrix &&B) const {
+    apply_Q_inplace(B);
+    return std::move(B);
+}
+
+void PivotedHouseholderQR::get_R_inplace(Matrix &R) const {
+    assert(is_factored());
+    assert(R.rows() == RW.rows());
+    assert(R.cols() == RW.cols());
+    for (size_t r = 0; r < R.cols(); ++r) {
+        for (size_t c = 0; c < r; ++c)
+            R(r, c) = 0;
+        R(r, r) = R_diag(r);
+        for (size_t c = r + 1; c < R.cols(); ++c)
+            R(r, c) = RW(r, c);
+    }
+    for (size_t r = R.cols(); r < R.rows(); ++r) {
+        for (size_t c = 0; c < R.cols(); ++c)
+            R(r, c) = 0;
+    }
+}
+
+Matrix PivotedHouseholderQR::get_R() const & {
+    Matrix R(RW.rows(), RW.cols());
+    get_R_inplace(R);
+    return R;
+}
+
+Matrix &&PivotedHouseholderQR::steal_R() {
+    state = NotFactored;
+    for (size_t r = 0; r < RW.cols(); ++r) {
+        for (size_t c = 0; c < r; ++c)
+            RW(r, c) = 0;
+        RW(r, r) = R_diag(r);
+    }
+    for (size_t r = RW.cols(); r < RW.rows(); ++r) {
+        for (size_t c = 0; c < RW.cols(); ++c)
+            RW(r, c) = 0;
+    }
+    return std::move(RW);
+}
+
+PermutationMatrix &&PivotedHouseholderQR::steal_P() {
+    state = NotFactored;
+    return std::move(P);
+}
+
+void PivotedHouseholderQR::get_Q_inplace(SquareMatrix &Q) const {
+    assert(Q.rows() == RW.rows());
+    assert(Q.cols() == RW.rows());
+    Q.fill_identity();
+    apply_Q_inplace(Q);
+}
+
+SquareMatrix PivotedHouseholderQR::get_Q() const {
+    SquareMatrix Q(RW.rows());
+    get_Q_inplace(Q);
+    return Q;
+}
+
+Matrix PivotedHouseholderQR::solve(const Matrix &B) const {
+    Matrix X = B;
+    solve_inplace(X);
+    return X;
+}
+
+Matrix &&PivotedHouseholderQR::solve(Matrix &&B) const {
+    solve_inplace(B);
+    return std::move(B);
+}
+
+Vector PivotedHouseholderQR::solve(const Vector &b) const {
+    return Vector(solve(static_cast<const Matrix &>(b)));
+}
+
+Vector &&PivotedHouseholderQR::solve(Vector &&b) const {
+    solve_inplace(b);
+    return std::move(b);
+}
+
+// LCOV_EXCL_START
+
+std::ostream &operator<<(std::ostream &os, const PivotedHouseholderQR &qr) {
+    if (!qr.is_factored()) {
+        os << "Not factored." << std::endl;
+        return os;
+    }
+
+    Matrix Q = qr.get_Q();
+    os << "Q = " << std::endl;
+    Q.print(os);
+
+    // Output field width (characters)
+    int w = os.precision() + 9;
+
+    const auto &RW = qr.get_RW();
+    const auto &R_diag = qr.get_R_diag();
+    os << "R = " << std::endl;
+    for (size_t r = 0; r < RW.cols(); ++r) {
+        for (size_t c = 0; c < r; ++c)
+            os << std::setw(w) << 0;
+        os << std::setw(w) << R_diag(r);
+        for (size_t c = r + 1; c < RW.cols(); ++c)
+            os << std::setw(w) << RW(r, c);
+        os << std::endl;
+    }
+    for (size_t r = RW.cols(); r < RW.rows(); ++r) {
+        for (size_t c = 0; c < RW.cols(); ++c)
+            os << std::setw(w) << 0;
+    }
+    os << "P = " << std::endl;
+    qr.get_P().print(os);
+    os << std::endl;
+    return os;
+}
+
+// LCOV_EXCL_STOP
@@ -0,0 +1,44 @@
+#include <linalg/TallSkinnyQR.hpp>
+
+Matrix TallSkinnyQR::apply_QT(const Matrix &B) const {
+    Matrix result = B;
+    apply_QT_inplace(result);
+    return result;
+}
+
+Matrix &&TallSkinnyQR::apply_QT(Matrix &&B) const {
+    apply_QT_inplace(B);
+    return std::move(B);
+}
+
+Matrix TallSkinnyQR::apply_Q(const Matrix &X) const {
+    Matrix result = X;
+    apply_Q_inplace(result);
+    return result;
+}
+
+Matrix &&TallSkinnyQR::apply_Q(Matrix &&B) const {
+    apply_Q_inplace(B);
+    return std::move(B);
+}
+
+Matrix TallSkinnyQR::solve(const Matrix &B) const {
+    Matrix B_cpy = apply_QT(B);
+    Matrix X(cols(), B.cols());
+    back_subs(B_cpy, X);
+    return X;
+}
+
+Matrix &&TallSkinnyQR::solve(Matrix &&B) const {
+    solve_inplace(B);
+    return std::move(B);
+}
+
+Vector TallSkinnyQR::solve(const Vector &b) const {
+    return Vector(solve(static_cast<const Matrix &>(b)));
+}
+
+Vector &&TallSkinnyQR::solve(Vector &&b) const {
+    solve_inplace(b);
+    return std::move(b);
+}
@@ -0,0 +1,51 @@
+#include <linalg/UpdatableQR.hpp>
+
+#include <cassert>
+#include <iostream>
+
+Matrix UpdatableQR::apply_QT(const Matrix &B) const {
+    assert(is_factored());
+    assert(B.rows() == rows());
+    Matrix result(cols(), B.cols());
+    kernels::gemm(cols(), B.cols(), rows(),                           //
+                  1, Q.data(), Q.col_stride(), Q.row_stride(),        //
+                  B.data(), B.row_stride(), B.col_stride(),           //
+                  0, result.data(), result.row_stride(), result.col_stride());
+    return result;
+}
+
+Matrix UpdatableQR::solve(const Matrix &B) const {
+    Matrix X = apply_QT(B);
+    back_subs(X, X);
+    return X;
+}
+
+Matrix &&UpdatableQR::solve(Matrix &&B) const {
+    solve_inplace(B);
+    return std::move(B);
+}
+
+Vector UpdatableQR::solve(const Vector &b) const {
+    return Vector(solve(static_cast<const Matrix &>(b)));
+}
+
+Vector &&UpdatableQR::solve(Vector &&b) const {
+    solve_inplace(b);
+    return std::move(b);
+}
+
+// LCOV_EXCL_START
+
+std::ostream &operator<<(std::ostream &os, const UpdatableQR &qr) {
+    if (!qr.is_factored()) {
+        os << "Not factored." << std::endl;
+        return os;
+    }
+    os << "Q = " << std::endl;
+    qr.get_Q().print(os);
+    os << "R = " << std::endl;
+    qr.get_R().print(os);
+    return os;
+}
+
+// LCOV_EXCL_STOP
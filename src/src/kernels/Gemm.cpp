@@ -0,0 +1,252 @@
+#include "Gemm.hpp"
+#include "Simd.hpp"
+#include "ThreadPool.hpp"
+
+#include <linalg/Runtime.hpp>
+
+#include <algorithm> // std::min
+#include <atomic>    // std::atomic
+#include <vector>    // std::vector
+
+namespace kernels {
+
+namespace {
+
+// Blocking parameters of the GEMM algorithm.
+//
+// The product is computed as a sequence of rank-KC updates of blocks of C.
+// A KC×NC panel of B is packed into a buffer that stays in the L3 cache, an
+// MC×KC block of A is packed into a buffer that stays in the L2 cache, and the
+// micro-kernel multiplies an MR×KC sliver of A by a KC×NR sliver of B (which
+// stays in the L1 cache), accumulating the MR×NR result in registers.
+
+constexpr size_t MR = gemm_mr; ///< Rows of the register block.
+constexpr size_t NR = gemm_nr; ///< Columns of the register block.
+constexpr size_t KC = 256;     ///< Depth of the panels (L1/L2 blocking).
+constexpr size_t MC = 128;     ///< Rows of the packed block of A (L2).
+constexpr size_t NC = 2048;    ///< Columns of the packed panel of B (L3).
+
+/// Products with fewer multiply-accumulate operations than this are computed
+/// using a simple loop, because packing wouldn't pay off.
+constexpr size_t small_gemm_threshold = 32 * 32 * 32;
+
+/// Products with fewer multiply-accumulate operations than this are computed
+/// on a single thread, because waking up the workers wouldn't pay off.
+std::atomic<size_t> parallel_gemm_threshold{128 * 128 * 128};
+
+/// Compute C = β·C, where β = 0 overwrites C with zeros (even if C contains
+/// NaN or infinity).
+void scale(size_t m, size_t n, double beta, double *C, size_t rs_C,
+           size_t cs_C) {
+    for (size_t j = 0; j < n; ++j)
+        for (size_t i = 0; i < m; ++i)
+            C[i * rs_C + j * cs_C] =
+                beta == 0 ? 0 : beta * C[i * rs_C + j * cs_C];
+}
+
+/// Straightforward j-k-i loop for small products, where C has already been
+/// scaled by β.
+void gemm_small(size_t m, size_t n, size_t k, double alpha, const double *A,
+                size_t rs_A, size_t cs_A, const double *B, size_t rs_B,
+                size_t cs_B, double *C, size_t rs_C, size_t cs_C) {
+    for (size_t j = 0; j < n; ++j)
+        for (size_t p = 0; p < k; ++p) {
+            double b = alpha * B[p * rs_B + j * cs_B];
+            for (size_t i = 0; i < m; ++i)
+                C[i * rs_C + j * cs_C] += A[i * rs_A + p * cs_A] * b;
+        }
+}
+
+/// Pack an mc×kc block of A, scaled by α, into slivers of MR rows. Within a
+/// sliver, the MR elements of each column are contiguous, so the micro-kernel
+/// can read A sequentially. The last sliver is padded with zeros.
+void pack_A(size_t mc, size_t kc, double alpha, const double *A, size_t rs_A,
+            size_t cs_A, double *buf) {
+    for (size_t ir = 0; ir < mc; ir += MR) {
+        size_t mr = std::min(MR, mc - ir);
+        for (size_t p = 0; p < kc; ++p) {
+            const double *a = A + ir * rs_A + p * cs_A;
+            for (size_t i = 0; i < mr; ++i)
+                buf[i] = alpha * a[i * rs_A];
+            for (size_t i = mr; i < MR; ++i)
+                buf[i] = 0;
+            buf += MR;
+        }
+    }
+}
+
+/// Pack a kc×nc panel of B into slivers of NR columns. Within a sliver, the NR
+/// elements of each row are contiguous. The last sliver is padded with zeros.
+void pack_B(size_t kc, size_t nc, const double *B, size_t rs_B, size_t cs_B,
+            double *buf) {
+    for (size_t jr = 0; jr < nc; jr += NR) {
+        size_t nr = std::min(NR, nc - jr);
+        for (size_t p = 0; p < kc; ++p) {
+            const double *b = B + p * rs_B + jr * cs_B;
+            for (size_t j = 0; j < nr; ++j)
+                buf[j] = b[j * cs_B];
+            for (size_t j = nr; j < NR; ++j)
+                buf[j] = 0;
+            buf += NR;
+        }
+    }
+}
+
+/// Type of the SIMD micro-kernel that computes the MR×NR product of a packed
+/// sliver of A and a packed sliver of B.
+using micro_kernel_t = void (*)(size_t kc, const double *a, const double *b,
+                                double *ab);
+
+/// Multiply a packed MR×kc sliver of A by a packed kc×NR sliver of B, and add
+/// the result to the mr×nr block of C, after scaling that block by β.
+/// The product itself is computed in registers by the micro-kernel of the
+/// active SIMD instruction set.
+void micro_kernel(micro_kernel_t kernel, size_t kc, const double *a,
+                  const double *b, double beta, double *C, size_t rs_C,
+                  size_t cs_C, size_t mr, size_t nr) {
+    double ab[NR * MR];
+    kernel(kc, a, b, ab);
+    if (beta == 0) {
+        for (size_t j = 0; j < nr; ++j)
+            for (size_t i = 0; i < mr; ++i)
+                C[i * rs_C + j * cs_C] = ab[i + MR * j];
+    } else {
+        for (size_t j = 0; j < nr; ++j)
+            for (size_t i = 0; i < mr; ++i)
+                C[i * rs_C + j * cs_C] =
+                    beta * C[i * rs_C + j * cs_C] + ab[i + MR * j];
+    }
+}
+
+/// Multiply the packed mc×kc block of A by the packed kc×nc panel of B, and
+/// add the result to the mc×nc block of C, after scaling that block by β.
+void macro_kernel(micro_kernel_t kernel, size_t mc, size_t nc, size_t kc,
+                  const double *A_pack, const double *B_pack, double beta,
+                  double *C, size_t rs_C, size_t cs_C) {
+    for (size_t jr = 0; jr < nc; jr += NR) {
+        size_t nr = std::min(NR, nc - jr);
+        for (size_t ir = 0; ir < mc; ir += MR) {
+            size_t mr = std::min(MR, mc - ir);
+            micro_kernel(kernel, kc, A_pack + ir * kc, B_pack + jr * kc,
+                         beta, C + ir * rs_C + jr * cs_C, rs_C, cs_C, mr, nr);
+        }
+    }
+}
+
+/// Round up to a multiple of the given block size.
+size_t round_up(size_t n, size_t block) {
+    return (n + block - 1) / block * block;
+}
+
+/// Get a packing buffer of at least the given size. The buffers are reused
+/// between calls to avoid an allocation per product. They are per thread, so
+/// concurrent products don't interfere with each other.
+double *packing_buffer_A(size_t size) {
+    thread_local std::vector<double> buffer;
+    if (buffer.size() < size)
+        buffer.resize(size);
+    return buffer.data();
+}
+/// @copydoc packing_buffer_A
+double *packing_buffer_B(size_t size) {
+    thread_local std::vector<double> buffer;
+    if (buffer.size() < size)
+        buffer.resize(size);
+    return buffer.data();
+}
+
+} // namespace
+
+void gemm(size_t m, size_t n, size_t k, double alpha, const double *A,
+          size_t rs_A, size_t cs_A, const double *B, size_t rs_B, size_t cs_B,
+          double beta, double *C, size_t rs_C, size_t cs_C) {
+    if (m == 0 || n == 0)
+        return;
+    // If there is nothing to multiply, only the scaling of C remains:
+    if (k == 0 || alpha == 0) {
+        if (beta != 1)
+            scale(m, n, beta, C, rs_C, cs_C);
+        return;
+    }
+    if (m * n * k < small_gemm_threshold) {
+        if (beta != 1)
+            scale(m, n, beta, C, rs_C, cs_C);
+        gemm_small(m, n, k, alpha, A, rs_A, cs_A, B, rs_B, cs_B, C, rs_C,
+                   cs_C);
+        return;
+    }
+
+    micro_kernel_t kernel = simd().gemm_micro_kernel;
+
+    ThreadPool &pool = ThreadPool::instance();
+    size_t num_threads = pool.get_num_threads();
+    bool parallel =
+        num_threads > 1 &&
+        m * n * k >= parallel_gemm_threshold.load(std::memory_order_relaxed);
+
+    // The packed panel of B is shared by all threads, the blocks of A are
+    // packed by each thread separately.
+    double *B_pack = packing_buffer_B(round_up(std::min(NC, n), NR) * KC);
+    size_t num_ic = (m + MC - 1) / MC;
+
+    for (size_t jc = 0; jc < n; jc += NC) {
+        size_t nc = std::min(NC, n - jc);
+
+        // The product of an MC×KC block of A and a KC×NC panel of B is a
+        // macro-tile of C. If there are too few macro-tiles to keep all
+        // threads busy, the columns of the panel of B are split into chunks
+        // as well (of a multiple of NR columns), and each (block of A, chunk
+        // of B) pair is a separate task.
+        size_t num_jr = (nc + NR - 1) / NR;
+        size_t chunks = 1;
+        if (parallel)
+            chunks = std::min(num_jr, (2 * num_threads + num_ic - 1) / num_ic);
+        size_t chunk_nc = (num_jr + chunks - 1) / chunks * NR;
+        chunks = (nc + chunk_nc - 1) / chunk_nc;
+
+        for (size_t pc = 0; pc < k; pc += KC) {
+            size_t kc = std::min(KC, k - pc);
+            // Pack the panel of B, one chunk per task:
+            auto pack_B_chunk = [&](size_t t) {
+                size_t jr = t * chunk_nc;
+                pack_B(kc, std::min(chunk_nc, nc - jr),
+                       B + pc * rs_B + (jc + jr) * cs_B, rs_B, cs_B,
+                       B_pack + jr * kc);
+            };
+            // Only the first rank-kc update scales C by β, the following
+            // updates accumulate onto the result.
+            double beta_pc = pc == 0 ? beta : 1;
+            // Pack a block of A, and multiply it by a chunk of the panel of B:
+            auto macro_tile = [&](size_t t) {
+                size_t ic = (t / chunks) * MC;
+                size_t jr = (t % chunks) * chunk_nc;
+                size_t mc = std::min(MC, m - ic);
+                double *A_pack = packing_buffer_A(round_up(mc, MR) * KC);
+                pack_A(mc, kc, alpha, A + ic * rs_A + pc * cs_A, rs_A, cs_A,
+                       A_pack);
+                macro_kernel(kernel, mc, std::min(chunk_nc, nc - jr), kc,
+                             A_pack, B_pack + jr * kc, beta_pc,
+                             C + ic * rs_C + (jc + jr) * cs_C, rs_C, cs_C);
+            };
+            if (parallel) {
+                pool.parallel_for(chunks, pack_B_chunk);
+                pool.parallel_for(num_ic * chunks, macro_tile);
+            } else {
+                for (size_t t = 0; t < chunks; ++t)
+                    pack_B_chunk(t);
+                for (size_t t = 0; t < num_ic * chunks; ++t)
+                    macro_tile(t);
+            }
+        }
+    }
+}
+
+} // namespace kernels
+
+void set_parallel_gemm_threshold(size_t num_mac) {
+    kernels::parallel_gemm_threshold.store(num_mac, std::memory_order_relaxed);
+}
+
+size_t get_parallel_gemm_threshold() {
+    return kernels::parallel_gemm_threshold.load(std::memory_order_relaxed);
+}
@@ -0,0 +1,26 @@
+#pragma once
+
+#include <cstddef> // size_t
+
+using std::size_t;
+
+/// Low-level kernels that operate on raw, strided matrix storage.
+///
+/// All matrices are described by a pointer to their first element and two
+/// strides: element (i, j) of a matrix X is stored at `X[i * rs + j * cs]`,
+/// where `rs` is the distance between two vertically adjacent elements (the
+/// row stride) and `cs` the distance between two horizontally adjacent elements
+/// (the column stride). This covers both column major and row major storage,
+/// as well as transposed operands (by swapping the strides).
+namespace kernels {
+
+/// General matrix-matrix product C = α·A·B + β·C, where A is m×k, B is k×n
+/// and C is m×n.
+/// If β is zero, C does not have to be initialized.
+void gemm(size_t m, size_t n, size_t k,                       //
+          double alpha,                                       //
+          const double *A, size_t rs_A, size_t cs_A,          //
+          const double *B, size_t rs_B, size_t cs_B,          //
+          double beta, double *C, size_t rs_C, size_t cs_C);
+
+} // namespace kernels
@@ -0,0 +1,116 @@
+#include "Gemv.hpp"
+#include "Simd.hpp"
+#include "ThreadPool.hpp"
+
+#include <linalg/Runtime.hpp>
+
+#include <algorithm> // std::min
+#include <atomic>    // std::atomic
+#include <vector>    // std::vector
+
+namespace kernels {
+
+namespace {
+
+/// Number of elements of y that are updated by all columns of A before moving
+/// on to the next block (AXPY variant). A block of 8 KiB stays in the L1
+/// cache, so y is only read from and written to memory once.
+constexpr size_t MB = 1024;
+
+/// Products with fewer elements in A than this are computed on a single
+/// thread, because waking up the workers wouldn't pay off.
+std::atomic<size_t> parallel_gemv_threshold{256 * 256};
+
+/// Compute y = y + α·A·x for contiguous vectors x and y.
+void gemv_rows(size_t m, size_t n, double alpha, const double *A, size_t rs_A,
+               size_t cs_A, const double *x, double *y) {
+    const SimdKernels &simd_kernels = simd();
+    if (rs_A == 1 && (cs_A != 1 || m >= n)) {
+        // Columns of A are contiguous: y += (α·xⱼ)·aⱼ
+        for (size_t i = 0; i < m; i += MB) {
+            size_t mb = std::min(MB, m - i);
+            for (size_t j = 0; j < n; ++j)
+                simd_kernels.axpy(mb, alpha * x[j], A + i + j * cs_A, y + i);
+        }
+    } else if (cs_A == 1) {
+        // Rows of A are contiguous: yᵢ += α·(aᵢᵀx)
+        for (size_t i = 0; i < m; ++i)
+            y[i] += alpha * simd_kernels.dot(n, A + i * rs_A, x);
+    } else {
+        for (size_t i = 0; i < m; ++i) {
+            double s = 0;
+            for (size_t j = 0; j < n; ++j)
+                s += A[i * rs_A + j * cs_A] * x[j];
+            y[i] += alpha * s;
+        }
+    }
+}
+
+} // namespace
+
+void gemv(size_t m, size_t n, double alpha, const double *A, size_t rs_A,
+          size_t cs_A, const double *x, size_t incx, double beta, double *y,
+          size_t incy) {
+    if (m == 0)
+        return;
+    // Scale y by β first, β = 0 overwrites y with zeros (even if y contains
+    // NaN or infinity).
+    if (beta != 1)
+        for (size_t i = 0; i < m; ++i)
+            y[i * incy] = beta == 0 ? 0 : beta * y[i * incy];
+    if (n == 0 || alpha == 0)
+        return;
+
+    // The vectorized kernels need contiguous vectors, copy them if necessary
+    // (this is cheap compared to the product itself).
+    std::vector<double> x_buf, y_buf;
+    if (incx != 1) {
+        x_buf.resize(n);
+        for (size_t j = 0; j < n; ++j)
+            x_buf[j] = x[j * incx];
+        x = x_buf.data();
+    }
+    double *y_c = y;
+    if (incy != 1) {
+        y_buf.resize(m);
+        for (size_t i = 0; i < m; ++i)
+            y_buf[i] = y[i * incy];
+        y_c = y_buf.data();
+    }
+
+    // Every thread computes a separate block of rows of y.
+    ThreadPool &pool   = ThreadPool::instance();
+    size_t num_threads = pool.get_num_threads();
+    size_t num_tasks   = 1;
+    if (num_threads > 1 &&
+        m * n >= parallel_gemv_threshold.load(std::memory_order_relaxed))
+        num_tasks = std::min(num_threads, (m + 7) / 8);
+    // Rows per task, a multiple of 8 so the blocks of y don't share cache
+    // lines.
+    size_t mt = ((m + num_tasks - 1) / num_tasks + 7) / 8 * 8;
+    num_tasks = (m + mt - 1) / mt;
+    auto task = [&](size_t t) {
+        size_t i = t * mt;
+        gemv_rows(std::min(mt, m - i), n, alpha, A + i * rs_A, rs_A, cs_A, x,
+                  y_c + i);
+    };
+    if (num_tasks > 1)
+        pool.parallel_for(num_tasks, task);
+    else
+        task(0);
+
+    if (incy != 1)
+        for (size_t i = 0; i < m; ++i)
+            y[i * incy] = y_c[i];
+}
+
+} // namespace kernels
+
+void set_parallel_gemv_threshold(size_t num_elem) {
+    kernels::parallel_gemv_threshold.store(num_elem,
+                                           std::memory_order_relaxed);
+}
+
+size_t get_parallel_gemv_threshold() {
+    return kernels::parallel_gemv_threshold.load(std::memory_order_relaxed);
+}
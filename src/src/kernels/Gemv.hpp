@@ -0,0 +1,25 @@
+#pragma once
+
+#include <cstddef> // size_t
+
+using std::size_t;
+
+/// @see    Gemm.hpp for the conventions used for strided matrices.
+namespace kernels {
+
+/// General matrix-vector product y = α·A·x + β·y, where A is m×n, the n
+/// elements of x are `incx` apart, and the m elements of y are `incy` apart.
+/// If β is zero, y does not have to be initialized.
+///
+/// If the columns of A are contiguous, the scaled columns of A are added to y
+/// one by one (AXPY), if its rows are contiguous, every element of y is the dot
+/// product of a row of A and x. Both variants are vectorized, so Aᵀx for a
+/// column major matrix A (i.e. A with its strides swapped) is as fast as Ax.
+/// Large products are split into blocks of rows that are computed in
+/// parallel, see @ref set_parallel_gemv_threshold.
+void gemv(size_t m, size_t n, double alpha,              //
+          const double *A, size_t rs_A, size_t cs_A,     //
+          const double *x, size_t incx,                  //
+          double beta, double *y, size_t incy);
+
+} // namespace kernels
@@ -0,0 +1,190 @@
+#include "Householder.hpp"
+#include "Gemm.hpp"
+#include "ThreadPool.hpp"
+
+#include <linalg/Matrix.hpp>
+
+#include <algorithm> // std::min, std::max
+#include <cassert>
+
+namespace kernels {
+
+void build_block_reflector(ConstMatrixView W, MatrixView V, MatrixView T) {
+    // The product of the b reflectors of a panel can be written in the
+    // compact WY form:
+    //     H₀·H₁·...·Hₕ₋₁ = I - V·T·Vᵀ
+    // where V = (w₀, w₁, ..., wₕ₋₁) is the m×b matrix of reflector vectors,
+    // and T is a b×b upper-triangular matrix.
+    size_t m = V.rows(), b = V.cols();
+    assert(W.rows() == m && W.cols() == b);
+    assert(T.rows() == b && T.cols() == b);
+
+    // Copy the reflectors to V, with explicit zeros above the diagonal (the
+    // upper-triangular part of the panel of W contains R):
+    for (size_t j = 0; j < b; ++j) {
+        for (size_t i = 0; i < j; ++i)
+            V(i, j) = 0;
+        for (size_t i = j; i < m; ++i)
+            V(i, j) = W(i, j);
+    }
+
+    // Build T one column at a time (this is LAPACK's DLARFT): for a single
+    // reflector, T = 1 (because ‖wⱼ‖² = 2). Adding reflector wⱼ gives
+    //     (I - V·T·Vᵀ)·(I - wⱼ·wⱼᵀ)
+    //         = I - (V wⱼ)·┌ T  -T·Vᵀ·wⱼ ┐·(V wⱼ)ᵀ
+    //                      └ 0       1    ┘
+    // The inner products Vᵀ·wⱼ for all j form the upper-triangular part of
+    // VᵀV, which is computed first as a single matrix product, and is then
+    // overwritten by T in place.
+    gemm(b, b, m,                                     //
+         1, V.data(), V.col_stride(), V.row_stride(), //
+         V.data(), V.row_stride(), V.col_stride(),    //
+         0, T.data(), T.row_stride(), T.col_stride());
+    for (size_t j = 0; j < b; ++j) {
+        // T[0:j,j] = -T[0:j,0:j]·(VᵀV)[0:j,j], top to bottom, so that the
+        // elements (VᵀV)[i:j,j] that are still needed haven't been
+        // overwritten yet (T is upper-triangular).
+        for (size_t i = 0; i < j; ++i) {
+            double t = 0;
+            for (size_t l = i; l < j; ++l)
+                t += T(i, l) * T(l, j);
+            T(i, j) = -t;
+        }
+        T(j, j) = 1;
+    }
+}
+
+void apply_block_reflector(ConstMatrixView V, ConstMatrixView T, MatrixView C,
+                           MatrixView W, bool transpose) {
+    // Applying the block reflector, or its transpose, to C takes three
+    // matrix-matrix products:
+    //     Hₕ₋₁·...·H₁·H₀·C = C - V·Tᵀ·(Vᵀ·C)
+    //     H₀·H₁·...·Hₕ₋₁·C = C - V·T·(Vᵀ·C)
+    size_t m = V.rows(), b = V.cols(), nc = C.cols();
+    assert(C.rows() == m);
+    assert(W.rows() == b && W.cols() == nc);
+
+    // W = Vᵀ·C
+    gemm(b, nc, m,                                    //
+         1, V.data(), V.col_stride(), V.row_stride(), //
+         C.data(), C.row_stride(), C.col_stride(),    //
+         0, W.data(), W.row_stride(), W.col_stride());
+
+    // W = Tᵀ·W or W = T·W, in place: Tᵀ is lower-triangular, so row i of the
+    // result only depends on rows 0 through i of W, which are updated bottom
+    // to top. T is upper-triangular, so its rows are updated top to bottom.
+    if (transpose) {
+        for (size_t c = 0; c < nc; ++c) {
+            for (size_t i = b; i-- > 0;) {
+                double w = 0;
+                for (size_t l = 0; l <= i; ++l)
+                    w += T(l, i) * W(l, c);
+                W(i, c) = w;
+            }
+        }
+    } else {
+        for (size_t c = 0; c < nc; ++c) {
+            for (size_t i = 0; i < b; ++i) {
+                double w = 0;
+                for (size_t l = i; l < b; ++l)
+                    w += T(i, l) * W(l, c);
+                W(i, c) = w;
+            }
+        }
+    }
+
+    // C = C - V·W
+    gemm(m, nc, b,                                     //
+         -1, V.data(), V.row_stride(), V.col_stride(), //
+         W.data(), W.row_stride(), W.col_stride(),     //
+         1, C.data(), C.row_stride(), C.col_stride());
+}
+
+namespace {
+
+/// Apply the reflectors in panels of nb, using their compact WY form.
+void apply_reflectors_blocked(ConstMatrixView W, MatrixView B, size_t nb,
+                              bool transpose) {
+    size_t m = W.rows(), n = W.cols();
+    size_t num_panels = (n + nb - 1) / nb;
+
+    // The columns of B are independent, so they are split into chunks that
+    // are updated in parallel. Each panel is applied to all columns of a chunk
+    // at once, using matrix-matrix products, instead of reading all reflectors
+    // again for every column.
+    ThreadPool &pool  = ThreadPool::instance();
+    size_t num_chunks = std::min(pool.get_num_threads(), B.cols() / nb);
+    num_chunks        = std::max(num_chunks, size_t(1));
+    size_t chunk_cols = (B.cols() + num_chunks - 1) / num_chunks;
+
+    // The compact WY form of a single panel is built at a time, so the
+    // temporary storage doesn't grow with the number of panels.
+    Matrix V(m, nb), T(nb, nb), work(nb, B.cols());
+    auto apply_panel = [&](size_t k) {
+        size_t b       = std::min(nb, n - k);
+        MatrixView V_k = V.block(0, 0, m - k, b), T_k = T.block(0, 0, b, b);
+        build_block_reflector(W.block(k, k, m - k, b), V_k, T_k);
+        auto apply_chunk = [&](size_t i) {
+            size_t c  = i * chunk_cols;
+            size_t nc = std::min(chunk_cols, B.cols() - c);
+            apply_block_reflector(V_k, T_k, B.block(k, c, m - k, nc),
+                                  work.block(0, c, b, nc), transpose);
+        };
+        // With a single chunk, the matrix multiplications themselves can
+        // still run in parallel.
+        if (num_chunks == 1)
+            apply_chunk(0);
+        else
+            pool.parallel_for(num_chunks, apply_chunk);
+    };
+    // Qᵀ = Hₙ₋₁·...·H₁·H₀, so the panels are applied in forward order, and in
+    // reverse order for Q = H₀·H₁·...·Hₙ₋₁.
+    if (transpose)
+        for (size_t p = 0; p < num_panels; ++p)
+            apply_panel(p * nb);
+    else
+        for (size_t p = num_panels; p-- > 0;)
+            apply_panel(p * nb);
+}
+
+/// Apply the reflectors to each column of B, one reflector at a time.
+void apply_reflectors_unblocked(ConstMatrixView W, MatrixView B,
+                                bool transpose) {
+    const size_t m = W.rows(), n = W.cols();
+    const size_t rs_W = W.row_stride(), rs_B = B.row_stride();
+    for (size_t i = 0; i < B.cols(); ++i) {
+        // Recall that the Householder reflector H is applied as follows:
+        //     bᵢ'[k+1:m] = H·bᵢ[k+1:m]
+        //                = bᵢ[k+1:m] - wₖ·wₖᵀ·bᵢ[k+1:m]
+        // For Qᵀ, the reflectors are applied in forward order, for Q in
+        // reverse order.
+        for (size_t j = 0; j < n; ++j) {
+            size_t k          = transpose ? j : n - 1 - j;
+            const double *w_k = &W(k, k);
+            double *b_i       = &B(k, i);
+            const size_t len  = m - k;
+            // Compute wₖᵀ·bᵢ
+            double dot_product = 0;
+            for (size_t r = 0; r < len; ++r)
+                dot_product += w_k[r * rs_W] * b_i[r * rs_B];
+            // Subtract wₖ·wₖᵀ·bᵢ
+            for (size_t r = 0; r < len; ++r)
+                b_i[r * rs_B] -= w_k[r * rs_W] * dot_product;
+        }
+    }
+}
+
+} // namespace
+
+void apply_reflectors(ConstMatrixView W, MatrixView B, size_t nb,
+                      bool transpose) {
+    assert(W.rows() == B.rows());
+    assert(W.rows() >= W.cols());
+    // With many right-hand sides, apply the reflectors in blocks.
+    if (nb != 0 && W.cols() > 0 && B.cols() >= nb)
+        apply_reflectors_blocked(W, B, nb, transpose);
+    else
+        apply_reflectors_unblocked(W, B, transpose);
+}
+
+} // namespace kernels
@@ -0,0 +1,37 @@
+#pragma once
+
+#include <linalg/MatrixView.hpp>
+
+#include <cstddef> // size_t
+
+using std::size_t;
+
+/// Householder reflectors, shared by the Householder QR factorizations.
+///
+/// The reflectors Hₖ = I - wₖ·wₖᵀ, with ‖wₖ‖ = √2, are stored in the
+/// lower-triangular part (including the diagonal) of a matrix W: reflector wₖ
+/// is stored in W[k:m,k], its first k elements are zero.
+namespace kernels {
+
+/// Copy the reflectors of a panel W (the columns k through k + V.cols() - 1 of
+/// the full matrix of reflectors, rows k and up) to V, with explicit zeros
+/// above the diagonal, and compute the upper-triangular factor T of their
+/// compact WY form: H₀·H₁·...·Hₕ₋₁ = I - V·T·Vᵀ.
+void build_block_reflector(ConstMatrixView W, MatrixView V, MatrixView T);
+
+/// Apply the block reflector I - V·T·Vᵀ to the m×nc matrix C, or its
+/// transpose if `transpose` is true, using the b×nc workspace W.
+void apply_block_reflector(ConstMatrixView V, ConstMatrixView T, MatrixView C,
+                           MatrixView W, bool transpose);
+
+/// Overwrite B by Qᵀ·B if `transpose` is true, or by Q·B otherwise, where
+/// Q = H₀·H₁·...·Hₙ₋₁ is the product of the reflectors stored in W.
+///
+/// If B has at least nb columns (and nb is nonzero), the reflectors are
+/// applied in panels of nb, using their compact WY form, and chunks of the
+/// columns of B are updated in parallel. Otherwise, they are applied to each
+/// column of B, one reflector at a time.
+void apply_reflectors(ConstMatrixView W, MatrixView B, size_t nb,
+                      bool transpose);
+
+} // namespace kernels
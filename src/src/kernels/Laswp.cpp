@@ -0,0 +1,90 @@
+#include "Laswp.hpp"
+#include "ThreadPool.hpp"
+
+#include <linalg/Runtime.hpp>
+
+#include <algorithm> // std::min, std::swap
+#include <atomic>    // std::atomic
+
+namespace kernels {
+
+namespace {
+
+/// Number of columns per chunk. The two rows that are swapped are then
+/// accessed in at most 2·NB cache lines (for column major storage), which are
+/// reused by the next interchanges that touch the same rows.
+constexpr size_t NB = 32;
+
+/// Permutations of matrices with fewer elements than this are applied on a
+/// single thread, because waking up the workers wouldn't pay off.
+std::atomic<size_t> parallel_permutation_threshold{256 * 1024};
+
+/// Apply the interchanges to the nc columns of a single chunk.
+void laswp_chunk(size_t nc, double *A, size_t rs_A, size_t cs_A,
+                 const size_t *piv, size_t k_begin, size_t k_end,
+                 bool reverse) {
+    auto swap = [&](size_t k) {
+        size_t p = piv[k];
+        if (p == k)
+            return;
+        double *a_k = A + k * rs_A, *a_p = A + p * rs_A;
+        for (size_t j = 0; j < nc; ++j)
+            std::swap(a_k[j * cs_A], a_p[j * cs_A]);
+    };
+    if (reverse)
+        for (size_t k = k_end; k-- > k_begin;)
+            swap(k);
+    else
+        for (size_t k = k_begin; k < k_end; ++k)
+            swap(k);
+}
+
+} // namespace
+
+void laswp(size_t n, double *A, size_t rs_A, size_t cs_A, //
+           const size_t *piv, size_t k_begin, size_t k_end, bool reverse) {
+    if (n == 0 || k_begin >= k_end)
+        return;
+    // The chunks are independent, so they can be permuted in parallel. The
+    // number of rows that are touched is at most max(piv) + 1, but k_end is
+    // a cheaper estimate of the amount of work.
+    ThreadPool &pool   = ThreadPool::instance();
+    size_t num_threads = pool.get_num_threads();
+    bool parallel =
+        num_threads > 1 &&
+        n * k_end >=
+            parallel_permutation_threshold.load(std::memory_order_relaxed);
+    // If the elements of a row are contiguous, swapping entire rows is
+    // already cache friendly, so the columns are only split to divide them
+    // over the threads, in chunks of whole cache lines (8 doubles).
+    size_t nb = NB;
+    if (cs_A == 1) {
+        nb = parallel ? (n + num_threads - 1) / num_threads : n;
+        nb = std::max(NB, (nb + 7) / 8 * 8);
+    }
+    size_t num_chunks = (n + nb - 1) / nb;
+    parallel = parallel && num_chunks > 1;
+
+    auto permute_chunk = [&](size_t i) {
+        size_t j = i * nb;
+        laswp_chunk(std::min(nb, n - j), A + j * cs_A, rs_A, cs_A, piv,
+                    k_begin, k_end, reverse);
+    };
+    if (parallel)
+        pool.parallel_for(num_chunks, permute_chunk);
+    else
+        for (size_t i = 0; i < num_chunks; ++i)
+            permute_chunk(i);
+}
+
+} // namespace kernels
+
+void set_parallel_permutation_threshold(size_t num_elem) {
+    kernels::parallel_permutation_threshold.store(num_elem,
+                                                  std::memory_order_relaxed);
+}
+
+size_t get_parallel_permutation_threshold() {
+    return kernels::parallel_permutation_threshold.load(
+        std::memory_order_relaxed);
+}
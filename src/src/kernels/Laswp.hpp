@@ -0,0 +1,22 @@
+#pragma once
+
+#include <cstddef> // size_t
+
+using std::size_t;
+
+/// @see    Gemm.hpp for the conventions used for strided matrices.
+namespace kernels {
+
+/// Apply a sequence of row interchanges to the n columns of a matrix A: for
+/// each k in [k_begin, k_end), rows k and `piv[k]` are swapped. If `reverse`
+/// is true, the interchanges are applied in the opposite order, which undoes
+/// them.
+///
+/// Unless the rows of A are contiguous, the columns are processed in chunks
+/// that fit in the cache, and all interchanges are applied to one chunk
+/// before moving on to the next. Wide matrices are permuted in parallel, see
+/// @ref set_parallel_permutation_threshold.
+void laswp(size_t n, double *A, size_t rs_A, size_t cs_A, //
+           const size_t *piv, size_t k_begin, size_t k_end, bool reverse);
+
+} // namespace kernels
@@ -0,0 +1,34 @@
+#include "Lu.hpp"
+#include "Gemm.hpp"
+#include "Trsm.hpp"
+
+namespace kernels {
+
+void lu_trailing_update(size_t n, size_t k, size_t b, //
+                        double *A, size_t rs_A, size_t cs_A) {
+    // Partition the active part of the matrix as
+    //     ┌         ┐   ┌         ┐┌         ┐
+    //     │ A₁₁ A₁₂ │ = │ L₁₁     ││ U₁₁ U₁₂ │
+    //     │ A₂₁ A₂₂ │   │ L₂₁ I   ││     A₂₂'│
+    //     └         ┘   └         ┘└         ┘
+    // where A₁₁ is b×b. The panel factorization computed L₁₁, L₂₁ and U₁₁,
+    // the remaining blocks follow from the block products:
+    //     A₁₂ = L₁₁·U₁₂            ⟺ U₁₂  = L₁₁⁻¹·A₁₂
+    //     A₂₂ = L₂₁·U₁₂ + A₂₂'     ⟺ A₂₂' = A₂₂ - L₂₁·U₁₂
+    // A₂₂' is the trailing submatrix that is factored next.
+    auto a = [&](size_t i, size_t j) { return A + i * rs_A + j * cs_A; };
+    size_t nt = n - k - b;
+    const double *L11 = a(k, k), *L21 = a(k + b, k);
+    double *A12 = a(k, k + b), *A22 = a(k + b, k + b);
+
+    // U₁₂ = L₁₁⁻¹·A₁₂ (overwrites A₁₂)
+    trsm(Side::Left, Triangle::Lower, Diagonal::Unit, b, nt, //
+         L11, rs_A, cs_A, A12, rs_A, cs_A);
+    // A₂₂' = A₂₂ - L₂₁·U₁₂
+    gemm(nt, nt, b,           //
+         -1, L21, rs_A, cs_A, //
+         A12, rs_A, cs_A,     //
+         1, A22, rs_A, cs_A);
+}
+
+} // namespace kernels
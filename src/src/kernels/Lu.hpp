@@ -0,0 +1,19 @@
+#pragma once
+
+#include <cstddef> // size_t
+
+using std::size_t;
+
+/// @see    Gemm.hpp for the conventions used for strided matrices.
+namespace kernels {
+
+/// Trailing update of the right-looking blocked LU factorization of the n×n
+/// matrix A, which stores the factors L (strict lower part) and U (upper
+/// part) in place: after the b columns starting at column k have been
+/// factored, compute the rows k through k + b - 1 of U to the right of the
+/// panel, and apply the elimination steps of the panel to the trailing
+/// submatrix A(k+b:n,k+b:n).
+void lu_trailing_update(size_t n, size_t k, size_t b, //
+                        double *A, size_t rs_A, size_t cs_A);
+
+} // namespace kernels
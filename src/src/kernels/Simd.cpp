@@ -0,0 +1,558 @@
+#include "Simd.hpp"
+
+#include <linalg/Runtime.hpp>
+
+#include <atomic>  // std::atomic
+#include <cstdlib> // std::getenv
+#include <cstring> // std::strcmp
+
+#if defined(__x86_64__) && (defined(__GNUC__) || defined(__clang__))
+#define LINALG_SIMD_X86 1
+#include <immintrin.h>
+#else
+#define LINALG_SIMD_X86 0
+#endif
+
+namespace kernels {
+
+namespace {
+
+constexpr size_t MR = gemm_mr;
+constexpr size_t NR = gemm_nr;
+constexpr size_t TT = transpose_tile;
+
+//                                  Generic                                   //
+// :::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::: //
+
+#pragma region // Generic ------------------------------------------------------
+
+// Portable implementations, these are used as a fallback and to handle the
+// remainders of the vectorized loops.
+
+bool supported_generic() { return true; }
+
+void add_generic(size_t n, const double *a, const double *b, double *c) {
+    for (size_t i = 0; i < n; ++i)
+        c[i] = a[i] + b[i];
+}
+
+void sub_generic(size_t n, const double *a, const double *b, double *c) {
+    for (size_t i = 0; i < n; ++i)
+        c[i] = a[i] - b[i];
+}
+
+void neg_generic(size_t n, const double *a, double *c) {
+    for (size_t i = 0; i < n; ++i)
+        c[i] = -a[i];
+}
+
+void mul_scalar_generic(size_t n, const double *a, double s, double *c) {
+    for (size_t i = 0; i < n; ++i)
+        c[i] = a[i] * s;
+}
+
+void div_scalar_generic(size_t n, const double *a, double s, double *c) {
+    for (size_t i = 0; i < n; ++i)
+        c[i] = a[i] / s;
+}
+
+double dot_generic(size_t n, const double *a, const double *b) {
+    // Use four independent accumulators, so consecutive additions don't have
+    // to wait for each other.
+    double s0 = 0, s1 = 0, s2 = 0, s3 = 0;
+    size_t i = 0;
+    for (; i + 4 <= n; i += 4) {
+        s0 += a[i + 0] * b[i + 0];
+        s1 += a[i + 1] * b[i + 1];
+        s2 += a[i + 2] * b[i + 2];
+        s3 += a[i + 3] * b[i + 3];
+    }
+    for (; i < n; ++i)
+        s0 += a[i] * b[i];
+    return (s0 + s1) + (s2 + s3);
+}
+
+void axpy_generic(size_t n, double s, const double *x, double *y) {
+    for (size_t i = 0; i < n; ++i)
+        y[i] += s * x[i];
+}
+
+void gemm_micro_kernel_generic(size_t kc, const double *a, const double *b,
+                               double *ab) {
+    double acc[NR][MR] = {};
+    for (size_t p = 0; p < kc; ++p) {
+        for (size_t j = 0; j < NR; ++j)
+            for (size_t i = 0; i < MR; ++i)
+                acc[j][i] += a[i] * b[j];
+        a += MR;
+        b += NR;
+    }
+    for (size_t j = 0; j < NR; ++j)
+        for (size_t i = 0; i < MR; ++i)
+            ab[i + MR * j] = acc[j][i];
+}
+
+void transpose_tile_generic(const double *a, size_t lda, double *b,
+                            size_t ldb) {
+    for (size_t j = 0; j < TT; ++j)
+        for (size_t i = 0; i < TT; ++i)
+            b[j + ldb * i] = a[i + lda * j];
+}
+
+#pragma endregion // -----------------------------------------------------------
+
+#if LINALG_SIMD_X86
+
+//                                    SSE2                                    //
+// :::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::: //
+
+#pragma region // SSE2 ---------------------------------------------------------
+
+// SSE2 is part of the x86-64 baseline, so it is always supported.
+
+bool supported_sse2() { return true; }
+
+__attribute__((target("sse2"))) //
+void add_sse2(size_t n, const double *a, const double *b, double *c) {
+    size_t i = 0;
+    for (; i + 2 <= n; i += 2)
+        _mm_storeu_pd(c + i,
+                      _mm_add_pd(_mm_loadu_pd(a + i), _mm_loadu_pd(b + i)));
+    add_generic(n - i, a + i, b + i, c + i);
+}
+
+__attribute__((target("sse2"))) //
+void sub_sse2(size_t n, const double *a, const double *b, double *c) {
+    size_t i = 0;
+    for (; i + 2 <= n; i += 2)
+        _mm_storeu_pd(c + i,
+                      _mm_sub_pd(_mm_loadu_pd(a + i), _mm_loadu_pd(b + i)));
+    sub_generic(n - i, a + i, b + i, c + i);
+}
+
+__attribute__((target("sse2"))) //
+void neg_sse2(size_t n, const double *a, double *c) {
+    const __m128d sign = _mm_set1_pd(-0.0);
+    size_t i = 0;
+    for (; i + 2 <= n; i += 2)
+        _mm_storeu_pd(c + i, _mm_xor_pd(_mm_loadu_pd(a + i), sign));
+    neg_generic(n - i, a + i, c + i);
+}
+
+__attribute__((target("sse2"))) //
+void mul_scalar_sse2(size_t n, const double *a, double s, double *c) {
+    const __m128d vs = _mm_set1_pd(s);
+    size_t i = 0;
+    for (; i + 2 <= n; i += 2)
+        _mm_storeu_pd(c + i, _mm_mul_pd(_mm_loadu_pd(a + i), vs));
+    mul_scalar_generic(n - i, a + i, s, c + i);
+}
+
+__attribute__((target("sse2"))) //
+void div_scalar_sse2(size_t n, const double *a, double s, double *c) {
+    const __m128d vs = _mm_set1_pd(s);
+    size_t i = 0;
+    for (; i + 2 <= n; i += 2)
+        _mm_storeu_pd(c + i, _mm_div_pd(_mm_loadu_pd(a + i), vs));
+    div_scalar_generic(n - i, a + i, s, c + i);
+}
+
+__attribute__((target("sse2"))) //
+double dot_sse2(size_t n, const double *a, const double *b) {
+    __m128d s0 = _mm_setzero_pd(), s1 = _mm_setzero_pd();
+    __m128d s2 = _mm_setzero_pd(), s3 = _mm_setzero_pd();
+    size_t i = 0;
+    for (; i + 8 <= n; i += 8) {
+        s0 = _mm_add_pd(s0, _mm_mul_pd(_mm_loadu_pd(a + i + 0),
+                                       _mm_loadu_pd(b + i + 0)));
+        s1 = _mm_add_pd(s1, _mm_mul_pd(_mm_loadu_pd(a + i + 2),
+                                       _mm_loadu_pd(b + i + 2)));
+        s2 = _mm_add_pd(s2, _mm_mul_pd(_mm_loadu_pd(a + i + 4),
+                                       _mm_loadu_pd(b + i + 4)));
+        s3 = _mm_add_pd(s3, _mm_mul_pd(_mm_loadu_pd(a + i + 6),
+                                       _mm_loadu_pd(b + i + 6)));
+    }
+    __m128d s = _mm_add_pd(_mm_add_pd(s0, s1), _mm_add_pd(s2, s3));
+    double lanes[2];
+    _mm_storeu_pd(lanes, s);
+    return lanes[0] + lanes[1] + dot_generic(n - i, a + i, b + i);
+}
+
+__attribute__((target("sse2"))) //
+void axpy_sse2(size_t n, double s, const double *x, double *y) {
+    const __m128d vs = _mm_set1_pd(s);
+    size_t i = 0;
+    for (; i + 2 <= n; i += 2)
+        _mm_storeu_pd(y + i, _mm_add_pd(_mm_loadu_pd(y + i),
+                                        _mm_mul_pd(_mm_loadu_pd(x + i), vs)));
+    axpy_generic(n - i, s, x + i, y + i);
+}
+
+__attribute__((target("sse2"))) //
+void gemm_micro_kernel_sse2(size_t kc, const double *a, const double *b,
+                            double *ab) {
+    // Each column of the MR×NR block is stored in MR / 2 registers.
+    __m128d acc[NR][MR / 2];
+    for (size_t j = 0; j < NR; ++j)
+        for (size_t h = 0; h < MR / 2; ++h)
+            acc[j][h] = _mm_setzero_pd();
+    for (size_t p = 0; p < kc; ++p) {
+        __m128d av[MR / 2];
+        for (size_t h = 0; h < MR / 2; ++h)
+            av[h] = _mm_loadu_pd(a + 2 * h);
+        for (size_t j = 0; j < NR; ++j) {
+            __m128d bv = _mm_set1_pd(b[j]);
+            for (size_t h = 0; h < MR / 2; ++h)
+                acc[j][h] = _mm_add_pd(acc[j][h], _mm_mul_pd(av[h], bv));
+        }
+        a += MR;
+        b += NR;
+    }
+    for (size_t j = 0; j < NR; ++j)
+        for (size_t h = 0; h < MR / 2; ++h)
+            _mm_storeu_pd(ab + MR * j + 2 * h, acc[j][h]);
+}
+
+__attribute__((target("sse2"))) //
+void transpose_tile_sse2(const double *a, size_t lda, double *b, size_t ldb) {
+    // Transpose each 2×2 sub-block (i, j) of a into sub-block (j, i) of b:
+    // the unpack instructions interleave two columns into two rows.
+    for (size_t j = 0; j < TT; j += 2) {
+        for (size_t i = 0; i < TT; i += 2) {
+            __m128d c0 = _mm_loadu_pd(a + i + lda * j);
+            __m128d c1 = _mm_loadu_pd(a + i + lda * (j + 1));
+            _mm_storeu_pd(b + j + ldb * i, _mm_unpacklo_pd(c0, c1));
+            _mm_storeu_pd(b + j + ldb * (i + 1), _mm_unpackhi_pd(c0, c1));
+        }
+    }
+}
+
+#pragma endregion // -----------------------------------------------------------
+
+//                                    AVX2                                    //
+// :::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::: //
+
+#pragma region // AVX2 ---------------------------------------------------------
+
+bool supported_avx2() {
+    return __builtin_cpu_supports("avx2") && __builtin_cpu_supports("fma");
+}
+
+__attribute__((target("avx2,fma"))) //
+void add_avx2(size_t n, const double *a, const double *b, double *c) {
+    size_t i = 0;
+    for (; i + 4 <= n; i += 4)
+        _mm256_storeu_pd(c + i, _mm256_add_pd(_mm256_loadu_pd(a + i),
+                                              _mm256_loadu_pd(b + i)));
+    add_generic(n - i, a + i, b + i, c + i);
+}
+
+__attribute__((target("avx2,fma"))) //
+void sub_avx2(size_t n, const double *a, const double *b, double *c) {
+    size_t i = 0;
+    for (; i + 4 <= n; i += 4)
+        _mm256_storeu_pd(c + i, _mm256_sub_pd(_mm256_loadu_pd(a + i),
+                                              _mm256_loadu_pd(b + i)));
+    sub_generic(n - i, a + i, b + i, c + i);
+}
+
+__attribute__((target("avx2,fma"))) //
+void neg_avx2(size_t n, const double *a, double *c) {
+    const __m256d sign = _mm256_set1_pd(-0.0);
+    size_t i = 0;
+    for (; i + 4 <= n; i += 4)
+        _mm256_storeu_pd(c + i, _mm256_xor_pd(_mm256_loadu_pd(a + i), sign));
+    neg_generic(n - i, a + i, c + i);
+}
+
+__attribute__((target("avx2,fma"))) //
+void mul_scalar_avx2(size_t n, const double *a, double s, double *c) {
+    const __m256d vs = _mm256_set1_pd(s);
+    size_t i = 0;
+    for (; i + 4 <= n; i += 4)
+        _mm256_storeu_pd(c + i, _mm256_mul_pd(_mm256_loadu_pd(a + i), vs));
+    mul_scalar_generic(n - i, a + i, s, c + i);
+}
+
+__attribute__((target("avx2,fma"))) //
+void div_scalar_avx2(size_t n, const double *a, double s, double *c) {
+    const __m256d vs = _mm256_set1_pd(s);
+    size_t i = 0;
+    for (; i + 4 <= n; i += 4)
+        _mm256_storeu_pd(c + i, _mm256_div_pd(_mm256_loadu_pd(a + i), vs));
+    div_scalar_generic(n - i, a + i, s, c + i);
+}
+
+__attribute__((target("avx2,fma"))) //
+double dot_avx2(size_t n, const double *a, const double *b) {
+    __m256d s0 = _mm256_setzero_pd(), s1 = _mm256_setzero_pd();
+    __m256d s2 = _mm256_setzero_pd(), s3 = _mm256_setzero_pd();
+    size_t i = 0;
+    for (; i + 16 <= n; i += 16) {
+        s0 = _mm256_fmadd_pd(_mm256_loadu_pd(a + i + 0),
+                             _mm256_loadu_pd(b + i + 0), s0);
+        s1 = _mm256_fmadd_pd(_mm256_loadu_pd(a + i + 4),
+                             _mm256_loadu_pd(b + i + 4), s1);
+        s2 = _mm256_fmadd_pd(_mm256_loadu_pd(a + i + 8),
+                             _mm256_loadu_pd(b + i + 8), s2);
+        s3 = _mm256_fmadd_pd(_mm256_loadu_pd(a + i + 12),
+                             _mm256_loadu_pd(b + i + 12), s3);
+    }
+    __m256d s = _mm256_add_pd(_mm256_add_pd(s0, s1), _mm256_add_pd(s2, s3));
+    double lanes[4];
+    _mm256_storeu_pd(lanes, s);
+    // GCC doesn't insert a vzeroupper before the call to the (non-VEX)
+    // generic kernel here, because the partial sum stays in a register. Mixing
+    // dirty upper halves with legacy SSE instructions costs hundreds of
+    // cycles, so clear them explicitly.
+    _mm256_zeroupper();
+    return (lanes[0] + lanes[1]) + (lanes[2] + lanes[3]) +
+           dot_generic(n - i, a + i, b + i);
+}
+
+__attribute__((target("avx2,fma"))) //
+void axpy_avx2(size_t n, double s, const double *x, double *y) {
+    const __m256d vs = _mm256_set1_pd(s);
+    size_t i = 0;
+    for (; i + 4 <= n; i += 4)
+        _mm256_storeu_pd(y + i, _mm256_fmadd_pd(_mm256_loadu_pd(x + i), vs,
+                                                _mm256_loadu_pd(y + i)));
+    axpy_generic(n - i, s, x + i, y + i);
+}
+
+__attribute__((target("avx2,fma"))) //
+void gemm_micro_kernel_avx2(size_t kc, const double *a, const double *b,
+                            double *ab) {
+    // Each column of the 8×4 block is stored in two registers, which gives
+    // eight independent accumulators, enough to hide the latency of the FMA
+    // instructions.
+    __m256d acc[NR][MR / 4];
+    for (size_t j = 0; j < NR; ++j)
+        for (size_t h = 0; h < MR / 4; ++h)
+            acc[j][h] = _mm256_setzero_pd();
+    for (size_t p = 0; p < kc; ++p) {
+        __m256d av[MR / 4];
+        for (size_t h = 0; h < MR / 4; ++h)
+            av[h] = _mm256_loadu_pd(a + 4 * h);
+        for (size_t j = 0; j < NR; ++j) {
+            __m256d bv = _mm256_broadcast_sd(b + j);
+            for (size_t h = 0; h < MR / 4; ++h)
+                acc[j][h] = _mm256_fmadd_pd(av[h], bv, acc[j][h]);
+        }
+        a += MR;
+        b += NR;
+    }
+    for (size_t j = 0; j < NR; ++j)
+        for (size_t h = 0; h < MR / 4; ++h)
+            _mm256_storeu_pd(ab + MR * j + 4 * h, acc[j][h]);
+}
+
+__attribute__((target("avx2,fma"))) //
+void transpose_tile_avx2(const double *a, size_t lda, double *b, size_t ldb) {
+    // Load the four columns of a, interleave pairs of columns within each
+    // 128-bit lane, and then combine the lanes to form the rows of a.
+    __m256d c0 = _mm256_loadu_pd(a + lda * 0);
+    __m256d c1 = _mm256_loadu_pd(a + lda * 1);
+    __m256d c2 = _mm256_loadu_pd(a + lda * 2);
+    __m256d c3 = _mm256_loadu_pd(a + lda * 3);
+    __m256d t0 = _mm256_unpacklo_pd(c0, c1); // a00 a01 a20 a21
+    __m256d t1 = _mm256_unpackhi_pd(c0, c1); // a10 a11 a30 a31
+    __m256d t2 = _mm256_unpacklo_pd(c2, c3); // a02 a03 a22 a23
+    __m256d t3 = _mm256_unpackhi_pd(c2, c3); // a12 a13 a32 a33
+    _mm256_storeu_pd(b + ldb * 0, _mm256_permute2f128_pd(t0, t2, 0x20));
+    _mm256_storeu_pd(b + ldb * 1, _mm256_permute2f128_pd(t1, t3, 0x20));
+    _mm256_storeu_pd(b + ldb * 2, _mm256_permute2f128_pd(t0, t2, 0x31));
+    _mm256_storeu_pd(b + ldb * 3, _mm256_permute2f128_pd(t1, t3, 0x31));
+}
+
+#pragma endregion // -----------------------------------------------------------
+
+//                                  AVX-512                                   //
+// :::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::: //
+
+#pragma region // AVX-512 ------------------------------------------------------
+
+bool supported_avx512() { return __builtin_cpu_supports("avx512f"); }
+
+__attribute__((target("avx512f"))) //
+void add_avx512(size_t n, const double *a, const double *b, double *c) {
+    size_t i = 0;
+    for (; i + 8 <= n; i += 8)
+        _mm512_storeu_pd(c + i, _mm512_add_pd(_mm512_loadu_pd(a + i),
+                                              _mm512_loadu_pd(b + i)));
+    add_generic(n - i, a + i, b + i, c + i);
+}
+
+__attribute__((target("avx512f"))) //
+void sub_avx512(size_t n, const double *a, const double *b, double *c) {
+    size_t i = 0;
+    for (; i + 8 <= n; i += 8)
+        _mm512_storeu_pd(c + i, _mm512_sub_pd(_mm512_loadu_pd(a + i),
+                                              _mm512_loadu_pd(b + i)));
+    sub_generic(n - i, a + i, b + i, c + i);
+}
+
+__attribute__((target("avx512f"))) //
+void neg_avx512(size_t n, const double *a, double *c) {
+    // AVX-512F has no floating point XOR, so subtract from zero instead.
+    // -0.0 is used rather than 0.0 so that the sign of zeros is flipped.
+    const __m512d zero = _mm512_set1_pd(-0.0);
+    size_t i = 0;
+    for (; i + 8 <= n; i += 8)
+        _mm512_storeu_pd(c + i, _mm512_sub_pd(zero, _mm512_loadu_pd(a + i)));
+    neg_generic(n - i, a + i, c + i);
+}
+
+__attribute__((target("avx512f"))) //
+void mul_scalar_avx512(size_t n, const double *a, double s, double *c) {
+    const __m512d vs = _mm512_set1_pd(s);
+    size_t i = 0;
+    for (; i + 8 <= n; i += 8)
+        _mm512_storeu_pd(c + i, _mm512_mul_pd(_mm512_loadu_pd(a + i), vs));
+    mul_scalar_generic(n - i, a + i, s, c + i);
+}
+
+__attribute__((target("avx512f"))) //
+void div_scalar_avx512(size_t n, const double *a, double s, double *c) {
+    const __m512d vs = _mm512_set1_pd(s);
+    size_t i = 0;
+    for (; i + 8 <= n; i += 8)
+        _mm512_storeu_pd(c + i, _mm512_div_pd(_mm512_loadu_pd(a + i), vs));
+    div_scalar_generic(n - i, a + i, s, c + i);
+}
+
+__attribute__((target("avx512f"))) //
+double dot_avx512(size_t n, const double *a, const double *b) {
+    __m512d s0 = _mm512_setzero_pd(), s1 = _mm512_setzero_pd();
+    __m512d s2 = _mm512_setzero_pd(), s3 = _mm512_setzero_pd();
+    size_t i = 0;
+    for (; i + 32 <= n; i += 32) {
+        s0 = _mm512_fmadd_pd(_mm512_loadu_pd(a + i + 0),
+                             _mm512_loadu_pd(b + i + 0), s0);
+        s1 = _mm512_fmadd_pd(_mm512_loadu_pd(a + i + 8),
+                             _mm512_loadu_pd(b + i + 8), s1);
+        s2 = _mm512_fmadd_pd(_mm512_loadu_pd(a + i + 16),
+                             _mm512_loadu_pd(b + i + 16), s2);
+        s3 = _mm512_fmadd_pd(_mm512_loadu_pd(a + i + 24),
+                             _mm512_loadu_pd(b + i + 24), s3);
+    }
+    __m512d s = _mm512_add_pd(_mm512_add_pd(s0, s1), _mm512_add_pd(s2, s3));
+    // Not _mm512_reduce_add_pd, GCC 12 warns about the uninitialized vector
+    // it uses internally when optimizations are enabled.
+    double lanes[8];
+    _mm512_storeu_pd(lanes, s);
+    double sum = ((lanes[0] + lanes[1]) + (lanes[2] + lanes[3])) +
+                 ((lanes[4] + lanes[5]) + (lanes[6] + lanes[7]));
+    _mm256_zeroupper(); // See dot_avx2.
+    return sum + dot_generic(n - i, a + i, b + i);
+}
+
+__attribute__((target("avx512f"))) //
+void axpy_avx512(size_t n, double s, const double *x, double *y) {
+    const __m512d vs = _mm512_set1_pd(s);
+    size_t i = 0;
+    for (; i + 8 <= n; i += 8)
+        _mm512_storeu_pd(y + i, _mm512_fmadd_pd(_mm512_loadu_pd(x + i), vs,
+                                                _mm512_loadu_pd(y + i)));
+    axpy_generic(n - i, s, x + i, y + i);
+}
+
+__attribute__((target("avx512f"))) //
+void gemm_micro_kernel_avx512(size_t kc, const double *a, const double *b,
+                              double *ab) {
+    // A column of the 8×4 block fits in a single register. To still have
+    // eight independent accumulators, even and odd iterations of the k-loop
+    // accumulate into separate registers, which are summed at the end.
+    __m512d acc0[NR], acc1[NR];
+    for (size_t j = 0; j < NR; ++j)
+        acc0[j] = acc1[j] = _mm512_setzero_pd();
+    size_t p = 0;
+    for (; p + 2 <= kc; p += 2) {
+        __m512d a0 = _mm512_loadu_pd(a);
+        __m512d a1 = _mm512_loadu_pd(a + MR);
+        for (size_t j = 0; j < NR; ++j) {
+            acc0[j] = _mm512_fmadd_pd(a0, _mm512_set1_pd(b[j]), acc0[j]);
+            acc1[j] = _mm512_fmadd_pd(a1, _mm512_set1_pd(b[NR + j]), acc1[j]);
+        }
+        a += 2 * MR;
+        b += 2 * NR;
+    }
+    if (p < kc) {
+        __m512d a0 = _mm512_loadu_pd(a);
+        for (size_t j = 0; j < NR; ++j)
+            acc0[j] = _mm512_fmadd_pd(a0, _mm512_set1_pd(b[j]), acc0[j]);
+    }
+    for (size_t j = 0; j < NR; ++j)
+        _mm512_storeu_pd(ab + MR * j, _mm512_add_pd(acc0[j], acc1[j]));
+}
+
+#pragma endregion // -----------------------------------------------------------
+
+#endif // LINALG_SIMD_X86
+
+//                                  Dispatch                                  //
+// :::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::: //
+
+/// All kernel sets, in order of preference.
+const SimdKernels kernel_sets[] = {
+#if LINALG_SIMD_X86
+    // A 4×4 tile of doubles fits in four AVX registers, so the AVX-512 set
+    // reuses the AVX2 transpose (every CPU with AVX-512F supports AVX2).
+    {"avx512", supported_avx512, add_avx512, sub_avx512, neg_avx512,
+     mul_scalar_avx512, div_scalar_avx512, dot_avx512, axpy_avx512,
+     gemm_micro_kernel_avx512, transpose_tile_avx2},
+    {"avx2", supported_avx2, add_avx2, sub_avx2, neg_avx2, mul_scalar_avx2,
+     div_scalar_avx2, dot_avx2, axpy_avx2, gemm_micro_kernel_avx2,
+     transpose_tile_avx2},
+    {"sse2", supported_sse2, add_sse2, sub_sse2, neg_sse2, mul_scalar_sse2,
+     div_scalar_sse2, dot_sse2, axpy_sse2, gemm_micro_kernel_sse2,
+     transpose_tile_sse2},
+#endif
+    {"generic", supported_generic, add_generic, sub_generic, neg_generic,
+     mul_scalar_generic, div_scalar_generic, dot_generic, axpy_generic,
+     gemm_micro_kernel_generic, transpose_tile_generic},
+};
+
+/// Find the kernel set with the given name, if it is supported by the CPU.
+const SimdKernels *find_kernel_set(const char *name) {
+    for (const SimdKernels &k : kernel_sets)
+        if (std::strcmp(k.name, name) == 0)
+            return k.supported() ? &k : nullptr;
+    return nullptr;
+}
+
+/// Select the kernel set to use if the user didn't specify one explicitly.
+const SimdKernels *default_kernel_set() {
+    const char *env = std::getenv("LINALG_SIMD");
+    if (env != nullptr)
+        if (const SimdKernels *k = find_kernel_set(env))
+            return k;
+    for (const SimdKernels &k : kernel_sets)
+        if (k.supported())
+            return &k;
+    return nullptr; // unreachable, the generic kernels are always supported
+}
+
+/// The active kernel set, selected the first time it's needed.
+std::atomic<const SimdKernels *> &active_kernel_set() {
+    static std::atomic<const SimdKernels *> active{default_kernel_set()};
+    return active;
+}
+
+} // namespace
+
+const SimdKernels &simd() {
+    return *active_kernel_set().load(std::memory_order_relaxed);
+}
+
+} // namespace kernels
+
+const char *get_simd_kernel_set() { return kernels::simd().name; }
+
+bool set_simd_kernel_set(const char *name) {
+    const kernels::SimdKernels *k = kernels::find_kernel_set(name);
+    if (k == nullptr)
+        return false;
+    kernels::active_kernel_set().store(k, std::memory_order_relaxed);
+    return true;
+}
@@ -0,0 +1,62 @@
+#pragma once
+
+#include <cstddef> // size_t
+
+using std::size_t;
+
+namespace kernels {
+
+/// Number of rows of the register block computed by the GEMM micro-kernels.
+constexpr size_t gemm_mr = 8;
+/// Number of columns of the register block computed by the GEMM
+/// micro-kernels.
+constexpr size_t gemm_nr = 4;
+/// Number of rows and columns of the blocks that are transposed in registers.
+constexpr size_t transpose_tile = 4;
+
+/// Table of the kernels that are implemented using explicit SIMD instructions.
+/// There is one table per instruction set, the best one that is supported by
+/// the CPU is selected at runtime, see @ref simd.
+///
+/// The output arrays of the element-wise kernels may alias their inputs.
+struct SimdKernels {
+    /// Name of the instruction set ("generic", "sse2", "avx2" or "avx512").
+    const char *name;
+    /// Check whether the current CPU supports this instruction set.
+    bool (*supported)();
+
+    /// c = a + b
+    void (*add)(size_t n, const double *a, const double *b, double *c);
+    /// c = a - b
+    void (*sub)(size_t n, const double *a, const double *b, double *c);
+    /// c = -a
+    void (*neg)(size_t n, const double *a, double *c);
+    /// c = a · s
+    void (*mul_scalar)(size_t n, const double *a, double s, double *c);
+    /// c = a / s
+    void (*div_scalar)(size_t n, const double *a, double s, double *c);
+    /// aᵀb
+    double (*dot)(size_t n, const double *a, const double *b);
+    /// y = y + s · x
+    void (*axpy)(size_t n, double s, const double *x, double *y);
+
+    /// Multiply a packed @ref gemm_mr × kc sliver of A (column by column) by a
+    /// packed kc × @ref gemm_nr sliver of B (row by row), and store the
+    /// result in the column major @ref gemm_mr × @ref gemm_nr array ab.
+    void (*gemm_micro_kernel)(size_t kc, const double *a, const double *b,
+                              double *ab);
+
+    /// Transpose the @ref transpose_tile × @ref transpose_tile block a, whose
+    /// columns are lda elements apart, and store the result in block b,
+    /// whose columns are ldb elements apart. The blocks may not overlap.
+    void (*transpose_tile)(const double *a, size_t lda, double *b,
+                           size_t ldb);
+};
+
+/// Get the kernels for the instruction set that is currently active.
+/// By default, this is the most recent instruction set supported by the CPU,
+/// unless overridden by the `LINALG_SIMD` environment variable or by
+/// @ref set_simd_kernel_set.
+const SimdKernels &simd();
+
+} // namespace kernels
@@ -0,0 +1,167 @@
+#include "ThreadPool.hpp"
+
+#include <linalg/Runtime.hpp>
+
+#include <chrono>  // std::chrono::seconds
+#include <cstdlib> // std::getenv, std::strtoul
+
+namespace kernels {
+
+namespace {
+
+/// Set while the current thread is executing tasks of a parallel loop, to
+/// detect nested parallel loops.
+thread_local bool inside_parallel_loop = false;
+
+/// Equivalent to `cv.wait(lck, pred)`.
+/// Implemented using `wait_for`, which is defined inline in the standard
+/// library headers, whereas `wait` is not, and requires the latest libstdc++
+/// runtime (GLIBCXX_3.4.30) when compiled with GCC 12 or later. This way, the
+/// library keeps working on systems with an older runtime.
+template <class Predicate>
+void wait(std::condition_variable &cv, std::unique_lock<std::mutex> &lck,
+          Predicate pred) {
+    while (!pred())
+        cv.wait_for(lck, std::chrono::seconds(1));
+}
+
+size_t hardware_threads() {
+    size_t n = std::thread::hardware_concurrency();
+    return n > 0 ? n : 1;
+}
+
+size_t default_num_threads() {
+    const char *env = std::getenv("LINALG_NUM_THREADS");
+    if (env != nullptr) {
+        size_t n = std::strtoul(env, nullptr, 10);
+        if (n > 0)
+            return n;
+    }
+    return hardware_threads();
+}
+
+} // namespace
+
+ThreadPool &ThreadPool::instance() {
+    static ThreadPool pool(default_num_threads());
+    return pool;
+}
+
+ThreadPool::~ThreadPool() { stop(); }
+
+void ThreadPool::set_num_threads(size_t num_threads) {
+    if (num_threads == 0)
+        num_threads = hardware_threads();
+    std::lock_guard<std::mutex> loop_lck(loop_mtx);
+    if (num_threads == get_num_threads())
+        return;
+    stop();
+    start(num_threads);
+}
+
+void ThreadPool::start(size_t num_threads) {
+    stopping = false;
+    // The calling thread takes part in every loop, so it doesn't need a
+    // worker of its own.
+    for (size_t i = 1; i < num_threads; ++i)
+        workers.emplace_back(&ThreadPool::worker_loop, this, generation);
+    num_workers.store(workers.size(), std::memory_order_relaxed);
+}
+
+void ThreadPool::stop() {
+    {
+        std::lock_guard<std::mutex> lck(mtx);
+        stopping = true;
+    }
+    cv_start.notify_all();
+    for (std::thread &t : workers)
+        t.join();
+    workers.clear();
+    num_workers.store(0, std::memory_order_relaxed);
+}
+
+void ThreadPool::worker_loop(unsigned long seen_generation) {
+    inside_parallel_loop = true;
+    std::unique_lock<std::mutex> lck(mtx);
+    while (true) {
+        wait(cv_start, lck, [&] {
+            return stopping || generation != seen_generation;
+        });
+        if (stopping)
+            return;
+        seen_generation = generation;
+        lck.unlock();
+        run_tasks();
+        lck.lock();
+        if (--busy_workers == 0)
+            cv_done.notify_one();
+    }
+}
+
+void ThreadPool::run_tasks() {
+    size_t i;
+    try {
+        while ((i = next_task.fetch_add(1, std::memory_order_relaxed)) <
+               num_tasks)
+            (*task)(i);
+    } catch (...) {
+        // Skip the remaining tasks, and keep the first exception so it can be
+        // rethrown by parallel_for.
+        next_task.store(num_tasks, std::memory_order_relaxed);
+        std::lock_guard<std::mutex> lck(mtx);
+        if (!error)
+            error = std::current_exception();
+    }
+}
+
+void ThreadPool::parallel_for(size_t n,
+                              const std::function<void(size_t)> &task) {
+    auto run_serially = [&] {
+        for (size_t i = 0; i < n; ++i)
+            task(i);
+    };
+    if (n <= 1 || inside_parallel_loop)
+        return run_serially();
+    // The workers can only be accessed while holding loop_mtx, because
+    // set_num_threads may be called from another thread.
+    std::unique_lock<std::mutex> loop_lck(loop_mtx, std::try_to_lock);
+    if (!loop_lck.owns_lock() || workers.empty())
+        return run_serially();
+
+    // Publish the loop and wake up the workers:
+    {
+        std::lock_guard<std::mutex> lck(mtx);
+        this->task = &task;
+        this->num_tasks = n;
+        this->next_task.store(0, std::memory_order_relaxed);
+        this->busy_workers = workers.size();
+        ++generation;
+    }
+    cv_start.notify_all();
+
+    // The calling thread helps with the work:
+    inside_parallel_loop = true;
+    run_tasks();
+    inside_parallel_loop = false;
+
+    // Wait for the workers to finish their last task, they still refer to
+    // the task, even if it threw on this thread:
+    std::unique_lock<std::mutex> lck(mtx);
+    wait(cv_done, lck, [&] { return busy_workers == 0; });
+    this->task = nullptr;
+    if (error) {
+        std::exception_ptr e = error;
+        error = nullptr;
+        std::rethrow_exception(e);
+    }
+}
+
+} // namespace kernels
+
+void set_num_threads(size_t num_threads) {
+    kernels::ThreadPool::instance().set_num_threads(num_threads);
+}
+
+size_t get_num_threads() {
+    return kernels::ThreadPool::instance().get_num_threads();
+}
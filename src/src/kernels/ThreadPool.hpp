@@ -0,0 +1,82 @@
+#pragma once
+
+#include <atomic>             // std::atomic
+#include <condition_variable> // std::condition_variable
+#include <cstddef>            // size_t
+#include <exception>          // std::exception_ptr
+#include <functional>         // std::function
+#include <mutex>              // std::mutex
+#include <thread>             // std::thread
+#include <vector>             // std::vector
+
+using std::size_t;
+
+namespace kernels {
+
+/// Persistent pool of worker threads, owned by the library and shared by all
+/// parallel kernels.
+///
+/// The threads are created once and sleep while there is no work, so starting
+/// a parallel operation only costs a wake-up, not a thread creation.
+class ThreadPool {
+  public:
+    /// Get the global thread pool. It's created the first time it's needed,
+    /// with the number of threads given by the `LINALG_NUM_THREADS`
+    /// environment variable, or the number of hardware threads if that
+    /// variable is not set.
+    static ThreadPool &instance();
+
+    ~ThreadPool();
+
+    /// Set the total number of threads that execute a parallel loop,
+    /// including the calling thread. Zero selects the number of hardware
+    /// threads.
+    void set_num_threads(size_t num_threads);
+    /// Get the total number of threads that execute a parallel loop.
+    size_t get_num_threads() const {
+        return num_workers.load(std::memory_order_relaxed) + 1;
+    }
+
+    /// Call `task(i)` for all i in [0, n), distributing the calls over the
+    /// workers and the calling thread, and wait for all of them to finish.
+    ///
+    /// Calls from within a task, and calls while the pool is already busy
+    /// with another loop, are executed serially on the calling thread.
+    ///
+    /// If a task throws, the tasks that haven't started yet are skipped, and
+    /// the first exception is rethrown on the calling thread after all
+    /// running tasks have finished.
+    void parallel_for(size_t n, const std::function<void(size_t)> &task);
+
+  private:
+    explicit ThreadPool(size_t num_threads) { start(num_threads); }
+    ThreadPool(const ThreadPool &) = delete;
+    ThreadPool &operator=(const ThreadPool &) = delete;
+
+    void start(size_t num_threads);
+    void stop();
+    void worker_loop(unsigned long seen_generation);
+    /// Execute tasks of the current loop until there are none left, or until
+    /// one of them throws.
+    void run_tasks();
+
+  private:
+    std::vector<std::thread> workers;
+    /// Copy of `workers.size()` that can be read without locking.
+    std::atomic<size_t> num_workers{0};
+    /// Serializes the parallel loops and changes to the number of threads.
+    std::mutex loop_mtx;
+    /// Protects the state below.
+    std::mutex mtx;
+    std::condition_variable cv_start, cv_done;
+    const std::function<void(size_t)> *task = nullptr;
+    size_t num_tasks = 0;
+    std::atomic<size_t> next_task{0};
+    size_t busy_workers = 0;
+    /// The first exception thrown by a task of the current loop.
+    std::exception_ptr error;
+    unsigned long generation = 0;
+    bool stopping = false;
+};
+
+} // namespace kernels
@@ -0,0 +1,176 @@
+#include "Transpose.hpp"
+#include "Simd.hpp"
+#include "ThreadPool.hpp"
+
+#include <linalg/Runtime.hpp>
+
+#include <algorithm> // std::min, std::swap
+#include <atomic>    // std::atomic
+#include <vector>    // std::vector
+
+namespace kernels {
+
+namespace {
+
+constexpr size_t TT = transpose_tile;
+
+/// Blocks with at most NB rows and columns are no longer split recursively.
+/// Two NB×NB blocks of doubles take up 16 KiB, so they fit in the L1 cache.
+constexpr size_t NB = 32;
+
+/// Number of rows and columns of the blocks that are transposed by different
+/// threads.
+constexpr size_t PB = 256;
+
+/// Matrices with fewer elements than this are transposed on a single thread.
+std::atomic<size_t> parallel_transpose_threshold{512 * 512};
+
+/// Transpose a block that fits in the cache. If the columns of both A and B
+/// are contiguous, full tiles are transposed in registers, the remaining
+/// elements one by one.
+void transpose_block(size_t m, size_t n,                        //
+                     const double *A, size_t rs_A, size_t cs_A, //
+                     double *B, size_t rs_B, size_t cs_B) {
+    // If the rows of A and B are contiguous instead, transpose Aᵀ into Bᵀ:
+    // transposing a strided matrix is just a matter of swapping its strides.
+    if (rs_A != 1 && cs_A == 1 && cs_B == 1)
+        return transpose_block(n, m, A, cs_A, rs_A, B, cs_B, rs_B);
+    if (rs_A == 1 && rs_B == 1) {
+        auto transpose_tile = simd().transpose_tile;
+        size_t i = 0;
+        for (; i + TT <= m; i += TT) {
+            size_t j = 0;
+            for (; j + TT <= n; j += TT)
+                transpose_tile(A + i + j * cs_A, cs_A, B + j + i * cs_B, cs_B);
+            for (; j < n; ++j)
+                for (size_t r = i; r < i + TT; ++r)
+                    B[j + r * cs_B] = A[r + j * cs_A];
+        }
+        for (; i < m; ++i)
+            for (size_t j = 0; j < n; ++j)
+                B[j + i * cs_B] = A[i + j * cs_A];
+    } else {
+        for (size_t j = 0; j < n; ++j)
+            for (size_t i = 0; i < m; ++i)
+                B[j * rs_B + i * cs_B] = A[i * rs_A + j * cs_A];
+    }
+}
+
+/// Split the largest dimension in two until the blocks fit in the cache.
+/// The split points are multiples of the tile size, so only the blocks at the
+/// edges of the matrix have partial tiles.
+void transpose_recursive(size_t m, size_t n,                        //
+                         const double *A, size_t rs_A, size_t cs_A, //
+                         double *B, size_t rs_B, size_t cs_B) {
+    if (m <= NB && n <= NB)
+        return transpose_block(m, n, A, rs_A, cs_A, B, rs_B, cs_B);
+    if (m >= n) {
+        size_t h = (m / 2 + TT - 1) / TT * TT;
+        transpose_recursive(h, n, A, rs_A, cs_A, B, rs_B, cs_B);
+        transpose_recursive(m - h, n, A + h * rs_A, rs_A, cs_A, //
+                            B + h * cs_B, rs_B, cs_B);
+    } else {
+        size_t h = (n / 2 + TT - 1) / TT * TT;
+        transpose_recursive(m, h, A, rs_A, cs_A, B, rs_B, cs_B);
+        transpose_recursive(m, n - h, A + h * cs_A, rs_A, cs_A, //
+                            B + h * rs_B, rs_B, cs_B);
+    }
+}
+
+bool use_threads(size_t num_elem, size_t num_tasks) {
+    return num_tasks > 1 && ThreadPool::instance().get_num_threads() > 1 &&
+           num_elem >=
+               parallel_transpose_threshold.load(std::memory_order_relaxed);
+}
+
+} // namespace
+
+void transpose(size_t m, size_t n,                        //
+               const double *A, size_t rs_A, size_t cs_A, //
+               double *B, size_t rs_B, size_t cs_B) {
+    // The PB×PB blocks of A are independent, so they can be transposed by
+    // different threads.
+    size_t num_bm = (m + PB - 1) / PB, num_bn = (n + PB - 1) / PB;
+    if (!use_threads(m * n, num_bm * num_bn))
+        return transpose_recursive(m, n, A, rs_A, cs_A, B, rs_B, cs_B);
+    ThreadPool::instance().parallel_for(num_bm * num_bn, [&](size_t t) {
+        size_t i = (t % num_bm) * PB, j = (t / num_bm) * PB;
+        transpose_recursive(std::min(PB, m - i), std::min(PB, n - j),
+                            A + i * rs_A + j * cs_A, rs_A, cs_A,
+                            B + j * rs_B + i * cs_B, rs_B, cs_B);
+    });
+}
+
+void transpose_inplace(size_t n, double *A, size_t rs_A, size_t cs_A) {
+    auto a = [&](size_t i, size_t j) { return A + i * rs_A + j * cs_A; };
+    // The buffer has the same storage order as A, so the tiled kernel can be
+    // used for both the transposition into and out of the buffer.
+    const bool col_major = rs_A <= cs_A;
+    const size_t rs_T = col_major ? 1 : NB, cs_T = col_major ? NB : 1;
+    // Swap block (I, J) with the transpose of block (J, I), for I ≤ J.
+    auto swap_blocks = [&](size_t I, size_t J) {
+        size_t mi = std::min(NB, n - I), nj = std::min(NB, n - J);
+        double T[NB * NB];
+        transpose_block(mi, nj, a(I, J), rs_A, cs_A, T, rs_T, cs_T);
+        if (I != J)
+            transpose_block(nj, mi, a(J, I), rs_A, cs_A, a(I, J), rs_A, cs_A);
+        for (size_t c = 0; c < mi; ++c)
+            for (size_t r = 0; r < nj; ++r)
+                *a(J + r, I + c) = T[r * rs_T + c * cs_T];
+    };
+    // Block row I contains the blocks on and to the right of the diagonal.
+    auto block_row = [&](size_t b) {
+        for (size_t J = b * NB; J < n; J += NB)
+            swap_blocks(b * NB, J);
+    };
+    // Block rows get shorter towards the bottom, so each task handles a
+    // long and a short block row to balance the work between the threads.
+    size_t num_b = (n + NB - 1) / NB, num_tasks = (num_b + 1) / 2;
+    auto task = [&](size_t t) {
+        block_row(t);
+        if (num_b - 1 - t != t)
+            block_row(num_b - 1 - t);
+    };
+    if (use_threads(n * n, num_tasks))
+        ThreadPool::instance().parallel_for(num_tasks, task);
+    else
+        for (size_t t = 0; t < num_tasks; ++t)
+            task(t);
+}
+
+void transpose_inplace_rectangular(size_t m, size_t n, double *A) {
+    // Element (i, j) is stored at position k = i + j·m of A, and it ends up at
+    // position j + i·n of Aᵀ. The first and last elements never move, neither
+    // does anything if A is a vector.
+    if (m <= 1 || n <= 1)
+        return;
+    const size_t last = m * n - 1;
+    auto destination = [&](size_t k) { return (k % m) * n + k / m; };
+    std::vector<bool> moved(m * n);
+    for (size_t start = 1; start < last; ++start) {
+        if (moved[start])
+            continue;
+        // Follow the cycle that contains this position: move the element to
+        // its destination, pick up the element that was there, and so on,
+        // until we're back at the start.
+        double carried = A[start];
+        size_t k = start;
+        do {
+            k = destination(k);
+            std::swap(carried, A[k]);
+            moved[k] = true;
+        } while (k != start);
+    }
+}
+
+} // namespace kernels
+
+void set_parallel_transpose_threshold(size_t num_elem) {
+    kernels::parallel_transpose_threshold.store(num_elem,
+                                                std::memory_order_relaxed);
+}
+
+size_t get_parallel_transpose_threshold() {
+    return kernels::parallel_transpose_threshold.load(
+        std::memory_order_relaxed);
+}
@@ -0,0 +1,38 @@
+#pragma once
+
+#include <cstddef> // size_t
+
+using std::size_t;
+
+/// @see    Gemm.hpp for the conventions used for strided matrices.
+namespace kernels {
+
+/// Store the transpose of the m×n matrix A in the n×m matrix B. A and B may
+/// not overlap.
+///
+/// The matrices are split recursively until the blocks fit in the cache
+/// (cache-oblivious), and the blocks are transposed in small tiles that are
+/// kept in SIMD registers. Large matrices are transposed in parallel, see
+/// @ref set_parallel_transpose_threshold.
+void transpose(size_t m, size_t n,                        //
+               const double *A, size_t rs_A, size_t cs_A, //
+               double *B, size_t rs_B, size_t cs_B);
+
+/// Transpose the n×n matrix A in place.
+///
+/// Pairs of blocks that are mirrored across the diagonal are swapped and
+/// transposed through a small buffer, using the same tiled kernels as
+/// @ref transpose.
+void transpose_inplace(size_t n, double *A, size_t rs_A, size_t cs_A);
+
+/// Transpose the m×n matrix A, stored contiguously in column major order, in
+/// place: afterwards, the same storage contains the n×m matrix Aᵀ in column
+/// major order. (A row major m×n matrix is a column major n×m matrix, so
+/// row major matrices are handled by swapping m and n.)
+///
+/// The elements are moved along the cycles of the permutation that maps
+/// positions in A to positions in Aᵀ. A bitmap of mn bits keeps track of the
+/// elements that were already moved, which is 1/64 of the size of A.
+void transpose_inplace_rectangular(size_t m, size_t n, double *A);
+
+} // namespace kernels
@@ -0,0 +1,109 @@
+#include "Trsm.hpp"
+#include "Gemm.hpp"
+
+#include <algorithm> // std::min
+
+namespace kernels {
+
+namespace {
+
+/// Number of rows of the diagonal blocks that are solved using substitution.
+/// The off-diagonal blocks are applied using matrix-matrix products.
+constexpr size_t NB = 64;
+
+/// Forward substitution for a lower-triangular system A·X = B, one column of
+/// B at a time: after solving for xₖ, its contribution is subtracted from the
+/// rows below it, so A is accessed column by column.
+void trsm_left_lower_unblocked(Diagonal diagonal, size_t m, size_t n,
+                               const double *A, size_t rs_A, size_t cs_A,
+                               double *B, size_t rs_B, size_t cs_B,
+                               const double *A_diag) {
+    for (size_t j = 0; j < n; ++j) {
+        double *b = B + j * cs_B;
+        for (size_t k = 0; k < m; ++k) {
+            const double *a_k = A + k * cs_A;
+            double x_k = b[k * rs_B];
+            if (diagonal == Diagonal::NonUnit)
+                b[k * rs_B] = x_k /= A_diag ? A_diag[k] : a_k[k * rs_A];
+            for (size_t i = k + 1; i < m; ++i)
+                b[i * rs_B] -= a_k[i * rs_A] * x_k;
+        }
+    }
+}
+
+/// Back substitution for an upper-triangular system A·X = B, one column of B
+/// at a time: after solving for xₖ, its contribution is subtracted from the
+/// rows above it, so A is accessed column by column.
+void trsm_left_upper_unblocked(Diagonal diagonal, size_t m, size_t n,
+                               const double *A, size_t rs_A, size_t cs_A,
+                               double *B, size_t rs_B, size_t cs_B,
+                               const double *A_diag) {
+    for (size_t j = 0; j < n; ++j) {
+        double *b = B + j * cs_B;
+        for (size_t k = m; k-- > 0;) {
+            const double *a_k = A + k * cs_A;
+            double x_k = b[k * rs_B];
+            if (diagonal == Diagonal::NonUnit)
+                b[k * rs_B] = x_k /= A_diag ? A_diag[k] : a_k[k * rs_A];
+            for (size_t i = 0; i < k; ++i)
+                b[i * rs_B] -= a_k[i * rs_A] * x_k;
+        }
+    }
+}
+
+} // namespace
+
+void trsm(Side side, Triangle triangle, Diagonal diagonal, //
+          size_t m, size_t n,                              //
+          const double *A, size_t rs_A, size_t cs_A,       //
+          double *B, size_t rs_B, size_t cs_B,             //
+          const double *A_diag) {
+    // X·A = B is equivalent to Aᵀ·Xᵀ = Bᵀ, and transposing a strided matrix
+    // is just a matter of swapping its strides. The transpose of a lower-
+    // triangular matrix is upper triangular and vice versa.
+    if (side == Side::Right)
+        return trsm(Side::Left,
+                    triangle == Triangle::Lower ? Triangle::Upper
+                                                : Triangle::Lower,
+                    diagonal, n, m, A, cs_A, rs_A, B, cs_B, rs_B, A_diag);
+
+    // Partition the system as
+    //     ┌         ┐┌    ┐   ┌    ┐
+    //     │ A₁₁     ││ X₁ │ = │ B₁ │
+    //     │ A₂₁ A₂₂ ││ X₂ │   │ B₂ │
+    //     └         ┘└    ┘   └    ┘
+    // where A₁₁ is an NB×NB block. Then X₁ = A₁₁⁻¹·B₁ is computed using
+    // substitution, and the rest of the system A₂₂·X₂ = B₂ - A₂₁·X₁ is
+    // updated using a single matrix-matrix product and solved recursively.
+    // The upper-triangular case is the same, starting from the bottom right
+    // corner.
+    auto a = [&](size_t i, size_t j) { return A + i * rs_A + j * cs_A; };
+    auto b = [&](size_t i) { return B + i * rs_B; };
+    auto d = [&](size_t k) { return A_diag ? A_diag + k : nullptr; };
+    if (triangle == Triangle::Lower) {
+        for (size_t k = 0; k < m; k += NB) {
+            size_t kb = std::min(NB, m - k);
+            trsm_left_lower_unblocked(diagonal, kb, n, a(k, k), rs_A, cs_A,
+                                      b(k), rs_B, cs_B, d(k));
+            if (k + kb < m)
+                gemm(m - k - kb, n, kb,                      //
+                     -1, a(k + kb, k), rs_A, cs_A,           //
+                     b(k), rs_B, cs_B,                       //
+                     1, b(k + kb), rs_B, cs_B);
+        }
+    } else {
+        for (size_t k_end = m; k_end > 0;) {
+            size_t kb = std::min(NB, k_end), k = k_end - kb;
+            trsm_left_upper_unblocked(diagonal, kb, n, a(k, k), rs_A, cs_A,
+                                      b(k), rs_B, cs_B, d(k));
+            if (k > 0)
+                gemm(k, n, kb,                               //
+                     -1, a(0, k), rs_A, cs_A,                //
+                     b(k), rs_B, cs_B,                       //
+                     1, b(0), rs_B, cs_B);
+            k_end = k;
+        }
+    }
+}
+
+} // namespace kernels
@@ -0,0 +1,25 @@
+#pragma once
+
+#include <linalg/TriangularSolve.hpp> // Side, Triangle, Diagonal
+
+#include <cstddef> // size_t
+
+using std::size_t;
+
+/// @see    Gemm.hpp for the conventions used for strided matrices.
+namespace kernels {
+
+/// Solve A·X = B (left side) or X·A = B (right side) for X, where A is a
+/// triangular matrix and B is m×n. A is m×m for the left side, and n×n for
+/// the right side. B is overwritten by X.
+/// Only the given triangle of A is accessed, and its diagonal is not accessed
+/// if it is a unit diagonal. If `A_diag` is not null, the diagonal elements
+/// of A are `A_diag[0]`, `A_diag[1]` …, instead of being read from A (for
+/// factorizations that store the diagonal separately).
+void trsm(Side side, Triangle triangle, Diagonal diagonal, //
+          size_t m, size_t n,                              //
+          const double *A, size_t rs_A, size_t cs_A,       //
+          double *B, size_t rs_B, size_t cs_B,             //
+          const double *A_diag = nullptr);
+
+} // namespace kernels
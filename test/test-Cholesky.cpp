@@ -0,0 +1,137 @@
+#include <gtest/gtest.h>
+
+#include <linalg/Cholesky.hpp>
+#include <linalg/Matrix.hpp>
+#include <linalg/Runtime.hpp>
+
+#include "CountAllocationsTests.hpp"
+
+#include <algorithm> // std::max
+#include <cmath>     // std::abs
+
+#define EXPECT_CLOSE_ENOUGH(X, R)                                              \
+    EXPECT_NEAR((X), (R), std::max(std::abs(X) * 1e-14, 1e-14))
+
+namespace {
+
+/// Random symmetric positive definite matrix.
+SquareMatrix random_spd(size_t n) {
+    Matrix M = Matrix::random(n, n, -1, +1);
+    SquareMatrix A(transpose(M) * M);
+    for (size_t i = 0; i < n; ++i)
+        A(i, i) += n;
+    return A;
+}
+
+} // namespace
+
+TEST(Cholesky, Cholesky) {
+    SquareMatrix A = {
+        {4, 12, -16},
+        {12, 37, -43},
+        {-16, -43, 98},
+    };
+    Cholesky chol(A);
+    ASSERT_TRUE(chol.is_factored());
+
+    SquareMatrix L = chol.get_L();
+    SquareMatrix L_expected = {
+        {2, 0, 0},
+        {6, 1, 0},
+        {-8, 5, 3},
+    };
+    for (size_t r = 0; r < A.rows(); ++r)
+        for (size_t c = 0; c < A.cols(); ++c)
+            EXPECT_CLOSE_ENOUGH(L(r, c), L_expected(r, c))
+                << "(" << r << ", " << c << ")";
+}
+
+TEST(Cholesky, upperTriangleIgnored) {
+    SquareMatrix A = random_spd(9);
+    SquareMatrix A_lower = A;
+    for (size_t c = 0; c < A.cols(); ++c)
+        for (size_t r = 0; r < c; ++r)
+            A_lower(r, c) = -123;
+    Cholesky chol(A), chol_lower(A_lower);
+    ASSERT_TRUE(chol_lower.is_factored());
+    EXPECT_EQ(chol.get_L(), chol_lower.get_L());
+}
+
+TEST(Cholesky, solve) {
+    SquareMatrix A = {
+        {4, 12, -16},
+        {12, 37, -43},
+        {-16, -43, 98},
+    };
+    Vector x = {7, 11, 13};
+    Vector b = A * x;
+    Cholesky chol(A);
+
+    RESET_ALLOC_COUNT();
+    Vector solution = chol.solve(std::move(b));
+    EXPECT_ALLOC_COUNT(0);
+
+    ASSERT_EQ(x.size(), solution.size());
+    for (size_t c = 0; c < x.size(); ++c)
+        EXPECT_NEAR(solution(c), x(c), 1e-12) << "(" << c << ")";
+}
+
+TEST(Cholesky, stealL) {
+    SquareMatrix A = random_spd(5);
+    Cholesky chol(A);
+    SquareMatrix L_copy = chol.get_L();
+    SquareMatrix L      = std::move(chol).get_L();
+    EXPECT_FALSE(chol.is_factored());
+    EXPECT_EQ(L, L_copy);
+}
+
+TEST(Cholesky, notPositiveDefinite) {
+    SquareMatrix A = {
+        {1, 2},
+        {2, 1},
+    };
+    Cholesky chol(A);
+    EXPECT_FALSE(chol.is_factored());
+}
+
+TEST(Cholesky, blocked) {
+    // Factor a matrix that is larger than the block size, once using the
+    // blocked algorithm and once using the unblocked algorithm.
+    SquareMatrix A = random_spd(75);
+    size_t nb = get_cholesky_block_size();
+    set_cholesky_block_size(7);
+    Cholesky chol_blocked(A);
+    set_cholesky_block_size(0);
+    Cholesky chol_unblocked(A);
+    set_cholesky_block_size(nb);
+    ASSERT_TRUE(chol_blocked.is_factored());
+
+    SquareMatrix L = chol_blocked.get_L();
+    EXPECT_LT((L * transpose(L) - A).normFro(), 1e-11);
+    EXPECT_LT((L - chol_unblocked.get_L()).normFro(), 1e-12);
+}
+
+TEST(Cholesky, updateDowndate) {
+    SquareMatrix A = random_spd(11);
+    Vector x       = Vector::random(11, -1, +1, 7);
+    SquareMatrix A_upd(A + x * transpose(x));
+    Cholesky chol(A);
+
+    chol.rank_one_update(x);
+    ASSERT_TRUE(chol.is_factored());
+    EXPECT_LT((chol.get_L() - Cholesky(A_upd).get_L()).normFro(), 1e-12);
+
+    ASSERT_TRUE(chol.rank_one_downdate(x));
+    EXPECT_LT((chol.get_L() - Cholesky(A).get_L()).normFro(), 1e-12);
+}
+
+TEST(Cholesky, downdateNotPositiveDefinite) {
+    SquareMatrix A = {
+        {4, 2},
+        {2, 3},
+    };
+    Vector x = {2, 0};
+    Cholesky chol(A);
+    EXPECT_FALSE(chol.rank_one_downdate(x));
+    EXPECT_FALSE(chol.is_factored());
+}
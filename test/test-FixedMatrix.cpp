@@ -0,0 +1,96 @@
+#include <gtest/gtest.h>
+
+#include <linalg/FixedMatrix.hpp>
+
+#include <sstream>
+
+TEST(FixedMatrix, initializerList) {
+    FixedMatrix<2, 3> A = {
+        {11, 12, 13},
+        {21, 22, 23},
+    };
+    EXPECT_EQ(A(0, 0), 11);
+    EXPECT_EQ(A(0, 2), 13);
+    EXPECT_EQ(A(1, 1), 22);
+    EXPECT_EQ(A.rows(), 2);
+    EXPECT_EQ(A.cols(), 3);
+    EXPECT_EQ(A.num_elems(), 6);
+    EXPECT_EQ((FixedMatrix<2, 3>()), (FixedMatrix<2, 3>::zeros()));
+}
+
+TEST(FixedMatrix, conversion) {
+    Matrix M = Matrix::random(3, 4, -1, 1, 1);
+    FixedMatrix<3, 4> F(M);
+    for (size_t r = 0; r < 3; ++r)
+        for (size_t c = 0; c < 4; ++c)
+            EXPECT_EQ(F(r, c), M(r, c));
+    EXPECT_EQ(static_cast<Matrix>(F), M);
+}
+
+TEST(FixedMatrix, addSubtract) {
+    Matrix a = Matrix::random(3, 3, -1, 1, 1);
+    Matrix b = Matrix::random(3, 3, -1, 1, 2);
+    FixedSquareMatrix<3> A(a), B(b);
+    EXPECT_EQ(static_cast<Matrix>(A + B), a + b);
+    EXPECT_EQ(static_cast<Matrix>(A - B), a - b);
+    EXPECT_EQ(static_cast<Matrix>(-A), -a);
+    EXPECT_EQ(static_cast<Matrix>(A * 2.5), a * 2.5);
+    EXPECT_EQ(static_cast<Matrix>(2.5 * A), 2.5 * a);
+    EXPECT_EQ(static_cast<Matrix>(A / 2.5), a / 2.5);
+}
+
+TEST(FixedMatrix, matrixMultiply) {
+    Matrix a = Matrix::random(4, 3, -1, 1, 1);
+    Matrix b = Matrix::random(3, 5, -1, 1, 2);
+    FixedMatrix<4, 5> C = FixedMatrix<4, 3>(a) * FixedMatrix<3, 5>(b);
+    Matrix expected     = a * b;
+    for (size_t i = 0; i < C.num_elems(); ++i)
+        EXPECT_NEAR(C(i), expected(i), 1e-15) << i;
+}
+
+TEST(FixedMatrix, identity) {
+    FixedSquareMatrix<4> I = FixedSquareMatrix<4>::identity();
+    EXPECT_EQ(static_cast<Matrix>(I), Matrix::identity(4));
+    FixedSquareMatrix<4> A(Matrix::random(4, 4, -1, 1, 3));
+    EXPECT_EQ(I * A, A);
+}
+
+TEST(FixedMatrix, large) {
+    // The loops over all 1024 elements are unrolled at compile time.
+    Matrix a = Matrix::random(32, 32, -1, 1, 1);
+    Matrix b = Matrix::random(32, 32, -1, 1, 2);
+    FixedSquareMatrix<32> A(a), B(b);
+    EXPECT_EQ(static_cast<Matrix>(A + B), a + b);
+    EXPECT_EQ(FixedSquareMatrix<32>::identity() * A, A);
+}
+
+TEST(FixedMatrix, transpose) {
+    FixedMatrix<2, 3> A = {
+        {11, 12, 13},
+        {21, 22, 23},
+    };
+    FixedMatrix<3, 2> expected = {
+        {11, 21},
+        {12, 22},
+        {13, 23},
+    };
+    EXPECT_EQ(transpose(A), expected);
+}
+
+TEST(FixedVector, dotCross) {
+    FixedVector<3> a = {{1}, {2}, {3}};
+    FixedVector<3> b = {{4}, {5}, {6}};
+    EXPECT_EQ(a.dot(b), 32);
+    EXPECT_EQ(transpose(a) * b, 32);
+    FixedVector<3> expected = {{-3}, {6}, {-3}};
+    EXPECT_EQ(a.cross(b), expected);
+    EXPECT_EQ(a.norm2(), std::sqrt(14.));
+}
+
+TEST(FixedMatrix, print) {
+    FixedMatrix<2, 2> A = {{1, 2}, {3, 4}};
+    std::ostringstream fixed, dynamic;
+    fixed << A;
+    dynamic << static_cast<Matrix>(A);
+    EXPECT_EQ(fixed.str(), dynamic.str());
+}
@@ -2,6 +2,7 @@
 
 #include <linalg/HouseholderQR.hpp>
 #include <linalg/Matrix.hpp>
+#include <linalg/Runtime.hpp>
 
 #include "CountAllocationsTests.hpp"
 
@@ -247,3 +248,70 @@ TEST(HouseholderQR, zeroDiagonal) { // TODO: is Q too trivial?
             EXPECT_CLOSE_ENOUGH(A(r, c), QR(r, c))
                 << "(" << r << ", " << c << ")";
 }
+
+TEST(HouseholderQR, blocked) {
+    // Factor a matrix that is larger than the block size, once using the
+    // blocked algorithm and once using the unblocked algorithm.
+    Matrix A = Matrix::random(83, 71, -1, +1);
+    size_t nb = get_qr_block_size();
+    set_qr_block_size(4);
+    HouseholderQR qr_blocked(A);
+    set_qr_block_size(0);
+    HouseholderQR qr_unblocked(A);
+    set_qr_block_size(nb);
+
+    Matrix QR = qr_blocked.apply_Q(qr_blocked.get_R());
+    EXPECT_LT((A - QR).normFro(), 1e-12);
+
+    const Matrix &RW_b = qr_blocked.get_RW(), &RW_u = qr_unblocked.get_RW();
+    const Vector &Rd_b = qr_blocked.get_R_diag();
+    const Vector &Rd_u = qr_unblocked.get_R_diag();
+    EXPECT_LT((RW_b - RW_u).normFro(), 1e-12);
+    EXPECT_LT((Rd_b - Rd_u).normFro(), 1e-12);
+}
+
+TEST(HouseholderQR, blockedApplyManyRHS) {
+    // Apply Q and Qᵀ to many right-hand sides at once, using the blocked
+    // algorithm, and compare to the unblocked result.
+    Matrix A = Matrix::random(61, 23, -1, +1);
+    Matrix B = Matrix::random(61, 37, -1, +1);
+    HouseholderQR qr(A);
+    size_t nb = get_qr_block_size();
+    set_qr_block_size(0);
+    Matrix QTB_unblocked = qr.apply_QT(B);
+    Matrix QB_unblocked  = qr.apply_Q(B);
+    set_qr_block_size(5);
+    Matrix QTB_blocked = qr.apply_QT(B);
+    Matrix QB_blocked  = qr.apply_Q(B);
+    Matrix QQTB        = qr.apply_Q(QTB_blocked);
+    set_qr_block_size(nb);
+
+    EXPECT_LT((QTB_blocked - QTB_unblocked).normFro(), 1e-12);
+    EXPECT_LT((QB_blocked - QB_unblocked).normFro(), 1e-12);
+    EXPECT_LT((QQTB - B).normFro(), 1e-12);
+}
+
+TEST(HouseholderQR, thinQ) {
+    // The thin Q consists of the first n columns of the full Q, both for the
+    // blocked and the unblocked algorithm.
+    Matrix A = Matrix::random(57, 21, -1, +1);
+    HouseholderQR qr(A);
+    Matrix Q = qr.get_Q();
+    size_t nb = get_qr_block_size();
+    set_qr_block_size(0);
+    Matrix Q_thin_unblocked = qr.get_thin_Q();
+    set_qr_block_size(4);
+    Matrix Q_thin_blocked = qr.get_thin_Q();
+    set_qr_block_size(nb);
+
+    ASSERT_EQ(Q_thin_blocked.rows(), A.rows());
+    ASSERT_EQ(Q_thin_blocked.cols(), A.cols());
+    Matrix Q_first(Q.block(0, 0, A.rows(), A.cols()));
+    EXPECT_LT((Q_thin_unblocked - Q_first).normFro(), 1e-12);
+    EXPECT_LT((Q_thin_blocked - Q_first).normFro(), 1e-12);
+
+    // A = Q₁R₁
+    Matrix R = qr.get_R();
+    Matrix R_top(R.block(0, 0, A.cols(), A.cols()));
+    EXPECT_LT((Q_thin_blocked * R_top - A).normFro(), 1e-12);
+}
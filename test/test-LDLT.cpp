@@ -0,0 +1,160 @@
+#include <gtest/gtest.h>
+
+#include <linalg/LDLT.hpp>
+#include <linalg/Matrix.hpp>
+#include <linalg/Runtime.hpp>
+
+#include "CountAllocationsTests.hpp"
+
+namespace {
+
+/// Random symmetric matrix.
+SquareMatrix random_symmetric(size_t n) {
+    SquareMatrix M = SquareMatrix::random(n, -1, +1);
+    return SquareMatrix(M + transpose(M));
+}
+
+/// Random saddle point (KKT) matrix [H Aᵀ; A 0], with H positive definite and
+/// A an m×n matrix.
+SquareMatrix random_kkt(size_t n, size_t m) {
+    Matrix M = Matrix::random(n, n, -1, +1);
+    Matrix A = Matrix::random(m, n, -1, +1);
+    Matrix H = transpose(M) * M;
+    SquareMatrix K = SquareMatrix::zeros(n + m);
+    for (size_t c = 0; c < n; ++c) {
+        for (size_t r = 0; r < n; ++r)
+            K(r, c) = H(r, c);
+        for (size_t r = 0; r < m; ++r) {
+            K(n + r, c) = A(r, c);
+            K(c, n + r) = A(r, c);
+        }
+    }
+    return K;
+}
+
+/// PᵀLDLᵀP, which should be equal to the original matrix.
+SquareMatrix reconstruct(const LDLT &ldlt) {
+    SquareMatrix L = ldlt.get_L();
+    SquareMatrix LDLt(L * ldlt.get_D() * transpose(L));
+    // P is a row permutation, use PᵀMP = Pᵀ(PᵀM)ᵀ for symmetric M
+    PermutationMatrix Pt = transpose(ldlt.get_P());
+    return Pt * SquareMatrix(transpose(Pt * std::move(LDLt)));
+}
+
+} // namespace
+
+TEST(LDLT, zeroDiagonal) {
+    // Requires a 2×2 pivot, there are no usable diagonal elements.
+    SquareMatrix A = {
+        {0, 1, 2},
+        {1, 0, 3},
+        {2, 3, 0},
+    };
+    LDLT ldlt(A);
+    ASSERT_TRUE(ldlt.is_factored());
+    EXPECT_LT((reconstruct(ldlt) - A).normFro(), 1e-14);
+
+    const Vector &D_sub = ldlt.get_D_subdiag();
+    EXPECT_TRUE(D_sub(0) != 0 || D_sub(1) != 0);
+}
+
+TEST(LDLT, diagonalPivot) {
+    // Positive definite matrix with a large diagonal: no pivoting is needed.
+    SquareMatrix A = {
+        {4, 12, -16},
+        {12, 37, -43},
+        {-16, -43, 98},
+    };
+    LDLT ldlt(A);
+    ASSERT_TRUE(ldlt.is_factored());
+    EXPECT_LT((reconstruct(ldlt) - A).normFro(), 1e-12);
+    for (size_t k = 0; k < 3; ++k)
+        EXPECT_EQ(ldlt.get_D_subdiag()(k), 0);
+}
+
+TEST(LDLT, kkt) {
+    SquareMatrix A = random_kkt(13, 5);
+    LDLT ldlt(A);
+    ASSERT_TRUE(ldlt.is_factored());
+    EXPECT_LT((reconstruct(ldlt) - A).normFro(), 1e-12);
+
+    // D is block diagonal with 1×1 and 2×2 blocks, L is unit lower triangular
+    SquareMatrix L = ldlt.get_L(), D = ldlt.get_D();
+    for (size_t c = 0; c < A.cols(); ++c) {
+        EXPECT_EQ(L(c, c), 1);
+        for (size_t r = 0; r < c; ++r)
+            EXPECT_EQ(L(r, c), 0);
+        for (size_t r = c + 2; r < A.rows(); ++r)
+            EXPECT_EQ(D(r, c), 0);
+    }
+}
+
+TEST(LDLT, upperTriangleIgnored) {
+    SquareMatrix A = random_symmetric(9);
+    SquareMatrix A_lower = A;
+    for (size_t c = 0; c < A.cols(); ++c)
+        for (size_t r = 0; r < c; ++r)
+            A_lower(r, c) = -123;
+    LDLT ldlt(A), ldlt_lower(A_lower);
+    EXPECT_EQ(ldlt.get_L(), ldlt_lower.get_L());
+    EXPECT_EQ(ldlt.get_D(), ldlt_lower.get_D());
+}
+
+TEST(LDLT, solve) {
+    SquareMatrix A = random_kkt(6, 3);
+    Vector x = Vector::random(9, -1, +1);
+    Vector b = A * x;
+    LDLT ldlt(A);
+
+    RESET_ALLOC_COUNT();
+    Vector solution = ldlt.solve(std::move(b));
+    EXPECT_ALLOC_COUNT(0);
+
+    ASSERT_EQ(x.size(), solution.size());
+    for (size_t c = 0; c < x.size(); ++c)
+        EXPECT_NEAR(solution(c), x(c), 1e-10) << "(" << c << ")";
+}
+
+TEST(LDLT, solveMatrix) {
+    SquareMatrix A = random_symmetric(10);
+    Matrix X = Matrix::random(10, 4, -1, +1);
+    Matrix B = A * X;
+    LDLT ldlt(A);
+    EXPECT_LT((ldlt.solve(B) - X).normFro(), 1e-10);
+}
+
+TEST(LDLT, stealLP) {
+    SquareMatrix A = random_symmetric(5);
+    LDLT ldlt(A);
+    SquareMatrix L_copy = ldlt.get_L();
+    PermutationMatrix P_copy = ldlt.get_P();
+    SquareMatrix L = std::move(ldlt).get_L();
+    EXPECT_FALSE(ldlt.is_factored());
+    EXPECT_FALSE(ldlt.has_LD());
+    EXPECT_TRUE(ldlt.has_P());
+    PermutationMatrix P = std::move(ldlt).get_P();
+    EXPECT_FALSE(ldlt.has_P());
+    EXPECT_EQ(L, L_copy);
+    EXPECT_EQ(P.to_permutation(), P_copy.to_permutation());
+}
+
+TEST(LDLT, blocked) {
+    // Factor a matrix that is larger than the block size, once using the
+    // blocked algorithm and once using the unblocked algorithm.
+    SquareMatrix A = random_kkt(50, 25);
+    size_t nb = get_ldlt_block_size();
+    set_ldlt_block_size(7);
+    LDLT ldlt_blocked(A);
+    set_ldlt_block_size(0);
+    LDLT ldlt_unblocked(A);
+    set_ldlt_block_size(nb);
+    ASSERT_TRUE(ldlt_blocked.is_factored());
+
+    EXPECT_LT((reconstruct(ldlt_blocked) - A).normFro(), 1e-10);
+    EXPECT_EQ(ldlt_blocked.get_P().to_permutation(),
+              ldlt_unblocked.get_P().to_permutation());
+    EXPECT_LT((ldlt_blocked.get_L() - ldlt_unblocked.get_L()).normFro(),
+              1e-10);
+    EXPECT_LT((ldlt_blocked.get_D() - ldlt_unblocked.get_D()).normFro(),
+              1e-10);
+}
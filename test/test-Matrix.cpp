@@ -118,3 +118,50 @@ TEST(Matrix, normFro) {
     EXPECT_FLOAT_EQ(result1, expected);
     EXPECT_FLOAT_EQ(result2, expected);
 }
+
+// Storage order
+// :::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::
+
+TEST(Matrix, rowMajor) {
+    Matrix m(2, 3, StorageOrder::RowMajor);
+    m = {
+        {11, 12, 13},
+        {21, 22, 23},
+    };
+    EXPECT_EQ(m.storage_order(), StorageOrder::RowMajor);
+    EXPECT_EQ(m.row_stride(), 3);
+    EXPECT_EQ(m.col_stride(), 1);
+    std::vector<double> expected_storage = {11, 12, 13, 21, 22, 23};
+    EXPECT_TRUE(std::equal(m.begin(), m.end(), expected_storage.begin()));
+    EXPECT_EQ(m(1, 0), 21);
+    EXPECT_EQ(ConstMatrixView(m)(0, 2), 13);
+}
+
+TEST(Matrix, mixedStorageOrder) {
+    Matrix a = Matrix::random(4, 3, -1, 1, 1);
+    Matrix b = Matrix::random(4, 3, -1, 1, 2);
+    Matrix b_row(4, 3, StorageOrder::RowMajor);
+    b_row = ConstMatrixView(b);
+    EXPECT_EQ(b_row, b);
+    EXPECT_EQ(Matrix(a + b_row), Matrix(a + b));
+    EXPECT_EQ(Matrix(a - b_row), Matrix(a - b));
+    EXPECT_EQ(a - Matrix(b_row), Matrix(a - b));
+    Matrix sum = a;
+    sum += b_row;
+    EXPECT_EQ(sum, Matrix(a + b));
+    EXPECT_EQ(sum.storage_order(), StorageOrder::ColMajor);
+}
+
+TEST(Matrix, matrixMultiplyRowMajor) {
+    // Row-major operands are passed to the kernel with their own strides.
+    Matrix a = Matrix::random(37, 23, -1, 1, 1);
+    Matrix b = Matrix::random(23, 41, -1, 1, 2);
+    Matrix a_row(37, 23, StorageOrder::RowMajor);
+    a_row = ConstMatrixView(a);
+    Matrix b_row(23, 41, StorageOrder::RowMajor);
+    b_row = ConstMatrixView(b);
+    Matrix expected = a * b;
+    EXPECT_LT((a_row * b - expected).normFro(), 1e-12);
+    EXPECT_LT((a * b_row - expected).normFro(), 1e-12);
+    EXPECT_LT((a_row * b_row - expected).normFro(), 1e-12);
+}
@@ -0,0 +1,143 @@
+#include <gtest/gtest.h>
+
+#include <linalg/Matrix.hpp>
+
+#include "CountAllocationsTests.hpp"
+
+TEST(MatrixExpression, fused) {
+    Matrix a        = {{1, 2}, {3, 4}};
+    Matrix b        = {{10, 11}, {12, 13}};
+    Matrix c        = {{5, 6}, {7, 8}};
+    Matrix expected = {{-10, -13}, {-16, -19}};
+    RESET_ALLOC_COUNT();
+    Matrix result = a + b - 2.0 * c - c / 0.5 + -a;
+    EXPECT_ALLOC_COUNT(1);
+    EXPECT_EQ(result, expected);
+}
+
+TEST(MatrixExpression, assignInPlace) {
+    Matrix a        = {{1, 2}, {3, 4}};
+    Matrix b        = {{10, 11}, {12, 13}};
+    Matrix result   = {{0, 0}, {0, 0}};
+    Matrix expected = {{5.5, 6.5}, {7.5, 8.5}};
+    const double *storage = result.data();
+    RESET_ALLOC_COUNT();
+    result = a + b / 2 - a * 0.5 - 1.0 * b / 2 + b * 0.5;
+    EXPECT_ALLOC_COUNT(0);
+    EXPECT_EQ(result.data(), storage);
+    EXPECT_EQ(result, expected);
+}
+
+TEST(MatrixExpression, assignResize) {
+    Matrix a        = {{1, 2, 3}};
+    Matrix result   = {{0, 0}, {0, 0}};
+    Matrix expected = {{-2, -4, -6}};
+    RESET_ALLOC_COUNT();
+    result = -a * 2;
+    EXPECT_ALLOC_COUNT(1); // new dimensions, evaluated into new storage
+    EXPECT_EQ(result.rows(), 1);
+    EXPECT_EQ(result.cols(), 3);
+    EXPECT_EQ(result, expected);
+}
+
+TEST(MatrixExpression, assignGrow) {
+    Matrix a        = {{1, 2, 3}};
+    Matrix result   = {{0}};
+    Matrix expected = {{2, 4, 6}};
+    RESET_ALLOC_COUNT();
+    result = a * 2;
+    EXPECT_ALLOC_COUNT(1);
+    EXPECT_EQ(result, expected);
+}
+
+TEST(MatrixExpression, aliasing) {
+    Matrix a        = {{1, 2}, {3, 4}};
+    Matrix b        = {{10, 11}, {12, 13}};
+    Matrix expected = {{13, 17}, {21, 25}};
+    RESET_ALLOC_COUNT();
+    a = b + a * 3;
+    EXPECT_ALLOC_COUNT(0);
+    EXPECT_EQ(a, expected);
+}
+
+TEST(MatrixExpression, moveLeft) {
+    Matrix a        = {{1, 2}, {3, 4}};
+    Matrix b        = {{10, 11}, {12, 13}};
+    Matrix expected = {{-18, -18}, {-18, -18}};
+    const double *storage = a.data();
+    RESET_ALLOC_COUNT();
+    Matrix result = std::move(a) - (b * 2 - a);
+    EXPECT_ALLOC_COUNT(0);
+    EXPECT_EQ(result.data(), storage);
+    EXPECT_EQ(result, expected);
+}
+
+TEST(MatrixExpression, moveRight) {
+    Matrix a        = {{1, 2}, {3, 4}};
+    Matrix b        = {{10, 11}, {12, 13}};
+    Matrix expected = {{18, 18}, {18, 18}};
+    const double *storage = a.data();
+    RESET_ALLOC_COUNT();
+    Matrix result = (b * 2 - a) - std::move(a);
+    EXPECT_ALLOC_COUNT(0);
+    EXPECT_EQ(result.data(), storage);
+    EXPECT_EQ(result, expected);
+}
+
+TEST(MatrixExpression, compoundAssignment) {
+    Matrix a        = {{1, 2}, {3, 4}};
+    Matrix b        = {{10, 11}, {12, 13}};
+    Matrix expected = {{22, 26}, {30, 34}};
+    RESET_ALLOC_COUNT();
+    a += b * 2 + a;
+    a -= a / 2 - a / 2;
+    EXPECT_ALLOC_COUNT(0);
+    EXPECT_EQ(a, expected);
+}
+
+TEST(MatrixExpression, resultTypes) {
+    Vector a       = {1, 2, 3};
+    Vector b       = {4, 5, 6};
+    Matrix M       = {{1}, {1}, {1}};
+    RowVector r    = {1, 2, 3};
+    SquareMatrix S = {{1, 2}, {3, 4}};
+    static_assert(std::is_same<decltype((a + b * 2).eval()), Vector>::value,
+                  "");
+    static_assert(std::is_same<decltype((-r / 2).eval()), RowVector>::value,
+                  "");
+    static_assert(
+        std::is_same<decltype((S - S * 2).eval()), SquareMatrix>::value, "");
+    static_assert(std::is_same<decltype((a + M * 2).eval()), Matrix>::value,
+                  "");
+    Vector v        = a + b * 2 - a;
+    Vector expected = {8, 10, 12};
+    EXPECT_EQ(v, expected);
+    v        = -(a - b);
+    expected = {3, 3, 3};
+    EXPECT_EQ(v, expected);
+    Matrix m          = a + M;
+    Matrix m_expected = {{2}, {3}, {4}};
+    EXPECT_EQ(m, m_expected);
+}
+
+TEST(MatrixExpression, normFro) {
+    Matrix a = Matrix::random(7, 5, -1, 1, 1);
+    Matrix b = Matrix::random(7, 5, -1, 1, 2);
+    RESET_ALLOC_COUNT();
+    double result = (a - b * 3).normFro();
+    EXPECT_ALLOC_COUNT(0);
+    Matrix difference = a - b * 3;
+    EXPECT_NEAR(result, difference.normFro(), 1e-13);
+}
+
+TEST(MatrixExpression, norm2) {
+    Vector a    = {1, 2, 3};
+    Vector b    = {3, 5, 9};
+    RowVector r = {3, 0, 4};
+    RESET_ALLOC_COUNT();
+    double a_b = (b - a).norm2();
+    double r_2 = (2 * r).norm2();
+    EXPECT_ALLOC_COUNT(0);
+    EXPECT_DOUBLE_EQ(a_b, 7);
+    EXPECT_DOUBLE_EQ(r_2, 10);
+}
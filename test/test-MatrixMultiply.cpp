@@ -1,9 +1,12 @@
 #include <gtest/gtest.h>
 
 #include <linalg/Matrix.hpp>
+#include <linalg/Runtime.hpp>
 
 #include "CountAllocationsTests.hpp"
 
+#include <limits>
+
 // Matrix
 // :::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::
 
@@ -48,6 +51,124 @@ TEST(Matrix, matrixMultiplyMoveAB) {
     EXPECT_EQ(result, expected);
 }
 
+// Large products use the cache-blocked code path with packing, their sizes are
+// chosen so that none of the block sizes divide them evenly.
+TEST(Matrix, matrixMultiplyLarge) {
+    Matrix a      = Matrix::random(263, 301, -1, 1, 1);
+    Matrix b      = Matrix::random(301, 135, -1, 1, 2);
+    Matrix result = a * b;
+    ASSERT_EQ(result.rows(), 263);
+    ASSERT_EQ(result.cols(), 135);
+    for (size_t i = 0; i < result.rows(); ++i)
+        for (size_t j = 0; j < result.cols(); ++j) {
+            double expected = 0;
+            for (size_t k = 0; k < a.cols(); ++k)
+                expected += a(i, k) * b(k, j);
+            EXPECT_NEAR(result(i, j), expected, 1e-12)
+                << "(" << i << ", " << j << ")";
+        }
+}
+
+// The parallel product splits the work into independent macro-tiles, which are
+// computed in exactly the same way as in the serial product.
+TEST(Matrix, matrixMultiplyParallel) {
+    size_t num_threads = get_num_threads();
+    size_t threshold   = get_parallel_gemm_threshold();
+    Matrix a           = Matrix::random(263, 301, -1, 1, 1);
+    Matrix b           = Matrix::random(301, 135, -1, 1, 2);
+    set_num_threads(1);
+    Matrix expected = a * b;
+    set_num_threads(4);
+    set_parallel_gemm_threshold(0);
+    EXPECT_EQ(get_num_threads(), 4);
+    Matrix result = a * b;
+    set_num_threads(num_threads);
+    set_parallel_gemm_threshold(threshold);
+    EXPECT_EQ(result, expected);
+}
+
+TEST(Matrix, gemm) {
+    Matrix a = {{23, 29, 31}, {37, 41, 43}};
+    Matrix b = {{3, 5}, {7, 11}, {13, 17}};
+    Matrix c = {{1, 2}, {3, 4}};
+    RESET_ALLOC_COUNT();
+    gemm(2, a, b, -1, c); // c = 2·a·b - c
+    EXPECT_ALLOC_COUNT(0);
+    Matrix expected = {{2 * 675 - 1, 2 * 961 - 2}, {2 * 957 - 3, 2 * 1367 - 4}};
+    EXPECT_EQ(c, expected);
+}
+
+TEST(Matrix, gemmBetaZero) {
+    // The original elements of C are ignored if β is zero, even NaN.
+    Matrix a = {{23, 29, 31}, {37, 41, 43}};
+    Matrix b = {{3, 5}, {7, 11}, {13, 17}};
+    Matrix c(2, 2);
+    c.fill(std::numeric_limits<double>::quiet_NaN());
+    gemm(1, a, b, 0, c);
+    Matrix expected = {{675, 961}, {957, 1367}};
+    EXPECT_EQ(c, expected);
+}
+
+TEST(Matrix, gemmTransposed) {
+    Matrix a = Matrix::random(7, 5, -1, 1, 1);
+    Matrix b = Matrix::random(7, 4, -1, 1, 2);
+    Matrix c = Matrix::random(4, 5, -1, 1, 3);
+    Matrix expected = 0.5 * c;
+    expected += explicit_transpose(b) * a;
+    RESET_ALLOC_COUNT();
+    gemm(1, transpose(b), a, 0.5, c); // c = bᵀ·a + c/2
+    EXPECT_ALLOC_COUNT(0);
+    EXPECT_LT((c - expected).normFro(), 1e-14);
+}
+
+// The products are evaluated right away, so their elements and norms can be
+// accessed directly.
+TEST(Matrix, matrixMultiplyResult) {
+    Matrix a = {{23, 29, 31}, {37, 41, 43}};
+    Matrix b = {{3, 5}, {7, 11}, {13, 17}};
+    Vector x = {3, 4, 0};
+    static_assert(std::is_same<decltype(a * b), Matrix>::value, "");
+    static_assert(std::is_same<decltype(a * x), Vector>::value, "");
+    EXPECT_EQ((a * b)(1, 0), 957);
+    EXPECT_EQ((a * x)(0), 185);
+    EXPECT_EQ((b * Vector{1, 0}).norm2(), Vector({3, 7, 13}).norm2());
+}
+
+TEST(Matrix, addProduct) {
+    Matrix a        = Matrix::random(7, 5, -1, 1, 1);
+    Matrix b        = Matrix::random(5, 6, -1, 1, 2);
+    Matrix d        = Matrix::random(5, 7, -1, 1, 3);
+    Matrix c        = Matrix::random(7, 6, -1, 1, 4);
+    Matrix expected = c + a * b - explicit_transpose(d) * b;
+    RESET_ALLOC_COUNT();
+    add_product(c, a, b);
+    subtract_product(c, transpose(d), b);
+    EXPECT_ALLOC_COUNT(0);
+    EXPECT_LT((c - expected).normFro(), 1e-14);
+}
+
+TEST(Matrix, subtractProductAliased) {
+    // The product is evaluated into a temporary if it refers to the matrix
+    // that it is subtracted from.
+    Matrix a        = Matrix::random(6, 6, -1, 1, 1);
+    Matrix b        = Matrix::random(6, 6, -1, 1, 2);
+    Matrix expected = a - a * b;
+    subtract_product(a, a, b);
+    EXPECT_LT((a - expected).normFro(), 1e-14);
+}
+
+TEST(Matrix, addProductView) {
+    Matrix a        = Matrix::random(3, 4, -1, 1, 1);
+    Matrix b        = Matrix::random(4, 2, -1, 1, 2);
+    Matrix c        = Matrix::random(5, 5, -1, 1, 3);
+    Matrix expected = c;
+    expected.block(1, 2, 3, 2) += a * b;
+    RESET_ALLOC_COUNT();
+    add_product(c.block(1, 2, 3, 2), a, b);
+    EXPECT_ALLOC_COUNT(0);
+    EXPECT_LT((c - expected).normFro(), 1e-14);
+}
+
 // SquareMatrix
 // :::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::
 
@@ -136,6 +257,99 @@ TEST(Vector, matrixVectorMultiplyMoveAB) {
     EXPECT_EQ(result, expected);
 }
 
+TEST(Vector, matrixVectorMultiplyLarge) {
+    Matrix a      = Matrix::random(517, 389, -1, 1, 3);
+    Vector b      = Vector::random(389, -1, 1, 4);
+    Vector result = a * b;
+    ASSERT_EQ(result.size(), 517);
+    for (size_t i = 0; i < result.size(); ++i) {
+        double expected = 0;
+        for (size_t k = 0; k < a.cols(); ++k)
+            expected += a(i, k) * b(k);
+        EXPECT_NEAR(result(i), expected, 1e-12) << "(" << i << ")";
+    }
+}
+
+TEST(Vector, matrixVectorMultiplyRowMajor) {
+    Matrix a(517, 389, StorageOrder::RowMajor);
+    a               = ConstMatrixView(Matrix::random(517, 389, -1, 1, 3));
+    Vector b        = Vector::random(389, -1, 1, 4);
+    Vector expected = Matrix(ConstMatrixView(a)) * b;
+    Vector result   = a * b;
+    ASSERT_EQ(result.size(), 517);
+    for (size_t i = 0; i < result.size(); ++i)
+        EXPECT_NEAR(result(i), expected(i), 1e-12) << "(" << i << ")";
+}
+
+// Every thread computes a separate block of rows, in exactly the same way as
+// the serial product.
+TEST(Vector, matrixVectorMultiplyParallel) {
+    size_t num_threads = get_num_threads();
+    size_t threshold   = get_parallel_gemv_threshold();
+    Matrix a           = Matrix::random(517, 389, -1, 1, 3);
+    Vector b           = Vector::random(389, -1, 1, 4);
+    RowVector c        = RowVector::random(517, -1, 1, 5);
+    set_num_threads(1);
+    Vector ab_expected    = a * b;
+    RowVector ca_expected = c * a;
+    set_num_threads(4);
+    set_parallel_gemv_threshold(0);
+    Vector ab_result    = a * b;
+    RowVector ca_result = c * a;
+    set_num_threads(num_threads);
+    set_parallel_gemv_threshold(threshold);
+    EXPECT_EQ(ab_result, ab_expected);
+    EXPECT_EQ(ca_result, ca_expected);
+}
+
+TEST(Vector, gemv) {
+    Matrix a = {{11, 12, 13}, {21, 22, 23}};
+    Vector b = {11, 13, 17};
+    Vector y = {1, 2};
+    RESET_ALLOC_COUNT();
+    gemv(2, a, b, -1, y); // y = 2·a·b - y
+    EXPECT_ALLOC_COUNT(0);
+    Vector expected = {2 * 498 - 1, 2 * 908 - 2};
+    EXPECT_EQ(y, expected);
+}
+
+TEST(Vector, gemvBetaZero) {
+    // The original elements of y are ignored if β is zero, even NaN.
+    Matrix a = {{11, 12, 13}, {21, 22, 23}};
+    Vector b = {11, 13, 17};
+    Vector y = {std::numeric_limits<double>::quiet_NaN(), 1};
+    gemv(1, a, b, 0, y);
+    Vector expected = {498, 908};
+    EXPECT_EQ(y, expected);
+}
+
+TEST(Vector, gemvStrided) {
+    // x is a row of a column major matrix and y a column of a row major
+    // matrix, so neither is contiguous.
+    Matrix a = Matrix::random(5, 4, -1, 1, 1);
+    Matrix X = Matrix::random(3, 4, -1, 1, 2);
+    Matrix Y(5, 2, StorageOrder::RowMajor);
+    Y = ConstMatrixView(Matrix::random(5, 2, -1, 1, 3));
+    Matrix Y_orig = Y;
+    gemv(1, a, X.row(1), 1, Y.col(1));
+    Vector expected = a * Vector(Matrix(X.row(1)));
+    for (size_t i = 0; i < 5; ++i) {
+        EXPECT_NEAR(Y(i, 1), Y_orig(i, 1) + expected(i), 1e-14);
+        EXPECT_EQ(Y(i, 0), Y_orig(i, 0));
+    }
+}
+
+TEST(Vector, subtractProduct) {
+    Matrix a        = Matrix::random(5, 4, -1, 1, 1);
+    Vector x        = Vector::random(4, -1, 1, 2);
+    Vector y        = Vector::random(5, -1, 1, 3);
+    Vector expected = y - a * x;
+    RESET_ALLOC_COUNT();
+    subtract_product(y, a, x);
+    EXPECT_ALLOC_COUNT(0);
+    EXPECT_LT((y - expected).normFro(), 1e-14);
+}
+
 // RowVector
 // :::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::
 
@@ -187,6 +401,30 @@ TEST(RowVector, matrixVectorMultiply) {
     RowVector result   = a * b;
     EXPECT_EQ(result, expected);
 }
+TEST(RowVector, matrixVectorMultiplyLarge) {
+    RowVector a      = RowVector::random(517, -1, 1, 4);
+    Matrix b         = Matrix::random(517, 389, -1, 1, 3);
+    RowVector result = a * b;
+    ASSERT_EQ(result.size(), 389);
+    for (size_t j = 0; j < result.size(); ++j) {
+        double expected = 0;
+        for (size_t k = 0; k < b.rows(); ++k)
+            expected += a(k) * b(k, j);
+        EXPECT_NEAR(result(j), expected, 1e-12) << "(" << j << ")";
+    }
+}
+TEST(RowVector, gemvTransposed) {
+    // aᵀ·B computed as Bᵀ·a, without evaluating the transpose of B
+    Vector a           = Vector::random(517, -1, 1, 4);
+    Matrix b           = Matrix::random(517, 389, -1, 1, 3);
+    RowVector expected = transpose(a) * b;
+    Vector result(389);
+    RESET_ALLOC_COUNT();
+    gemv(1, transpose(b), a, 0, result);
+    EXPECT_ALLOC_COUNT(0);
+    for (size_t j = 0; j < result.size(); ++j)
+        EXPECT_NEAR(result(j), expected(j), 1e-12) << "(" << j << ")";
+}
 TEST(RowVector, matrixVectorMultiplyMoveA) {
     RESET_ALLOC_COUNT();
     RowVector a        = {11, 13, 17};
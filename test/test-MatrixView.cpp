@@ -0,0 +1,165 @@
+#include <gtest/gtest.h>
+
+#include <linalg/Matrix.hpp>
+
+#include "CountAllocationsTests.hpp"
+
+TEST(MatrixView, block) {
+    Matrix A = {
+        {11, 12, 13, 14},
+        {21, 22, 23, 24},
+        {31, 32, 33, 34},
+    };
+    Matrix expected = {
+        {22, 23},
+        {32, 33},
+    };
+    RESET_ALLOC_COUNT();
+    ConstMatrixView B = A.block(1, 1, 2, 2);
+    EXPECT_ALLOC_COUNT(0);
+    EXPECT_EQ(B.rows(), 2);
+    EXPECT_EQ(B.cols(), 2);
+    EXPECT_EQ(B(1, 0), 32);
+    EXPECT_EQ(Matrix(B), expected);
+}
+
+TEST(MatrixView, rowColDiagonal) {
+    Matrix A = {
+        {11, 12, 13},
+        {21, 22, 23},
+    };
+    EXPECT_EQ(Matrix(A.row(1)), Matrix({{21, 22, 23}}));
+    EXPECT_EQ(Matrix(A.col(2)), Matrix(Vector({13, 23})));
+    EXPECT_EQ(Matrix(A.diagonal()), Matrix(Vector({11, 22})));
+    EXPECT_EQ(A.row(0)(2), 13);
+    EXPECT_EQ(A.col(1)(1), 22);
+    EXPECT_EQ(A.block(0, 1, 2, 2).diagonal()(1), 23);
+}
+
+TEST(MatrixView, write) {
+    Matrix A = Matrix::zeros(3, 3);
+    A.row(0).fill(1);
+    A.col(2)(1)  = 2;
+    A.diagonal() = Vector({3, 4, 5});
+    Matrix expected = {
+        {3, 1, 1},
+        {0, 4, 2},
+        {0, 0, 5},
+    };
+    EXPECT_EQ(A, expected);
+}
+
+TEST(MatrixView, assignColumn) {
+    Matrix A = {
+        {1, 2},
+        {3, 4},
+    };
+    Matrix B = {
+        {5, 6},
+        {7, 8},
+    };
+    Matrix expected = {
+        {6, 2},
+        {8, 4},
+    };
+    RESET_ALLOC_COUNT();
+    A.col(0) = B.col(1);
+    EXPECT_ALLOC_COUNT(0);
+    EXPECT_EQ(A, expected);
+}
+
+TEST(MatrixView, compoundAssignment) {
+    Matrix A = {
+        {1, 2, 3},
+        {4, 5, 6},
+    };
+    Matrix expected = {
+        {1, 2, 3},
+        {10, 14, 18},
+    };
+    RESET_ALLOC_COUNT();
+    A.row(1) += A.row(0);
+    A.row(1) *= 2;
+    A.block(1, 0, 1, 2) -= A.block(0, 0, 1, 2) / 1;
+    EXPECT_ALLOC_COUNT(0);
+    A.block(1, 0, 1, 2) += Matrix({{0, 0}}) + 2 * A.block(0, 0, 1, 2) / 2;
+    EXPECT_EQ(A, expected);
+}
+
+TEST(MatrixView, expression) {
+    Matrix A = {
+        {1, 2, 3},
+        {4, 5, 6},
+        {7, 8, 9},
+    };
+    Matrix expected = {
+        {8, 10},
+        {14, 16},
+    };
+    RESET_ALLOC_COUNT();
+    Matrix result = A.block(0, 1, 2, 2) + 2 * A.block(1, 1, 2, 2) -
+                    A.block(1, 0, 2, 2);
+    EXPECT_ALLOC_COUNT(1); // only the result, no copies of the blocks
+    EXPECT_EQ(result, expected);
+}
+
+TEST(MatrixView, assignAliased) {
+    Matrix A = {
+        {1, 2, 3},
+        {4, 5, 6},
+    };
+    Matrix expected = {
+        {5, 6},
+    };
+    A = A.block(1, 1, 1, 2);
+    EXPECT_EQ(A, expected);
+}
+
+TEST(MatrixView, multiply) {
+    Matrix A = Matrix::random(7, 9, -1, 1, 1);
+    Matrix B = Matrix::random(8, 6, -1, 1, 2);
+    ConstMatrixView Ablk = A.block(1, 2, 5, 4);
+    ConstMatrixView Bblk = B.block(3, 1, 4, 3);
+    Matrix expected = Matrix(Ablk) * Matrix(Bblk);
+    RESET_ALLOC_COUNT();
+    Matrix result = Ablk * Bblk;
+    EXPECT_ALLOC_COUNT(1);
+    ASSERT_EQ(result.rows(), 5);
+    ASSERT_EQ(result.cols(), 3);
+    for (size_t i = 0; i < result.num_elems(); ++i)
+        EXPECT_NEAR(result(i), expected(i), 1e-12) << i;
+}
+
+TEST(MatrixView, multiplyVector) {
+    Matrix A = {
+        {1, 2, 3},
+        {4, 5, 6},
+        {7, 8, 9},
+    };
+    Vector x = {1, -1};
+    Vector expected = {-1, -1};
+    Vector result = A.block(1, 1, 2, 2) * x;
+    EXPECT_EQ(result, expected);
+}
+
+TEST(MatrixView, dot) {
+    Matrix A = {
+        {1, 2, 3},
+        {4, 5, 6},
+        {7, 8, 9},
+    };
+    // Row 0 · column 2 = 1·3 + 2·6 + 3·9
+    EXPECT_EQ(Vector::dot_unchecked(A.row(0), A.col(2)), 42);
+    // Frobenius inner product of two blocks
+    EXPECT_EQ(Vector::dot_unchecked(A.block(0, 0, 2, 2), A.block(1, 1, 2, 2)),
+              1 * 5 + 2 * 6 + 4 * 8 + 5 * 9);
+}
+
+TEST(MatrixView, normFro) {
+    Matrix A = {
+        {1, 2, 3},
+        {4, 3, 4},
+    };
+    EXPECT_DOUBLE_EQ(A.block(0, 1, 2, 2).normFro(), std::sqrt(38.));
+    EXPECT_DOUBLE_EQ(A.diagonal().normFro(), std::sqrt(10.));
+}
@@ -2,6 +2,7 @@
 
 #include <linalg/NoPivotLU.hpp>
 #include <linalg/Matrix.hpp>
+#include <linalg/Runtime.hpp>
 
 #include "CountAllocationsTests.hpp"
 
@@ -158,4 +159,22 @@ TEST(NoPivotLU, LUSteal) {
         for (size_t c = 0; c < A.cols(); ++c)
             EXPECT_LE(std::abs(result(r, c)), 1e-14)
                 << "(" << r << ", " << c << ")";
-}
\ No newline at end of file
+}
+
+TEST(NoPivotLU, blocked) {
+    // Factor a matrix that is larger than the block size, once using the
+    // blocked algorithm and once using the unblocked algorithm.
+    // The matrix is diagonally dominant, so no pivoting is required.
+    SquareMatrix A = SquareMatrix::random(75, -1, +1);
+    A += 75 * SquareMatrix::identity(75);
+    size_t nb = get_lu_block_size();
+    set_lu_block_size(8);
+    NoPivotLU lu_blocked(A);
+    set_lu_block_size(0);
+    NoPivotLU lu_unblocked(A);
+    set_lu_block_size(nb);
+
+    SquareMatrix LU_prod = lu_blocked.get_L() * lu_blocked.get_U();
+    EXPECT_LT((A - LU_prod).normFro(), 1e-11);
+    EXPECT_LT((lu_blocked.get_LU() - lu_unblocked.get_LU()).normFro(), 1e-11);
+}
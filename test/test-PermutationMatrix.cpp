@@ -1,6 +1,7 @@
 #include <gtest/gtest.h>
 
 #include <linalg/PermutationMatrix.hpp>
+#include <linalg/Runtime.hpp>
 
 static PermutationMatrix::Permutation long_permutation = {
     544, 387,  2,    383, 807, 707,  34,   681,  109,  268, 570,  989,  491,
@@ -169,6 +170,40 @@ TEST(PermutationMatrix, permutationRight) {
     EXPECT_EQ(result, expected);
 }
 
+// Wide matrices are permuted in chunks of columns, possibly in parallel, which
+// should give exactly the same result as permuting entire rows.
+TEST(PermutationMatrix, permutationLeftWide) {
+    auto permutation = PermutationMatrix::random_permutation(70, 3);
+    PermutationMatrix P = PermutationMatrix::from_permutation(
+        permutation, PermutationMatrix::RowPermutation);
+    Matrix A = Matrix::random(70, 301, -1, 1, 4);
+    Matrix expected(70, 301);
+    for (size_t r = 0; r < 70; ++r)
+        for (size_t c = 0; c < 301; ++c)
+            expected(r, c) = A(permutation[r], c);
+
+    size_t num_threads = get_num_threads();
+    size_t threshold   = get_parallel_permutation_threshold();
+    // The rows are swapped in place, P * A with a const A would gather them
+    // into a new matrix instead. In row-major order, the rows are contiguous,
+    // but they should still be split over the threads.
+    for (auto order : {StorageOrder::ColMajor, StorageOrder::RowMajor}) {
+        Matrix result_serial(70, 301, order), result_parallel(70, 301, order);
+        result_serial   = ConstMatrixView(A);
+        result_parallel = ConstMatrixView(A);
+        set_num_threads(1);
+        P.permute_rows(result_serial);
+        set_num_threads(4);
+        set_parallel_permutation_threshold(0);
+        P.permute_rows(result_parallel);
+        set_num_threads(num_threads);
+        set_parallel_permutation_threshold(threshold);
+        EXPECT_EQ(result_serial.storage_order(), order);
+        EXPECT_EQ(result_serial, expected);
+        EXPECT_EQ(result_parallel, expected);
+    }
+}
+
 TEST(PermutationMatrix, permutationLeftInverse) {
     Matrix A = {
         {11, 12, 13},
@@ -352,4 +387,72 @@ TEST(PermutationMatrix, permutationRightVectorMove) {
     RowVector expected = {2, 4, 3, 1};
     RowVector result = std::move(A) * P;
     EXPECT_EQ(result, expected);
-}
\ No newline at end of file
+}
+// Combining and inverting permutations
+// :::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::
+
+TEST(PermutationMatrix, permutationConversionLarge) {
+    // Would take minutes with an O(n²) conversion.
+    auto permutation = PermutationMatrix::random_permutation(1000000);
+    PermutationMatrix P = PermutationMatrix::from_permutation(permutation);
+    EXPECT_EQ(P.to_permutation(), permutation);
+}
+
+TEST(PermutationMatrix, inversePermutation) {
+    PermutationMatrix::Permutation p = {1, 3, 2, 0};
+    PermutationMatrix::Permutation expected = {3, 0, 2, 1};
+    EXPECT_EQ(PermutationMatrix::inverse_permutation(p), expected);
+}
+
+TEST(PermutationMatrix, inverse) {
+    PermutationMatrix P = PermutationMatrix::random(
+        20, PermutationMatrix::RowPermutation, 7);
+    PermutationMatrix P_inv = P.inverse();
+    EXPECT_FALSE(P_inv.is_reversed());
+    EXPECT_EQ(P_inv.get_type(), PermutationMatrix::RowPermutation);
+    EXPECT_EQ(P_inv.to_permutation(), transpose(P).to_permutation());
+    Matrix A = Matrix::random(20, 3, -1, 1);
+    EXPECT_EQ(P_inv * (P * A), A);
+}
+
+TEST(PermutationMatrix, composeRows) {
+    PermutationMatrix P = PermutationMatrix::random(
+        20, PermutationMatrix::RowPermutation, 1);
+    PermutationMatrix Q = PermutationMatrix::random(
+        20, PermutationMatrix::RowPermutation, 2);
+    Matrix A = Matrix::random(20, 3, -1, 1);
+    PermutationMatrix PQ = compose(P, Q);
+    EXPECT_EQ(PQ.get_type(), PermutationMatrix::RowPermutation);
+    EXPECT_EQ(PQ * A, P * (Q * A));
+    EXPECT_EQ(PQ.to_matrix(), P.to_matrix() * Q.to_matrix());
+    EXPECT_EQ(compose(transpose(P), PQ).to_permutation(), Q.to_permutation());
+}
+
+TEST(PermutationMatrix, composeColumns) {
+    PermutationMatrix P = PermutationMatrix::random(
+        20, PermutationMatrix::ColumnPermutation, 1);
+    PermutationMatrix Q = PermutationMatrix::random(
+        20, PermutationMatrix::ColumnPermutation, 2);
+    Matrix A = Matrix::random(3, 20, -1, 1);
+    PermutationMatrix PQ = compose(P, Q);
+    EXPECT_EQ(PQ.get_type(), PermutationMatrix::ColumnPermutation);
+    EXPECT_EQ(A * PQ, (A * P) * Q);
+    EXPECT_EQ(PQ.to_matrix(), P.to_matrix() * Q.to_matrix());
+}
+
+TEST(PermutationMatrix, permuteOutOfPlace) {
+    PermutationMatrix P = PermutationMatrix::random(9, {}, 5);
+    Matrix A = Matrix::random(9, 9, -1, 1);
+    // Also the transpose, which applies the swaps in reverse order.
+    for (int i = 0; i < 2; ++i) {
+        Matrix B(9, 9), expected = A;
+        P.permute_rows(A, B);
+        P.permute_rows(expected);
+        EXPECT_EQ(B, expected);
+        P.permute_columns(A, B);
+        expected = A;
+        P.permute_columns(expected);
+        EXPECT_EQ(B, expected);
+        P.reverse();
+    }
+}
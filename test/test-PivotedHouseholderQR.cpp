@@ -0,0 +1,177 @@
+#include <gtest/gtest.h>
+
+#include <linalg/Matrix.hpp>
+#include <linalg/PivotedHouseholderQR.hpp>
+#include <linalg/Runtime.hpp>
+
+#include "CountAllocationsTests.hpp"
+
+#include <algorithm> // std::max
+#include <cmath>     // std::abs
+
+#define EXPECT_CLOSE_ENOUGH(X, R)                                              \
+    EXPECT_NEAR((X), (R), std::max(std::abs(X) * 1e-14, 1e-14))
+
+TEST(PivotedHouseholderQR, QRP) {
+    Matrix A = {
+        {1, 2, 1},
+        {3, 4, 3},
+        {1, 2, 3},
+        {6, 5, 4},
+    };
+    PivotedHouseholderQR qr(A);
+
+    Matrix QR = qr.apply_Q(qr.get_R());
+    Matrix AP = A * qr.get_P();
+
+    for (size_t r = 0; r < A.rows(); ++r)
+        for (size_t c = 0; c < A.cols(); ++c)
+            EXPECT_CLOSE_ENOUGH(AP(r, c), QR(r, c))
+                << "(" << r << ", " << c << ")";
+}
+
+TEST(PivotedHouseholderQR, QTAP) {
+    Matrix A = {
+        {1, 2, 1},
+        {3, 4, 3},
+        {1, 2, 3},
+        {6, 5, 4},
+    };
+    PivotedHouseholderQR qr(A);
+
+    Matrix R    = qr.get_R();
+    Matrix QTAP = qr.apply_QT(A * qr.get_P());
+
+    for (size_t r = 0; r < R.rows(); ++r)
+        for (size_t c = 0; c < R.cols(); ++c)
+            EXPECT_CLOSE_ENOUGH(R(r, c), QTAP(r, c))
+                << "(" << r << ", " << c << ")";
+}
+
+TEST(PivotedHouseholderQR, diagonalNonIncreasing) {
+    Matrix A = Matrix::random(30, 20, -1, +1);
+    // Give the columns very different scales:
+    for (size_t c = 0; c < A.cols(); ++c)
+        for (size_t r = 0; r < A.rows(); ++r)
+            A(r, c) *= std::pow(10., double((c * 7) % 20) / 4);
+    PivotedHouseholderQR qr(A);
+
+    const Vector &R_diag = qr.get_R_diag();
+    for (size_t k = 1; k < R_diag.size(); ++k)
+        EXPECT_LE(std::abs(R_diag(k)), std::abs(R_diag(k - 1))) << k;
+    EXPECT_EQ(qr.get_rank(), 20);
+
+    Matrix QR = qr.apply_Q(qr.get_R());
+    Matrix AP = A * qr.get_P();
+    EXPECT_LT((QR - AP).normFro(), 1e-12 * A.normFro());
+}
+
+TEST(PivotedHouseholderQR, rank) {
+    // The third column is the sum of the first two, the fifth column is twice
+    // the second.
+    Matrix A = {
+        {1, 2, 3, 4, 4},
+        {3, 4, 7, 1, 8},
+        {1, 2, 3, 0, 4},
+        {6, 5, 11, 2, 10},
+        {2, 1, 3, 7, 2},
+        {0, 3, 3, 5, 6},
+    };
+    PivotedHouseholderQR qr(A);
+    EXPECT_EQ(qr.get_rank(), 3);
+    // A looser tolerance can only lower the rank:
+    EXPECT_LE(qr.get_rank(0.5), 3);
+    EXPECT_GE(qr.get_rank(0), 3);
+}
+
+TEST(PivotedHouseholderQR, solveLeastSquares) {
+    Matrix A = {
+        {1, 2, 1},
+        {3, 4, 3},
+        {1, 2, 3},
+        {6, 5, 4},
+    };
+    Vector x = {7, 11, 13};
+    Vector b = A * x;
+    PivotedHouseholderQR qr(A);
+
+    Vector solution = qr.solve(b);
+
+    ASSERT_EQ(x.size(), solution.size());
+    for (size_t c = 0; c < x.cols(); ++c)
+        EXPECT_NEAR(solution(c), x(c), 1e-13) << "(" << c << ")";
+}
+
+TEST(PivotedHouseholderQR, solveSquareInplace) {
+    Matrix A = {
+        {1, 2, 1, 5},
+        {3, 4, 3, 9},
+        {1, 2, 3, 6},
+        {6, 5, 4, 2},
+    };
+    Matrix X = {
+        {7, 1},
+        {11, 2},
+        {13, 3},
+        {17, 4},
+    };
+    Matrix B = A * X;
+    PivotedHouseholderQR qr(A);
+    RESET_ALLOC_COUNT();
+    qr.solve_inplace(B);
+    EXPECT_ALLOC_COUNT(0); // No intermediate solution is allocated because
+                           // A is square
+    for (size_t r = 0; r < X.rows(); ++r)
+        for (size_t c = 0; c < X.cols(); ++c)
+            EXPECT_NEAR(B(r, c), X(r, c), 1e-12)
+                << "(" << r << ", " << c << ")";
+}
+
+TEST(PivotedHouseholderQR, solveRankDeficient) {
+    // Nearly collinear regressors: the third column is the sum of the first
+    // two, plus a tiny perturbation.
+    Matrix A = {
+        {1, 2, 3},
+        {3, 4, 7},
+        {1, 2, 3},
+        {6, 5, 11},
+        {2, 1, 3},
+    };
+    A(4, 2) += 1e-15;
+    Vector b = {1, 2, 3, 4, 5};
+    PivotedHouseholderQR qr(A);
+    ASSERT_EQ(qr.get_rank(), 2);
+
+    // The basic solution has a zero in the position of the dropped column,
+    // and its residual is orthogonal to the columns of A.
+    Vector x = qr.solve(b);
+    size_t zeros = 0;
+    for (size_t i = 0; i < x.size(); ++i)
+        zeros += x(i) == 0;
+    EXPECT_EQ(zeros, 1);
+    Vector residual = b - A * x;
+    Matrix At_res   = transpose(A) * residual;
+    for (size_t i = 0; i < At_res.rows(); ++i)
+        EXPECT_NEAR(At_res(i), 0, 1e-12) << i;
+}
+
+TEST(PivotedHouseholderQR, blockedApplyManyRHS) {
+    // Apply Q and Qᵀ to many right-hand sides at once, using the blocked
+    // algorithm, and compare to the unblocked result.
+    Matrix A = Matrix::random(61, 23, -1, +1);
+    Matrix B = Matrix::random(61, 37, -1, +1);
+    PivotedHouseholderQR qr(A);
+    size_t nb = get_qr_block_size();
+    set_qr_block_size(0);
+    Matrix QTB_unblocked = qr.apply_QT(B);
+    Matrix QB_unblocked  = qr.apply_Q(B);
+    set_qr_block_size(5);
+    Matrix QTB_blocked = qr.apply_QT(B);
+    Matrix QB_blocked  = qr.apply_Q(B);
+    Matrix QQTB        = qr.apply_Q(QTB_blocked);
+    set_qr_block_size(nb);
+
+    EXPECT_LT((QTB_blocked - QTB_unblocked).normFro(), 1e-12);
+    EXPECT_LT((QB_blocked - QB_unblocked).normFro(), 1e-12);
+    EXPECT_LT((QQTB - B).normFro(), 1e-12);
+}
@@ -2,6 +2,7 @@
 
 #include <linalg/Matrix.hpp>
 #include <linalg/RowPivotLU.hpp>
+#include <linalg/Runtime.hpp>
 
 #include "CountAllocationsTests.hpp"
 
@@ -183,4 +184,44 @@ TEST(RowPivotLU, LUSteal) {
         for (size_t c = 0; c < A.cols(); ++c)
             EXPECT_LE(std::abs(result(r, c)), 1e-14)
                 << "(" << r << ", " << c << ")";
-}
\ No newline at end of file
+}
+
+TEST(RowPivotLU, blocked) {
+    // Factor a matrix that is larger than the block size, once using the
+    // blocked algorithm and once using the unblocked algorithm.
+    SquareMatrix A = SquareMatrix::random(75, -1, +1);
+    size_t nb = get_lu_block_size();
+    set_lu_block_size(8);
+    RowPivotLU lu_blocked(A);
+    set_lu_block_size(0);
+    RowPivotLU lu_unblocked(A);
+    set_lu_block_size(nb);
+
+    SquareMatrix LU_prod = lu_blocked.get_L() * lu_blocked.get_U();
+    SquareMatrix PA = lu_blocked.get_P() * A;
+    EXPECT_LT((PA - LU_prod).normFro(), 1e-12);
+
+    for (size_t i = 0; i < A.rows(); ++i)
+        EXPECT_EQ(lu_blocked.get_P()(i), lu_unblocked.get_P()(i)) << i;
+    EXPECT_LT((lu_blocked.get_LU() - lu_unblocked.get_LU()).normFro(), 1e-12);
+}
+
+TEST(RowPivotLU, rowMajor) {
+    // A row-major matrix is factored in its own storage order, with the
+    // blocked algorithm.
+    SquareMatrix A = SquareMatrix::random(75, -1, +1);
+    SquareMatrix A_row(75, StorageOrder::RowMajor);
+    static_cast<Matrix &>(A_row) = ConstMatrixView(A);
+    size_t nb = get_lu_block_size();
+    set_lu_block_size(8);
+    RowPivotLU lu(A);
+    RowPivotLU lu_row(A_row);
+    set_lu_block_size(nb);
+
+    EXPECT_EQ(lu_row.get_LU().storage_order(), StorageOrder::RowMajor);
+    EXPECT_LT((lu_row.get_LU() - lu.get_LU()).normFro(), 1e-12);
+    Matrix B = Matrix::random(75, 3, -1, +1);
+    Matrix B_row(75, 3, StorageOrder::RowMajor);
+    B_row = ConstMatrixView(B);
+    EXPECT_LT((lu_row.solve(B_row) - lu.solve(B)).normFro(), 1e-10);
+}
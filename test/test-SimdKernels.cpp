@@ -0,0 +1,114 @@
+#include <gtest/gtest.h>
+
+#include <linalg/Matrix.hpp>
+#include <linalg/Runtime.hpp>
+
+#include <string>
+
+// Runs each test once for every SIMD kernel set that is supported by the CPU.
+class SimdKernels : public ::testing::TestWithParam<const char *> {
+  protected:
+    void SetUp() override {
+        original = get_simd_kernel_set();
+        if (!set_simd_kernel_set(GetParam()))
+            GTEST_SKIP() << GetParam() << " is not supported";
+        EXPECT_EQ(std::string(get_simd_kernel_set()), GetParam());
+    }
+    void TearDown() override { set_simd_kernel_set(original.c_str()); }
+
+    // Odd sizes, so the remainders of the vectorized loops are tested as well.
+    Matrix A = Matrix::random(37, 11, -1, 1, 1);
+    Matrix B = Matrix::random(37, 11, -1, 1, 2);
+
+  private:
+    std::string original;
+};
+
+TEST_P(SimdKernels, add) {
+    Matrix C = A + B;
+    for (size_t i = 0; i < C.num_elems(); ++i)
+        EXPECT_EQ(C(i), A(i) + B(i)) << i;
+}
+
+TEST_P(SimdKernels, subtract) {
+    Matrix C = A - B;
+    for (size_t i = 0; i < C.num_elems(); ++i)
+        EXPECT_EQ(C(i), A(i) - B(i)) << i;
+}
+
+TEST_P(SimdKernels, negate) {
+    Matrix C = -A;
+    for (size_t i = 0; i < C.num_elems(); ++i)
+        EXPECT_EQ(C(i), -A(i)) << i;
+}
+
+TEST_P(SimdKernels, multiplyScalar) {
+    Matrix C = A * 3.1;
+    for (size_t i = 0; i < C.num_elems(); ++i)
+        EXPECT_EQ(C(i), A(i) * 3.1) << i;
+}
+
+TEST_P(SimdKernels, divideScalar) {
+    Matrix C = A / 3.1;
+    for (size_t i = 0; i < C.num_elems(); ++i)
+        EXPECT_EQ(C(i), A(i) / 3.1) << i;
+}
+
+TEST_P(SimdKernels, transpose) {
+    Matrix C = transpose(A);
+    for (size_t r = 0; r < A.rows(); ++r)
+        for (size_t c = 0; c < A.cols(); ++c)
+            EXPECT_EQ(C(c, r), A(r, c)) << r << ", " << c;
+}
+
+TEST_P(SimdKernels, dot) {
+    double expected = 0;
+    for (size_t i = 0; i < A.num_elems(); ++i)
+        expected += A(i) * B(i);
+    EXPECT_NEAR(Vector::dot_unchecked(A, B), expected, 1e-13);
+}
+
+TEST_P(SimdKernels, matrixMultiply) {
+    Matrix a      = Matrix::random(67, 71, -1, 1, 3);
+    Matrix b      = Matrix::random(71, 45, -1, 1, 4);
+    Matrix result = a * b;
+    for (size_t i = 0; i < result.rows(); ++i)
+        for (size_t j = 0; j < result.cols(); ++j) {
+            double expected = 0;
+            for (size_t k = 0; k < a.cols(); ++k)
+                expected += a(i, k) * b(k, j);
+            EXPECT_NEAR(result(i, j), expected, 1e-13)
+                << "(" << i << ", " << j << ")";
+        }
+}
+
+TEST_P(SimdKernels, matrixVectorMultiply) {
+    // Ax uses the AXPY kernel, Aᵀy the dot product kernel.
+    Matrix a   = Matrix::random(67, 71, -1, 1, 3);
+    Vector x   = Vector::random(71, -1, 1, 4);
+    Vector y   = Vector::random(67, -1, 1, 5);
+    Vector ax  = a * x;
+    Vector aty = transpose(a) * y;
+    for (size_t i = 0; i < a.rows(); ++i) {
+        double expected = 0;
+        for (size_t k = 0; k < a.cols(); ++k)
+            expected += a(i, k) * x(k);
+        EXPECT_NEAR(ax(i), expected, 1e-13) << "(" << i << ")";
+    }
+    for (size_t j = 0; j < a.cols(); ++j) {
+        double expected = 0;
+        for (size_t k = 0; k < a.rows(); ++k)
+            expected += a(k, j) * y(k);
+        EXPECT_NEAR(aty(j), expected, 1e-13) << "(" << j << ")";
+    }
+}
+
+INSTANTIATE_TEST_SUITE_P(KernelSets, SimdKernels,
+                         ::testing::Values("generic", "sse2", "avx2",
+                                           "avx512"));
+
+TEST(SimdKernelSet, unknown) {
+    std::string original = get_simd_kernel_set();
+    EXPECT_FALSE(set_simd_kernel_set("does-not-exist"));
+    EXPECT_EQ(get_simd_kernel_set(), original);
+}
@@ -0,0 +1,78 @@
+#include <gtest/gtest.h>
+
+#include <linalg/HouseholderQR.hpp>
+#include <linalg/Matrix.hpp>
+#include <linalg/TallSkinnyQR.hpp>
+
+#include <cmath> // std::abs
+
+TEST(TallSkinnyQR, QR) {
+    Matrix A = Matrix::random(103, 5, -1, +1);
+    TallSkinnyQR qr;
+    qr.set_block_rows(10); // 10 blocks, the last one has 13 rows
+    qr.compute(A);
+
+    // QᵀA = [R; 0]
+    Matrix QTA = qr.apply_QT(A);
+    const Matrix &R = qr.get_R();
+    for (size_t r = 0; r < A.rows(); ++r)
+        for (size_t c = 0; c < A.cols(); ++c)
+            EXPECT_NEAR(QTA(r, c), r < R.rows() ? R(r, c) : 0, 1e-13)
+                << "(" << r << ", " << c << ")";
+
+    // Q[R; 0] = A
+    Matrix R_full = Matrix::zeros(A.rows(), A.cols());
+    R_full.block(0, 0, R.rows(), R.cols()) = R;
+    Matrix QR = qr.apply_Q(std::move(R_full));
+    EXPECT_LT((QR - A).normFro(), 1e-13);
+}
+
+TEST(TallSkinnyQR, sameRAsHouseholderQR) {
+    Matrix A = Matrix::random(200, 7, -1, +1);
+    TallSkinnyQR tsqr;
+    tsqr.set_block_rows(16);
+    tsqr.compute(A);
+    HouseholderQR qr(A);
+
+    // R is unique up to the signs of its rows.
+    const Matrix &R_ts = tsqr.get_R();
+    Matrix R_hh        = qr.get_R();
+    for (size_t r = 0; r < A.cols(); ++r)
+        for (size_t c = r; c < A.cols(); ++c)
+            EXPECT_NEAR(std::abs(R_ts(r, c)), std::abs(R_hh(r, c)), 1e-12)
+                << "(" << r << ", " << c << ")";
+}
+
+TEST(TallSkinnyQR, solveLeastSquares) {
+    Matrix A = Matrix::random(1000, 4, -1, +1);
+    Vector x = {7, 11, 13, -5};
+    Vector b = A * x;
+    b(3) += 1e-3; // not exactly consistent
+    TallSkinnyQR qr;
+    qr.set_block_rows(50);
+    qr.compute(A);
+    HouseholderQR reference(A);
+
+    Vector solution = qr.solve(b);
+    Vector expected = reference.solve(b);
+
+    ASSERT_EQ(solution.size(), expected.size());
+    for (size_t i = 0; i < x.size(); ++i)
+        EXPECT_NEAR(solution(i), expected(i), 1e-12) << i;
+}
+
+TEST(TallSkinnyQR, singleBlock) {
+    Matrix A = {
+        {1, 2, 1},
+        {3, 4, 3},
+        {1, 2, 3},
+        {6, 5, 4},
+    };
+    Vector x = {7, 11, 13};
+    Vector b = A * x;
+    TallSkinnyQR qr(A);
+
+    Vector solution = qr.solve(b);
+    for (size_t i = 0; i < x.size(); ++i)
+        EXPECT_NEAR(solution(i), x(i), 1e-12) << i;
+}
@@ -1,6 +1,7 @@
 #include <gtest/gtest.h>
 
 #include <linalg/Matrix.hpp>
+#include <linalg/Runtime.hpp>
 
 #include "CountAllocationsTests.hpp"
 
@@ -19,7 +20,7 @@ TEST(Matrix, transposeRectangularMoveA) {
     Matrix expected = {{11, 21}, {12, 22}, {13, 23}};
     EXPECT_ALLOC_COUNT(2);
     Matrix result = transpose(std::move(a));
-    EXPECT_ALLOC_COUNT(3); // rectangular transposition requires intermediate
+    EXPECT_ALLOC_COUNT(2); // in-place transposition reuses storage of a
     EXPECT_ALLOC_ALIVE(2); // expected, result
     EXPECT_EQ(result, expected);
 }
@@ -75,6 +76,83 @@ TEST(Matrix, transposeRowVectorMoveA) {
     EXPECT_EQ(result, expected);
 }
 
+// Sizes that are not multiples of the tile and block sizes, so the edges of
+// the tiled kernels are tested as well.
+TEST(Matrix, transposeLarge) {
+    for (StorageOrder order : {StorageOrder::ColMajor, StorageOrder::RowMajor}) {
+        Matrix a(261, 173, order);
+        a = ConstMatrixView(Matrix::random(261, 173, -1, 1));
+        Matrix result = transpose(a);
+        ASSERT_EQ(result.rows(), 173);
+        ASSERT_EQ(result.cols(), 261);
+        for (size_t r = 0; r < a.rows(); ++r)
+            for (size_t c = 0; c < a.cols(); ++c)
+                EXPECT_EQ(result(c, r), a(r, c));
+    }
+}
+
+TEST(Matrix, transposeRectangularMoveLarge) {
+    for (StorageOrder order : {StorageOrder::ColMajor, StorageOrder::RowMajor}) {
+        Matrix a(261, 173, order);
+        a = ConstMatrixView(Matrix::random(261, 173, -1, 1));
+        Matrix expected    = explicit_transpose(a);
+        const double *data = a.data();
+        Matrix result      = transpose(std::move(a));
+        EXPECT_EQ(result.data(), data);
+        EXPECT_EQ(result.storage_order(), order);
+        EXPECT_EQ(result, expected);
+    }
+}
+
+TEST(Matrix, transposeParallel) {
+    size_t num_threads = get_num_threads();
+    size_t threshold   = get_parallel_transpose_threshold();
+    Matrix a           = Matrix::random(601, 533, -1, 1);
+    SquareMatrix b     = SquareMatrix::random(601, -1, 1);
+    set_num_threads(1);
+    Matrix a_expected       = transpose(a);
+    SquareMatrix b_expected = transpose(b);
+    set_num_threads(4);
+    set_parallel_transpose_threshold(0);
+    Matrix a_result = transpose(a);
+    b.transpose_inplace();
+    set_num_threads(num_threads);
+    set_parallel_transpose_threshold(threshold);
+    EXPECT_EQ(a_result, a_expected);
+    EXPECT_EQ(b, b_expected);
+}
+
+TEST(Matrix, transposeLazyProduct) {
+    Matrix A  = Matrix::random(7, 4, -1, 1);
+    Matrix B  = Matrix::random(7, 3, -1, 1);
+    Vector b  = Vector::random(7, -1, 1);
+    Matrix At = explicit_transpose(A);
+    static_assert(std::is_same<decltype(transpose(A) * b), Vector>::value, "");
+    RESET_ALLOC_COUNT();
+    Matrix AtA   = transpose(A) * A;
+    Matrix AtB   = transpose(A) * B;
+    Vector Atb   = transpose(A) * b;
+    Matrix BAt   = transpose(B) * transpose(At);
+    RowVector bA = transpose(b) * A;
+    EXPECT_ALLOC_COUNT(6); // the five results and the copy of b for bᵀ
+    EXPECT_LT((AtA - At * A).normFro(), 1e-14);
+    EXPECT_LT((AtB - At * B).normFro(), 1e-14);
+    EXPECT_LT((Atb - At * b).normFro(), 1e-14);
+    EXPECT_LT((BAt - transpose(B) * A).normFro(), 1e-14);
+    EXPECT_LT((bA - transpose(b) * A).normFro(), 1e-14);
+}
+
+TEST(Matrix, transposeLazyRowMajor) {
+    Matrix A(5, 3, StorageOrder::RowMajor);
+    A                 = ConstMatrixView(Matrix::random(5, 3, -1, 1));
+    Matrix At         = transpose(A);
+    Matrix expected   = explicit_transpose(A);
+    Matrix AAt        = A * transpose(A);
+    Matrix AAt_expect = A * expected;
+    EXPECT_EQ(At, expected);
+    EXPECT_LT((AAt - AAt_expect).normFro(), 1e-14);
+}
+
 // SquareMatrix
 // :::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::
 
@@ -95,6 +173,28 @@ TEST(SquareMatrix, transposeMoveA) {
     EXPECT_EQ(result, expected);
 }
 
+TEST(SquareMatrix, transposeLazyProduct) {
+    SquareMatrix A = SquareMatrix::random(5, -1, 1);
+    SquareMatrix At(explicit_transpose(A));
+    static_assert(
+        std::is_same<decltype(transpose(A) * A), SquareMatrix>::value, "");
+    SquareMatrix AtA = transpose(A) * A;
+    EXPECT_LT((AtA - At * A).normFro(), 1e-14);
+}
+
+TEST(SquareMatrix, transposeInplaceLarge) {
+    for (StorageOrder order : {StorageOrder::ColMajor, StorageOrder::RowMajor}) {
+        SquareMatrix a(150, order);
+        static_cast<Matrix &>(a) = ConstMatrixView(Matrix::random(150, 150));
+        SquareMatrix result = a;
+        result.transpose_inplace();
+        EXPECT_EQ(result.storage_order(), order);
+        for (size_t r = 0; r < a.rows(); ++r)
+            for (size_t c = 0; c < a.cols(); ++c)
+                EXPECT_EQ(result(c, r), a(r, c));
+    }
+}
+
 // Vector
 // :::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::
 
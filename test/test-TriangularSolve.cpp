@@ -0,0 +1,112 @@
+#include <gtest/gtest.h>
+
+#include <linalg/Matrix.hpp>
+#include <linalg/TriangularSolve.hpp>
+
+namespace {
+
+/// Random well-conditioned triangular matrix (also with a unit diagonal),
+/// with garbage in the other triangle (which should never be accessed).
+SquareMatrix random_triangular(size_t n, Triangle triangle) {
+    SquareMatrix A = SquareMatrix::random(n, -1, +1);
+    for (size_t c = 0; c < n; ++c) {
+        for (size_t r = 0; r < n; ++r)
+            if (triangle == Triangle::Lower ? r < c : r > c)
+                A(r, c) = 1e300;
+            else
+                A(r, c) /= n;
+        A(c, c) += c % 2 ? 2 : -2;
+    }
+    return A;
+}
+
+/// The triangular matrix that A represents, with zeros in the other triangle.
+SquareMatrix triangular_part(const SquareMatrix &A, Triangle triangle,
+                             Diagonal diagonal) {
+    SquareMatrix T = A;
+    for (size_t c = 0; c < A.cols(); ++c) {
+        for (size_t r = 0; r < A.rows(); ++r)
+            if (triangle == Triangle::Lower ? r < c : r > c)
+                T(r, c) = 0;
+        if (diagonal == Diagonal::Unit)
+            T(c, c) = 1;
+    }
+    return T;
+}
+
+} // namespace
+
+class TriangularSolve
+    : public ::testing::TestWithParam<std::tuple<Side, Triangle, Diagonal>> {};
+
+TEST_P(TriangularSolve, solve) {
+    Side side;
+    Triangle triangle;
+    Diagonal diagonal;
+    std::tie(side, triangle, diagonal) = GetParam();
+
+    // Larger than the block size of the kernel, so the off-diagonal blocks are
+    // tested as well.
+    const size_t n = 150, nrhs = 7;
+    SquareMatrix A = random_triangular(n, triangle);
+    SquareMatrix T = triangular_part(A, triangle, diagonal);
+    Matrix X = side == Side::Left ? Matrix::random(n, nrhs, -1, +1)
+                                  : Matrix::random(nrhs, n, -1, +1);
+    Matrix B = side == Side::Left ? Matrix(T * X) : Matrix(X * T);
+
+    triangular_solve(side, triangle, diagonal, A, B);
+    EXPECT_LT((B - X).normFro(), 1e-10 * X.normFro());
+}
+
+INSTANTIATE_TEST_SUITE_P(
+    TriangularSolve, TriangularSolve,
+    ::testing::Combine(::testing::Values(Side::Left, Side::Right),
+                       ::testing::Values(Triangle::Lower, Triangle::Upper),
+                       ::testing::Values(Diagonal::NonUnit, Diagonal::Unit)));
+
+TEST(TriangularSolve, transposedView) {
+    // Solve LᵀX = B by passing L with swapped strides.
+    SquareMatrix L = random_triangular(9, Triangle::Lower);
+    SquareMatrix Lt(transpose(triangular_part(L, Triangle::Lower,
+                                              Diagonal::NonUnit)));
+    Matrix X = Matrix::random(9, 3, -1, +1);
+    Matrix B = Lt * X;
+
+    ConstMatrixView L_view(L);
+    ConstMatrixView Lt_view(L.data(), 9, 9, L_view.col_stride(),
+                            L_view.row_stride());
+    triangular_solve(Side::Left, Triangle::Upper, Diagonal::NonUnit, Lt_view,
+                     B);
+    EXPECT_LT((B - X).normFro(), 1e-12);
+}
+
+TEST(TriangularSolve, lazyTranspose) {
+    // Solve LᵀX = B by passing the lazy transpose of L.
+    SquareMatrix L = random_triangular(9, Triangle::Lower);
+    SquareMatrix Lt(explicit_transpose(
+        triangular_part(L, Triangle::Lower, Diagonal::NonUnit)));
+    Matrix X = Matrix::random(9, 3, -1, +1);
+    Matrix B = Lt * X;
+
+    triangular_solve(Side::Left, Triangle::Upper, Diagonal::NonUnit,
+                     transpose(L), B);
+    EXPECT_LT((B - X).normFro(), 1e-12);
+}
+
+TEST(TriangularSolve, block) {
+    // Only the given block of B is overwritten.
+    SquareMatrix U = random_triangular(4, Triangle::Upper);
+    Matrix B = Matrix::random(6, 5, -1, +1);
+    Matrix B_orig = B;
+    triangular_solve(Side::Left, Triangle::Upper, Diagonal::NonUnit, U,
+                     B.block(1, 2, 4, 3));
+
+    Matrix X(B.block(1, 2, 4, 3));
+    SquareMatrix T = triangular_part(U, Triangle::Upper, Diagonal::NonUnit);
+    EXPECT_LT((T * X - Matrix(B_orig.block(1, 2, 4, 3))).normFro(), 1e-12);
+    for (size_t c = 0; c < B.cols(); ++c)
+        for (size_t r = 0; r < B.rows(); ++r)
+            if (r < 1 || r >= 5 || c < 2) {
+                EXPECT_EQ(B(r, c), B_orig(r, c));
+            }
+}
@@ -0,0 +1,113 @@
+#include <gtest/gtest.h>
+
+#include <linalg/HouseholderQR.hpp>
+#include <linalg/Matrix.hpp>
+#include <linalg/UpdatableQR.hpp>
+
+#include <cmath> // std::abs
+
+namespace {
+
+/// Check that the factorization is valid for the given matrix: Q has
+/// orthonormal columns, R is upper-triangular, and QR = A.
+void expect_factorization_of(const UpdatableQR &qr, const Matrix &A) {
+    const Matrix &Q = qr.get_Q(), &R = qr.get_R();
+    ASSERT_EQ(Q.rows(), A.rows());
+    ASSERT_EQ(Q.cols(), A.cols());
+    ASSERT_EQ(R.rows(), A.cols());
+    ASSERT_EQ(R.cols(), A.cols());
+    EXPECT_LT((Q * R - A).normFro(), 1e-12 * A.normFro());
+    Matrix QTQ = transpose(Q) * Q;
+    EXPECT_LT((QTQ - Matrix::identity(A.cols())).normFro(), 1e-12);
+    for (size_t c = 0; c < R.cols(); ++c)
+        for (size_t r = c + 1; r < R.rows(); ++r)
+            EXPECT_EQ(R(r, c), 0) << "(" << r << ", " << c << ")";
+}
+
+} // namespace
+
+TEST(UpdatableQR, compute) {
+    Matrix A = Matrix::random(13, 5, -1, +1);
+    UpdatableQR qr(A);
+    expect_factorization_of(qr, A);
+}
+
+TEST(UpdatableQR, insertRow) {
+    Matrix A = Matrix::random(13, 5, -1, +1);
+    UpdatableQR qr(A);
+    RowVector a = {1, 2, 3, 4, 5};
+    qr.insert_row(4, a);
+
+    Matrix A_new(14, 5);
+    A_new.block(0, 0, 4, 5) = A.block(0, 0, 4, 5);
+    A_new.block(4, 0, 1, 5) = a;
+    A_new.block(5, 0, 9, 5) = A.block(4, 0, 9, 5);
+    expect_factorization_of(qr, A_new);
+}
+
+TEST(UpdatableQR, deleteRow) {
+    Matrix A = Matrix::random(13, 5, -1, +1);
+    UpdatableQR qr(A);
+    qr.delete_row(7);
+
+    Matrix A_new(12, 5);
+    A_new.block(0, 0, 7, 5) = A.block(0, 0, 7, 5);
+    A_new.block(7, 0, 5, 5) = A.block(8, 0, 5, 5);
+    expect_factorization_of(qr, A_new);
+}
+
+TEST(UpdatableQR, insertColumn) {
+    Matrix A = Matrix::random(13, 5, -1, +1);
+    UpdatableQR qr(A);
+    Vector a = Vector::random(13, -1, +1, 7);
+    qr.insert_column(2, a);
+
+    Matrix A_new(13, 6);
+    A_new.block(0, 0, 13, 2) = A.block(0, 0, 13, 2);
+    A_new.block(0, 2, 13, 1) = a;
+    A_new.block(0, 3, 13, 3) = A.block(0, 2, 13, 3);
+    expect_factorization_of(qr, A_new);
+}
+
+TEST(UpdatableQR, deleteColumn) {
+    Matrix A = Matrix::random(13, 5, -1, +1);
+    UpdatableQR qr(A);
+    qr.delete_column(1);
+
+    Matrix A_new(13, 4);
+    A_new.block(0, 0, 13, 1) = A.block(0, 0, 13, 1);
+    A_new.block(0, 1, 13, 3) = A.block(0, 2, 13, 3);
+    expect_factorization_of(qr, A_new);
+}
+
+TEST(UpdatableQR, rankOneUpdate) {
+    Matrix A = Matrix::random(13, 5, -1, +1);
+    UpdatableQR qr(A);
+    Vector u = Vector::random(13, -1, +1, 7);
+    Vector v = Vector::random(5, -1, +1);
+    qr.rank_one_update(u, v);
+
+    Matrix A_new = A + u * transpose(v);
+    expect_factorization_of(qr, A_new);
+}
+
+TEST(UpdatableQR, slidingWindow) {
+    // Keep a window of the 20 most recent observations, and check that the
+    // least-squares solution matches a new factorization at every step.
+    Matrix data = Matrix::random(50, 3, -1, +1);
+    Vector y    = Vector::random(50, -1, +1, 7);
+    const size_t window = 20;
+    UpdatableQR qr(Matrix(data.block(0, 0, window, 3)));
+    for (size_t t = window; t < data.rows(); ++t) {
+        qr.delete_row(0);
+        qr.insert_row(window - 1, RowVector(Matrix(data.block(t, 0, 1, 3))));
+
+        Matrix A(data.block(t + 1 - window, 0, window, 3));
+        Vector b(Matrix(y.block(t + 1 - window, 0, window, 1)));
+        Vector expected = HouseholderQR(A).solve(b);
+        Vector solution = qr.solve(b);
+        ASSERT_EQ(solution.size(), expected.size());
+        for (size_t i = 0; i < expected.size(); ++i)
+            EXPECT_NEAR(solution(i), expected(i), 1e-12) << t << ", " << i;
+    }
+}